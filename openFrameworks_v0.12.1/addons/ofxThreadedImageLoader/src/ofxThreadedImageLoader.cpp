@@ -1,47 +1,219 @@
 #include "ofxThreadedImageLoader.h"
 #include "ofLog.h"
 #include <sstream>
+#include <chrono>
 
-ofxThreadedImageLoader::ofxThreadedImageLoader(){
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::Request::cancel(){
+	if(state){
+		state->cancelled = true;
+	}
+}
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::Request::setPriority(int priority){
+	if(state){
+		state->priority = priority;
+	}
+}
+
+//--------------------------------------------------------------
+int ofxThreadedImageLoader::Request::getPriority() const{
+	return state ? state->priority.load() : 0;
+}
+
+//--------------------------------------------------------------
+bool ofxThreadedImageLoader::Request::isCancelled() const{
+	return state && state->cancelled;
+}
+
+//--------------------------------------------------------------
+std::shared_future<bool> ofxThreadedImageLoader::Request::getFuture() const{
+	return state ? state->future : std::shared_future<bool>();
+}
+
+//--------------------------------------------------------------
+ofxThreadedImageLoader::ofxThreadedImageLoader(size_t numThreads){
 	nextID = 0;
+	closed = false;
+	numPending = 0;
+	maxBytesPerFrame = 0;
+	maxMillisPerFrame = 2;
     ofAddListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofAddListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
-    
+
+    // the ofThread is the first worker, so stopThread() and friends keep working
     startThread();
+    for(size_t i = 1; i < numThreads; i++){
+		workers.emplace_back(&ofxThreadedImageLoader::decodeImages, this);
+    }
     lastUpdate = 0;
 }
 
 ofxThreadedImageLoader::~ofxThreadedImageLoader(){
-	images_to_load_from_disk.close();
-	images_to_update.close();
+	{
+		std::unique_lock<std::mutex> lock(toLoadMutex);
+		closed = true;
+	}
+	toLoadCondition.notify_all();
 	waitForThread(true);
+	for(auto & worker: workers){
+		worker.join();
+	}
     ofRemoveListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofRemoveListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
+
+	// nothing will finish these anymore
+	for(auto & entry: images_to_load){
+		finish(entry, false);
+	}
+	for(auto & entry: images_to_update){
+		finish(entry, false);
+	}
+	for(auto & loading: images_async_loading){
+		finish(loading.second, false);
+	}
 }
 
 // Load an image from disk.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromDisk(ofImage& image, std::string filename) {
-	nextID++;
+ofxThreadedImageLoader::Request ofxThreadedImageLoader::loadFromDisk(ofImage& image, std::string filename, int priority, Callback onDone) {
 	ofImageLoaderEntry entry(image);
 	entry.filename = filename;
-	entry.image->setUseTexture(false);
 	entry.name = filename;
-    
-	images_to_load_from_disk.send(entry);
+	Request request = enqueue(entry, priority, std::move(onDone));
+
+	sendToDecode(std::move(entry));
+	return request;
 }
 
 
 // Load an url asynchronously from an url.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromURL(ofImage& image, std::string url) {
-	nextID++;
+ofxThreadedImageLoader::Request ofxThreadedImageLoader::loadFromURL(ofImage& image, std::string url, int priority, Callback onDone) {
 	ofImageLoaderEntry entry(image);
 	entry.url = url;
-	entry.image->setUseTexture(false);	
+	Request request = enqueue(entry, priority, std::move(onDone));
 	entry.name = "image" + ofToString(nextID);
-	images_async_loading[entry.name] = entry;
+
 	ofLoadURLAsync(entry.url, entry.name);
+	images_async_loading[entry.name] = std::move(entry);
+	return request;
+}
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setUploadBudget(size_t maxBytesPerFrame, float maxMillisPerFrame){
+	this->maxBytesPerFrame = maxBytesPerFrame;
+	this->maxMillisPerFrame = maxMillisPerFrame;
+}
+
+//--------------------------------------------------------------
+size_t ofxThreadedImageLoader::getNumPending() const{
+	return numPending;
+}
+
+//--------------------------------------------------------------
+ofxThreadedImageLoader::Request ofxThreadedImageLoader::enqueue(ofImageLoaderEntry & entry, int priority, Callback && onDone){
+	nextID++;
+	Request request;
+	request.state = std::make_shared<Request::State>();
+	request.state->priority = priority;
+	request.state->future = request.state->result.get_future().share();
+	entry.state = request.state;
+	entry.onDone = std::move(onDone);
+	entry.order = nextID;
+	numPending++;
+	return request;
+}
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::sendToDecode(ofImageLoaderEntry && entry){
+	{
+		std::unique_lock<std::mutex> lock(toLoadMutex);
+		images_to_load.push_back(std::move(entry));
+	}
+	toLoadCondition.notify_one();
+}
+
+// Waits for the highest priority image that still has to be decoded.
+//--------------------------------------------------------------
+bool ofxThreadedImageLoader::receiveToDecode(ofImageLoaderEntry & entry){
+	std::unique_lock<std::mutex> lock(toLoadMutex);
+	std::vector<ofImageLoaderEntry> cancelled;
+	while(true){
+		if(closed){
+			return false;
+		}
+		size_t next = findNext(images_to_load, cancelled);
+		// cancelled requests are finished in update(), on the main thread
+		sendToUpdate(cancelled);
+		if(next < images_to_load.size()){
+			entry = std::move(images_to_load[next]);
+			removeEntry(images_to_load, next);
+			return true;
+		}
+		toLoadCondition.wait(lock);
+	}
+}
+
+// Order doesn't matter in the queues, so the last entry fills the gap.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::removeEntry(std::vector<ofImageLoaderEntry> & entries, size_t index){
+	if(index + 1 < entries.size()){
+		entries[index] = std::move(entries.back());
+	}
+	entries.pop_back();
+}
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::sendToUpdate(std::vector<ofImageLoaderEntry> & entries){
+	if(entries.empty()){
+		return;
+	}
+	std::unique_lock<std::mutex> lock(toUpdateMutex);
+	for(auto & entry: entries){
+		images_to_update.push_back(std::move(entry));
+	}
+	entries.clear();
+}
+
+// Moves cancelled entries to cancelled and returns the index of the one to
+// process next: highest priority first, then in the order they were
+// requested.
+//--------------------------------------------------------------
+size_t ofxThreadedImageLoader::findNext(std::vector<ofImageLoaderEntry> & entries, std::vector<ofImageLoaderEntry> & cancelled){
+	for(size_t i = 0; i < entries.size();){
+		if(entries[i].state->cancelled){
+			cancelled.push_back(std::move(entries[i]));
+			removeEntry(entries, i);
+		}else{
+			i++;
+		}
+	}
+	size_t next = entries.size();
+	int nextPriority = 0;
+	for(size_t i = 0; i < entries.size(); i++){
+		int priority = entries[i].state->priority;
+		if(next == entries.size() || priority > nextPriority || (priority == nextPriority && entries[i].order < entries[next].order)){
+			next = i;
+			nextPriority = priority;
+		}
+	}
+	return next;
+}
+
+// Completes the request. The callback only runs for requests that weren't
+// cancelled, since the image it refers to may be gone.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::finish(ofImageLoaderEntry & entry, bool loaded){
+	if(!entry.state || entry.state->done.exchange(true)){
+		return;
+	}
+	entry.state->result.set_value(loaded);
+	numPending--;
+	if(entry.onDone && !entry.state->cancelled){
+		entry.onDone(loaded);
+	}
 }
 
 
@@ -49,52 +221,101 @@ void ofxThreadedImageLoader::loadFromURL(ofImage& image, std::string url) {
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::threadedFunction() {
 	setThreadName("ofxThreadedImageLoader " + ofToString(thread.get_id()));
+	decodeImages();
+	ofLogVerbose("ofxThreadedImageLoader") << "finishing thread on closed queue";
+}
+
+// Decodes into the entry's own pixels, the image is only touched in update().
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::decodeImages() {
 	ofImageLoaderEntry entry;
-	while( images_to_load_from_disk.receive(entry) ) {
-		if(entry.image->load(entry.filename) )  {
-			images_to_update.send(entry);
+	while( receiveToDecode(entry) ) {
+		if(entry.url.empty()){
+			entry.loaded = ofLoadImage(entry.pixels, entry.filename);
+			if(!entry.loaded){
+				ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
+			}
 		}else{
-			ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
+			entry.loaded = ofLoadImage(entry.pixels, entry.data);
+			entry.data.clear();
+			if(!entry.loaded){
+				ofLogError("ofxThreadedImageLoader") << "couldn't load url: \"" << entry.url << "\"";
+			}
 		}
+		std::unique_lock<std::mutex> lock(toUpdateMutex);
+		images_to_update.push_back(std::move(entry));
 	}
-	ofLogVerbose("ofxThreadedImageLoader") << "finishing thread on closed queue";
 }
 
 
-// When we receive an url response this method is called; 
-// The loaded image is removed from the async_queue and added to the
-// update queue. The update queue is used to update the texture.
+// When we receive an url response this method is called;
+// The downloaded image is removed from the async_queue and added to the
+// decode queue.
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 	// this happens in the update thread so no need to lock to access
 	// images_async_loading
 	entry_iterator it = images_async_loading.find(response.request.name);
+	if(it == images_async_loading.end()) {
+		return;
+	}
 	if(response.status == 200) {
-		if(it != images_async_loading.end()) {
-			it->second.image->load(response.data);
-			images_to_update.send(it->second);
-		}
+		it->second.data = response.data;
+		sendToDecode(std::move(it->second));
 	}else{
 		// log error.
 		ofLogError("ofxThreadedImageLoader") << "couldn't load url, response status: " << response.status;
 		ofRemoveURLRequest(response.request.getId());
+		finish(it->second, false);
 	}
 
 	// remove the entry from the queue
-	if(it != images_async_loading.end()) {
-		images_async_loading.erase(it);
-	}
+	images_async_loading.erase(it);
 }
 
 
-// Check the update queue and update the texture
+// Uploads decoded images to their textures, as many as the budget allows
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::update(ofEventArgs & a){
-    // Load 1 image per update so we don't block the gl thread for too long
+	auto start = std::chrono::steady_clock::now();
+	size_t uploadedBytes = 0;
+	bool uploaded = false;
 	ofImageLoaderEntry entry;
-	if (images_to_update.tryReceive(entry)) {
-		entry.image->setUseTexture(true);
-		entry.image->update();
+	std::vector<ofImageLoaderEntry> cancelled;
+	while(true){
+		if(uploaded && maxMillisPerFrame > 0){
+			std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			if(elapsed.count() >= maxMillisPerFrame){
+				break;
+			}
+		}
+		{
+			std::unique_lock<std::mutex> lock(toUpdateMutex);
+			size_t next = findNext(images_to_update, cancelled);
+			if(next == images_to_update.size()){
+				break;
+			}
+			size_t bytes = images_to_update[next].pixels.getTotalBytes();
+			if(uploaded && maxBytesPerFrame > 0 && uploadedBytes + bytes > maxBytesPerFrame){
+				break;
+			}
+			entry = std::move(images_to_update[next]);
+			removeEntry(images_to_update, next);
+		}
+
+		if(entry.loaded){
+			uploadedBytes += entry.pixels.getTotalBytes();
+			uploaded = true;
+			entry.image->getPixels().swap(entry.pixels);
+			entry.image->setUseTexture(true);
+			entry.image->update();
+		}
+		finish(entry, entry.loaded);
+		entry = ofImageLoaderEntry();
 	}
-}
 
+	// cancelled requests, including the ones the workers skipped
+	for(auto & entry: cancelled){
+		finish(entry, false);
+	}
+}
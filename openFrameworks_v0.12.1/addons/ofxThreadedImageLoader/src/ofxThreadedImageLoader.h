@@ -6,29 +6,111 @@
 #include "ofURLFileLoader.h"
 #include "ofTypes.h"
 #include "ofThreadChannel.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
 
+/// \brief Loads images on background threads and uploads their textures
+/// a few at a time.
+///
+/// Images are decoded by a pool of worker threads. Higher priority requests
+/// are decoded first, and requests can be cancelled until their texture is
+/// uploaded. Textures are uploaded in update(), on the main thread, only as
+/// many per frame as the upload budget allows, so a lot of images finishing
+/// at once doesn't make the app stutter.
+///
+/// ~~~~{.cpp}
+/// ofxThreadedImageLoader loader(4);
+/// auto request = loader.loadFromDisk(thumbnails[i], path, priority, [i](bool loaded){
+///     ofLogNotice() << "thumbnail " << i << (loaded ? " loaded" : " failed");
+/// });
+/// // scrolled out of view
+/// request.cancel();
+/// ~~~~
+///
+/// The ofImage passed in must stay alive until the request is done or
+/// cancelled. Workers never touch it: it is only written on the main thread
+/// when its texture is uploaded.
 class ofxThreadedImageLoader : public ofThread {
 public:
-    ofxThreadedImageLoader();
-    ~ofxThreadedImageLoader();
+	/// \brief Called on the main thread once a request is done, with true
+	/// if the image was loaded and its texture uploaded.
+	typedef std::function<void(bool)> Callback;
 
-	void loadFromDisk(ofImage& image, std::string file);
-	void loadFromURL(ofImage& image, std::string url);
+	/// \brief A handle to a queued image, to change its priority or cancel it.
+	///
+	/// Copies refer to the same request. A default constructed Request
+	/// doesn't refer to any and ignores every call.
+	class Request {
+	public:
+		/// \brief Stop loading the image if it isn't uploaded yet.
+		///
+		/// When called on the main thread, the image is guaranteed not to be
+		/// changed by the loader after this returns.
+		void cancel();
 
+		/// \brief Change the priority of a request that is still waiting to
+		/// be decoded or uploaded. Higher values go first.
+		void setPriority(int priority);
+		int getPriority() const;
 
+		bool isCancelled() const;
+
+		/// \brief Becomes true when the image is loaded and its texture is
+		/// uploaded, false if loading failed or the request was cancelled.
+		///
+		/// The value is set during update(), so don't wait on it from the
+		/// main thread.
+		std::shared_future<bool> getFuture() const;
+
+	private:
+		friend class ofxThreadedImageLoader;
+		struct State {
+			std::atomic<int> priority{0};
+			std::atomic<bool> cancelled{false};
+			std::atomic<bool> done{false};
+			std::promise<bool> result;
+			std::shared_future<bool> future;
+		};
+		std::shared_ptr<State> state;
+	};
+
+	/// \param numThreads The number of threads decoding images.
+	explicit ofxThreadedImageLoader(size_t numThreads = 1);
+	~ofxThreadedImageLoader();
+
+	Request loadFromDisk(ofImage& image, std::string file, int priority = 0, Callback onDone = nullptr);
+	Request loadFromURL(ofImage& image, std::string url, int priority = 0, Callback onDone = nullptr);
+
+	/// \brief Limit how much texture data is uploaded each frame.
+	///
+	/// At least one image is uploaded every frame that has any ready, so
+	/// images bigger than the budget still get through.
+	///
+	/// \param maxBytesPerFrame Total size of the images uploaded in one
+	/// frame, 0 for no limit.
+	/// \param maxMillisPerFrame Time spent uploading in one frame, 0 for no
+	/// limit. Defaults to 2ms.
+	void setUploadBudget(size_t maxBytesPerFrame, float maxMillisPerFrame);
+
+	/// \brief The number of requests not done yet, including the ones
+	/// waiting for a URL.
+	size_t getNumPending() const;
 
 private:
 	void update(ofEventArgs & a);
     virtual void threadedFunction();
+	void decodeImages();
 	void urlResponse(ofHttpResponse & response);
-    
+
     // Entry to load.
     struct ofImageLoaderEntry {
     public:
         ofImageLoaderEntry() {
             image = NULL;
         }
-        
+
         ofImageLoaderEntry(ofImage & pImage) {
             image = &pImage;
         }
@@ -36,8 +118,22 @@ private:
         std::string filename;
         std::string url;
         std::string name;
+
+        ofBuffer data;
+        ofPixels pixels;
+        bool loaded = false;
+        uint64_t order = 0;
+        Callback onDone;
+        std::shared_ptr<Request::State> state;
     };
 
+	Request enqueue(ofImageLoaderEntry & entry, int priority, Callback && onDone);
+	void sendToDecode(ofImageLoaderEntry && entry);
+	bool receiveToDecode(ofImageLoaderEntry & entry);
+	size_t findNext(std::vector<ofImageLoaderEntry> & entries, std::vector<ofImageLoaderEntry> & cancelled);
+	void sendToUpdate(std::vector<ofImageLoaderEntry> & entries);
+	static void removeEntry(std::vector<ofImageLoaderEntry> & entries, size_t index);
+	void finish(ofImageLoaderEntry & entry, bool loaded);
 
     typedef std::map<std::string, ofImageLoaderEntry>::iterator entry_iterator;
 
@@ -45,8 +141,19 @@ private:
     int                 lastUpdate;
 
 	std::map<std::string,ofImageLoaderEntry> images_async_loading; // keeps track of images which are loading async
-	ofThreadChannel<ofImageLoaderEntry> images_to_load_from_disk;
-	ofThreadChannel<ofImageLoaderEntry> images_to_update;
-};
 
+	// waiting for a worker, picked by priority
+	std::vector<ofImageLoaderEntry> images_to_load;
+	bool closed;
+	mutable std::mutex toLoadMutex;
+	std::condition_variable toLoadCondition;
+
+	// decoded, waiting for the texture upload in update()
+	std::vector<ofImageLoaderEntry> images_to_update;
+	mutable std::mutex toUpdateMutex;
 
+	std::vector<std::thread> workers;
+	std::atomic<size_t> numPending;
+	size_t maxBytesPerFrame;
+	float maxMillisPerFrame;
+};
@@ -0,0 +1,116 @@
+#include "FramePreprocessor.h"
+
+//--------------------------------------------------------------
+bool FramePreprocessor::Settings::operator==(const Settings& other) const {
+	return scale == other.scale &&
+		threshBlockSize == other.threshBlockSize &&
+		threshC == other.threshC &&
+		claheClipLimit == other.claheClipLimit &&
+		bilateralDiameter == other.bilateralDiameter &&
+		bilateralSigmaColor == other.bilateralSigmaColor &&
+		bilateralSigmaSpace == other.bilateralSigmaSpace;
+}
+
+//--------------------------------------------------------------
+FramePreprocessor::FramePreprocessor() {
+	clahe = cv::createCLAHE(settings.claheClipLimit, cv::Size(8, 8));
+	kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(2, 2));
+}
+
+//--------------------------------------------------------------
+void FramePreprocessor::setSettings(const Settings& newSettings) {
+	if (newSettings == settings) {
+		return;
+	}
+	if (newSettings.claheClipLimit != settings.claheClipLimit) {
+		clahe->setClipLimit(newSettings.claheClipLimit);
+	}
+	settings = newSettings;
+	// Block size has to be odd for adaptive thresholding
+	settings.threshBlockSize |= 1;
+}
+
+//--------------------------------------------------------------
+const FramePreprocessor::Settings& FramePreprocessor::getSettings() const {
+	return settings;
+}
+
+//--------------------------------------------------------------
+cv::Mat FramePreprocessor::scratch(cv::Mat& buffer, cv::Size size) {
+	// Only grows the buffer, smaller requests are served as a view
+	if (buffer.cols < size.width || buffer.rows < size.height) {
+		buffer.create(std::max(buffer.rows, size.height), std::max(buffer.cols, size.width), CV_8UC1);
+	}
+	return buffer(cv::Rect(0, 0, size.width, size.height));
+}
+
+//--------------------------------------------------------------
+void FramePreprocessor::process(const cv::Mat& frame, const vector<cv::Rect>& regions,
+								ofPixels& dst, vector<cv::Rect>& scaledRegions) {
+	// Grayscale frames are used as they are, never written to
+	cv::Mat gray = frame;
+	if (frame.channels() == 4) {
+		cv::cvtColor(frame, grayMat, cv::COLOR_RGBA2GRAY);
+		gray = grayMat;
+	} else if (frame.channels() == 3) {
+		cv::cvtColor(frame, grayMat, cv::COLOR_RGB2GRAY);
+		gray = grayMat;
+	}
+	
+	float scale = settings.scale;
+	cv::Size scaledSize(cvRound(gray.cols * scale), cvRound(gray.rows * scale));
+	
+	// No-op when dst already has this size
+	dst.allocate(scaledSize.width, scaledSize.height, OF_PIXELS_GRAY);
+	cv::Mat dstMat = ofxCv::toCv(dst);
+	
+	scaledRegions.clear();
+	if (regions.empty()) {
+		enhance(gray, dstMat);
+		return;
+	}
+	
+	// Only the text boxes are upscaled and enhanced, the rest of the
+	// page stays blank and is never looked at by Tesseract
+	dstMat.setTo(cv::Scalar(255));
+	cv::Rect frameRect(0, 0, gray.cols, gray.rows);
+	cv::Rect scaledFrame(0, 0, scaledSize.width, scaledSize.height);
+	for (const auto& region : regions) {
+		cv::Rect source = region & frameRect;
+		cv::Rect scaledRegion(cvRound(source.x * scale), cvRound(source.y * scale),
+							  cvRound(source.width * scale), cvRound(source.height * scale));
+		scaledRegion &= scaledFrame;
+		if (source.empty() || scaledRegion.empty()) continue;
+		
+		cv::Mat dstRegion = dstMat(scaledRegion);
+		enhance(gray(source), dstRegion);
+		scaledRegions.push_back(scaledRegion);
+	}
+}
+
+//--------------------------------------------------------------
+void FramePreprocessor::enhance(const cv::Mat& gray, cv::Mat& dst) {
+	cv::Size size = dst.size();
+	cv::Mat resized = scratch(resizedMat, size);
+	cv::Mat filtered = scratch(filteredMat, size);
+	cv::Mat enhanced = scratch(enhancedMat, size);
+	
+	// Resize for better OCR
+	cv::resize(gray, resized, size, 0, 0, cv::INTER_CUBIC);
+	
+	// Apply bilateral filter
+	cv::bilateralFilter(resized, filtered, settings.bilateralDiameter,
+						settings.bilateralSigmaColor, settings.bilateralSigmaSpace);
+	
+	// Apply CLAHE
+	clahe->apply(filtered, enhanced);
+	
+	// Apply adaptive thresholding
+	cv::adaptiveThreshold(enhanced, dst, 255,
+						 cv::ADAPTIVE_THRESH_GAUSSIAN_C, cv::THRESH_BINARY,
+						 settings.threshBlockSize, settings.threshC);
+	
+	// Morphological operations
+	cv::morphologyEx(dst, dst, cv::MORPH_CLOSE, kernel);
+	cv::morphologyEx(dst, dst, cv::MORPH_OPEN, kernel);
+}
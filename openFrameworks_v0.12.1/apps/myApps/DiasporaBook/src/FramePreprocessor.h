@@ -0,0 +1,50 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxCv.h"
+
+// Turns camera frames into binarized images for Tesseract.
+// All intermediate buffers, the CLAHE instance and the morphology kernel are
+// owned here and reused, and are only rebuilt when the settings or the frame
+// size change, so steady state processing does not allocate.
+class FramePreprocessor {
+public:
+	struct Settings {
+		float scale = 2.0;
+		int threshBlockSize = 21;
+		float threshC = 10;
+		float claheClipLimit = 2.0;
+		int bilateralDiameter = 9;
+		float bilateralSigmaColor = 75;
+		float bilateralSigmaSpace = 75;
+		
+		bool operator==(const Settings& other) const;
+		bool operator!=(const Settings& other) const { return !(*this == other); }
+	};
+	
+	FramePreprocessor();
+	
+	void setSettings(const Settings& settings);
+	const Settings& getSettings() const;
+	
+	// Preprocesses an RGB or grayscale frame into dst (allocated as needed).
+	// With regions (frame coordinates) only those crops are enhanced and
+	// the rest of dst is left blank; scaledRegions receives the crops in
+	// dst coordinates. Without regions the whole frame is enhanced.
+	void process(const cv::Mat& frame, const vector<cv::Rect>& regions,
+				 ofPixels& dst, vector<cv::Rect>& scaledRegions);
+	
+private:
+	void enhance(const cv::Mat& gray, cv::Mat& dst);
+	cv::Mat scratch(cv::Mat& buffer, cv::Size size);
+	
+	Settings settings;
+	cv::Ptr<cv::CLAHE> clahe;
+	cv::Mat kernel;
+	
+	// Sized for the full scaled frame, crops use views into them
+	cv::Mat grayMat;
+	cv::Mat resizedMat;
+	cv::Mat filteredMat;
+	cv::Mat enhancedMat;
+};
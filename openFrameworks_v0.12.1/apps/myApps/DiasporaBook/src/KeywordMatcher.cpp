@@ -0,0 +1,415 @@
+#include "KeywordMatcher.h"
+
+//--------------------------------------------------------------
+KeywordMatcher::KeywordMatcher()
+	: minScore(0.5)
+	, minConfidence(0) {
+	compile();
+}
+
+//--------------------------------------------------------------
+void KeywordMatcher::setKeywords(const vector<string>& newKeywords) {
+	keywords = newKeywords;
+	compile();
+}
+
+//--------------------------------------------------------------
+const vector<string>& KeywordMatcher::getKeywords() const {
+	return keywords;
+}
+
+//--------------------------------------------------------------
+void KeywordMatcher::setMinScore(float score) {
+	minScore = score;
+}
+
+//--------------------------------------------------------------
+void KeywordMatcher::setMinConfidence(float confidence) {
+	minConfidence = confidence;
+}
+
+//--------------------------------------------------------------
+string KeywordMatcher::fold(const string& text) {
+	string folded;
+	folded.reserve(text.size());
+
+	size_t i = 0;
+	while (i < text.size()) {
+		char c = tolower((unsigned char)text[i]);
+		char next = i + 1 < text.size() ? tolower((unsigned char)text[i + 1]) : 0;
+
+		// Hyphenated line break: drop the hyphen and join the word halves
+		if (c == '-') {
+			size_t j = i + 1;
+			bool lineBreak = false;
+			while (j < text.size() && isspace((unsigned char)text[j])) {
+				lineBreak |= text[j] == '\n';
+				j++;
+			}
+			if (lineBreak && !folded.empty() && folded.back() != ' ') {
+				i = j;
+				continue;
+			}
+		}
+
+		char out = ' ';
+		size_t consumed = 1;
+		if (c == 'r' && next == 'n') {
+			out = 'm';
+			consumed = 2;
+		} else if (c == 'v' && next == 'v') {
+			out = 'w';
+			consumed = 2;
+		} else if (c >= 'a' && c <= 'z') {
+			out = c;
+		} else if (c == '1' || c == '|' || c == '!') {
+			out = 'l';
+		} else if (c == '0') {
+			out = 'o';
+		} else if (c == '5') {
+			out = 's';
+		} else if (c == '\'') {
+			// Apostrophes don't split words
+			i++;
+			continue;
+		}
+
+		if (out != ' ' || (!folded.empty() && folded.back() != ' ')) {
+			folded += out;
+		}
+		i += consumed;
+	}
+
+	if (!folded.empty() && folded.back() == ' ') {
+		folded.pop_back();
+	}
+	return folded;
+}
+
+//--------------------------------------------------------------
+int KeywordMatcher::symbol(char c) {
+	return c == ' ' ? ALPHABET - 1 : c - 'a';
+}
+
+//--------------------------------------------------------------
+size_t KeywordMatcher::deletions(const string& s, int distance, vector<string>& out) {
+	// Every deletion of up to `distance` characters. Strings already in out
+	// are overwritten rather than reallocated; returns how many are valid.
+	size_t count = 0;
+	auto emit = [&](size_t source, size_t skip) -> string& {
+		if (count == out.size()) {
+			out.emplace_back();
+		}
+		string& variant = out[count++];
+		if (source == string::npos) {
+			variant.assign(s);
+		} else {
+			const string& base = out[source];
+			variant.assign(base, 0, skip);
+			variant.append(base, skip + 1, string::npos);
+		}
+		return variant;
+	};
+
+	emit(string::npos, 0);
+	size_t begin = 0;
+	for (int d = 0; d < distance; d++) {
+		size_t end = count;
+		for (size_t i = begin; i < end; i++) {
+			size_t length = out[i].size();
+			for (size_t j = 0; j < length; j++) {
+				emit(i, j);
+			}
+		}
+		begin = end;
+	}
+	return count;
+}
+
+//--------------------------------------------------------------
+int KeywordMatcher::boundedDistance(const string& a, const string& b, int bound) {
+	int la = a.size();
+	int lb = b.size();
+	if (std::abs(la - lb) > bound) {
+		return bound + 1;
+	}
+
+	// Two-row Levenshtein, bailing out once a whole row exceeds the bound
+	const int maxLength = 64;
+	if (lb >= maxLength) {
+		return a == b ? 0 : bound + 1;
+	}
+	int previous[maxLength];
+	int current[maxLength];
+	for (int j = 0; j <= lb; j++) {
+		previous[j] = j;
+	}
+	for (int i = 1; i <= la; i++) {
+		current[0] = i;
+		int rowMin = current[0];
+		for (int j = 1; j <= lb; j++) {
+			int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+			current[j] = std::min({ previous[j] + 1, current[j - 1] + 1, previous[j - 1] + cost });
+			rowMin = std::min(rowMin, current[j]);
+		}
+		if (rowMin > bound) {
+			return bound + 1;
+		}
+		std::copy(current, current + lb + 1, previous);
+	}
+	return std::min(previous[lb], bound + 1);
+}
+
+//--------------------------------------------------------------
+void KeywordMatcher::compile() {
+	compiled.clear();
+	automaton.clear();
+	deletionIndex.clear();
+	phraseLengths.clear();
+	fuzzySlack.clear();
+
+	Node root;
+	root.next.fill(-1);
+	automaton.push_back(root);
+
+	for (size_t k = 0; k < keywords.size(); k++) {
+		Keyword keyword;
+		keyword.text = keywords[k];
+		keyword.folded = fold(keywords[k]);
+		keyword.wordCount = std::count(keyword.folded.begin(), keyword.folded.end(), ' ') + 1;
+		// Short words get no slack, otherwise "main" would match "rain"
+		int length = keyword.folded.size();
+		keyword.maxDistance = length < 5 ? 0 : (length < 9 ? 1 : 2);
+		compiled.push_back(keyword);
+
+		if (keyword.folded.empty()) continue;
+
+		// Trie insert
+		int state = 0;
+		for (char c : keyword.folded) {
+			int s = symbol(c);
+			if (automaton[state].next[s] < 0) {
+				Node node;
+				node.next.fill(-1);
+				automaton[state].next[s] = automaton.size();
+				automaton.push_back(node);
+			}
+			state = automaton[state].next[s];
+		}
+		automaton[state].outputs.push_back(k);
+
+		if (keyword.maxDistance > 0) {
+			size_t count = deletions(keyword.folded, keyword.maxDistance, candidates);
+			for (size_t c = 0; c < count; c++) {
+				auto& ids = deletionIndex[candidates[c]];
+				if (ids.empty() || ids.back() != k) {
+					ids.push_back(k);
+				}
+			}
+			size_t longest = length + keyword.maxDistance;
+			if (fuzzySlack.size() <= longest) {
+				fuzzySlack.resize(longest + 1, 0);
+			}
+			for (size_t l = length - keyword.maxDistance; l <= longest; l++) {
+				fuzzySlack[l] = std::max(fuzzySlack[l], keyword.maxDistance);
+			}
+			if (std::find(phraseLengths.begin(), phraseLengths.end(), keyword.wordCount) == phraseLengths.end()) {
+				phraseLengths.push_back(keyword.wordCount);
+			}
+		}
+	}
+
+	// Breadth-first pass turning the trie into a complete transition table
+	// with failure links folded in, so matching is one lookup per character
+	vector<int> queue;
+	for (int s = 0; s < ALPHABET; s++) {
+		int child = automaton[0].next[s];
+		if (child < 0) {
+			automaton[0].next[s] = 0;
+		} else {
+			automaton[child].fail = 0;
+			queue.push_back(child);
+		}
+	}
+	for (size_t head = 0; head < queue.size(); head++) {
+		int state = queue[head];
+		const vector<size_t>& inherited = automaton[automaton[state].fail].outputs;
+		automaton[state].outputs.insert(automaton[state].outputs.end(), inherited.begin(), inherited.end());
+		for (int s = 0; s < ALPHABET; s++) {
+			int child = automaton[state].next[s];
+			int fallback = automaton[automaton[state].fail].next[s];
+			if (child < 0) {
+				automaton[state].next[s] = fallback;
+			} else {
+				automaton[child].fail = fallback;
+				queue.push_back(child);
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void KeywordMatcher::addTokens(const string& folded, float confidence, size_t source) {
+	size_t start = 0;
+	while (start < folded.size()) {
+		size_t end = folded.find(' ', start);
+		if (end == string::npos) end = folded.size();
+		if (end > start) {
+			tokens.push_back({ folded.substr(start, end - start), confidence, source });
+		}
+		start = end + 1;
+	}
+}
+
+//--------------------------------------------------------------
+const vector<KeywordHit>& KeywordMatcher::match(const string& text) {
+	tokens.clear();
+	string folded = fold(text);
+	size_t start = 0;
+	size_t index = 0;
+	while (start < folded.size()) {
+		size_t end = folded.find(' ', start);
+		if (end == string::npos) end = folded.size();
+		tokens.push_back({ folded.substr(start, end - start), 100, index++ });
+		start = end + 1;
+	}
+	return matchTokens();
+}
+
+//--------------------------------------------------------------
+const vector<KeywordHit>& KeywordMatcher::match(const vector<Word>& words) {
+	tokens.clear();
+	for (size_t i = 0; i < words.size(); i++) {
+		if (words[i].confidence < minConfidence) continue;
+
+		// A word broken at the end of a line carries a trailing hyphen
+		const string& text = words[i].text;
+		if (!text.empty() && text.back() == '-' && i + 1 < words.size() &&
+			words[i + 1].confidence >= minConfidence) {
+			float confidence = (words[i].confidence + words[i + 1].confidence) * 0.5;
+			addTokens(fold(text.substr(0, text.size() - 1) + words[i + 1].text), confidence, i);
+			i++;
+			continue;
+		}
+		addTokens(fold(text), words[i].confidence, i);
+	}
+	return matchTokens();
+}
+
+//--------------------------------------------------------------
+const vector<KeywordHit>& KeywordMatcher::match(const OCRWords& words) {
+	tokens.clear();
+	const auto& entries = words.words;
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (entries[i].confidence < minConfidence) continue;
+
+		// A word broken at the end of a line carries a trailing hyphen
+		string text = words.getText(i);
+		if (!text.empty() && text.back() == '-' && i + 1 < entries.size() &&
+			entries[i + 1].line != entries[i].line && entries[i + 1].confidence >= minConfidence) {
+			float confidence = (entries[i].confidence + entries[i + 1].confidence) * 0.5;
+			text.pop_back();
+			addTokens(fold(text + words.getText(i + 1)), confidence, i);
+			i++;
+			continue;
+		}
+		addTokens(fold(text), entries[i].confidence, i);
+	}
+	return matchTokens();
+}
+
+//--------------------------------------------------------------
+void KeywordMatcher::addHit(size_t keywordIndex, size_t firstToken, size_t tokenCount, int distance) {
+	const Keyword& keyword = compiled[keywordIndex];
+
+	float confidence = 0;
+	for (size_t t = firstToken; t < firstToken + tokenCount; t++) {
+		confidence += tokens[t].confidence;
+	}
+	confidence /= tokenCount;
+
+	KeywordHit hit;
+	hit.keywordIndex = keywordIndex;
+	hit.keyword = keyword.text;
+	hit.wordIndex = tokens[firstToken].source;
+	hit.wordCount = tokens[firstToken + tokenCount - 1].source - hit.wordIndex + 1;
+	hit.distance = distance;
+	hit.similarity = 1.0f - float(distance) / std::max<size_t>(1, keyword.folded.size());
+	hit.confidence = confidence;
+	hit.score = hit.similarity * confidence / 100.0f;
+
+	if (hit.score < minScore) {
+		return;
+	}
+	for (const auto& existing : hits) {
+		if (existing.keywordIndex == hit.keywordIndex && existing.wordIndex == hit.wordIndex) {
+			return;
+		}
+	}
+	hits.push_back(hit);
+}
+
+//--------------------------------------------------------------
+const vector<KeywordHit>& KeywordMatcher::matchTokens() {
+	hits.clear();
+	if (compiled.empty() || tokens.empty()) {
+		return hits;
+	}
+
+	// Exact pass: stream all tokens through the automaton once
+	stream.clear();
+	streamWord.clear();
+	for (size_t t = 0; t < tokens.size(); t++) {
+		if (t > 0) {
+			stream += ' ';
+			streamWord.push_back(t);
+		}
+		stream += tokens[t].text;
+		streamWord.insert(streamWord.end(), tokens[t].text.size(), t);
+	}
+
+	int state = 0;
+	for (size_t i = 0; i < stream.size(); i++) {
+		state = automaton[state].next[symbol(stream[i])];
+		for (size_t k : automaton[state].outputs) {
+			size_t first = streamWord[i + 1 - compiled[k].folded.size()];
+			size_t last = streamWord[i];
+			addHit(k, first, last - first + 1, 0);
+		}
+	}
+
+	// Fuzzy pass: look up deletion variants of each word (or run of words,
+	// for phrases) and verify the few candidates that share one
+	if (!fuzzySlack.empty()) {
+		string window;
+		for (size_t wordCount : phraseLengths) {
+			for (size_t t = 0; t + wordCount <= tokens.size(); t++) {
+				window = tokens[t].text;
+				for (size_t w = 1; w < wordCount; w++) {
+					window += ' ';
+					window += tokens[t + w].text;
+				}
+				if (window.size() >= fuzzySlack.size() || fuzzySlack[window.size()] == 0) continue;
+
+				size_t count = deletions(window, fuzzySlack[window.size()], candidates);
+				for (size_t c = 0; c < count; c++) {
+					auto found = deletionIndex.find(candidates[c]);
+					if (found == deletionIndex.end()) continue;
+					for (size_t k : found->second) {
+						const Keyword& keyword = compiled[k];
+						if (keyword.wordCount != wordCount) continue;
+						int distance = boundedDistance(window, keyword.folded, keyword.maxDistance);
+						if (distance > 0 && distance <= keyword.maxDistance) {
+							addHit(k, t, wordCount, distance);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	std::sort(hits.begin(), hits.end(), [](const KeywordHit& a, const KeywordHit& b) {
+		return a.score > b.score;
+	});
+	return hits;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ofMain.h"
+#include "OCRWords.h"
+
+#include <array>
+#include <unordered_map>
+
+struct KeywordHit {
+	size_t keywordIndex = 0;
+	string keyword;
+	size_t wordIndex = 0; // first OCR word of the hit
+	size_t wordCount = 0;
+	int distance = 0; // edits between the folded keyword and the OCR text
+	float similarity = 0; // 1 for an exact match
+	float confidence = 0; // mean OCR confidence of the words, 0-100
+	float score = 0; // similarity weighted by confidence
+};
+
+// Matches a compiled list of keywords and phrases against OCR output in
+// a single pass, tolerating typical OCR mistakes.
+//
+// Text and keywords are first folded the same way: lowercased, common
+// glyph confusions collapsed ("rn" -> "m", "1" -> "l", "0" -> "o", ...),
+// punctuation turned into word breaks and hyphenated line breaks joined.
+// An Aho-Corasick automaton then finds exact (substring) matches, and a
+// deletion index finds words within a small edit distance of a keyword,
+// so the cost does not grow with keywords x text.
+class KeywordMatcher {
+public:
+	struct Word {
+		string text;
+		float confidence = 100;
+	};
+
+	KeywordMatcher();
+
+	void setKeywords(const vector<string>& keywords);
+	const vector<string>& getKeywords() const;
+
+	// Hits scoring below this are not reported
+	void setMinScore(float minScore);
+	// Words below this OCR confidence are ignored altogether
+	void setMinConfidence(float minConfidence);
+
+	// Returns all hits, best first. The returned reference is valid until
+	// the next call.
+	const vector<KeywordHit>& match(const string& text);
+	const vector<KeywordHit>& match(const vector<Word>& words);
+	// Hit word indices refer to words.words, for their boxes
+	const vector<KeywordHit>& match(const OCRWords& words);
+
+	static string fold(const string& text);
+
+private:
+	enum { ALPHABET = 27 }; // 'a'-'z' and the word break
+
+	struct Node {
+		std::array<int, ALPHABET> next;
+		int fail = 0;
+		vector<size_t> outputs;
+	};
+
+	struct Keyword {
+		string text;
+		string folded;
+		size_t wordCount;
+		int maxDistance;
+	};
+
+	// A folded word, remembering which input word it came from
+	struct Token {
+		string text;
+		float confidence;
+		size_t source;
+	};
+
+	void compile();
+	void addTokens(const string& folded, float confidence, size_t source);
+	const vector<KeywordHit>& matchTokens();
+	void addHit(size_t keywordIndex, size_t firstToken, size_t tokenCount, int distance);
+	static int symbol(char c);
+	static int boundedDistance(const string& a, const string& b, int maxDistance);
+	static size_t deletions(const string& s, int maxDistance, vector<string>& out);
+
+	vector<string> keywords;
+	vector<Keyword> compiled;
+	vector<Node> automaton;
+	std::unordered_map<string, vector<size_t>> deletionIndex;
+	vector<size_t> phraseLengths;
+	// Indexed by folded window length: how many edits are worth looking for
+	vector<int> fuzzySlack;
+	float minScore;
+	float minConfidence;
+
+	// Reused between calls
+	vector<Token> tokens;
+	string stream;
+	vector<size_t> streamWord;
+	vector<string> candidates;
+	vector<KeywordHit> hits;
+};
@@ -0,0 +1,149 @@
+#include "LatencyStats.h"
+
+//--------------------------------------------------------------
+void LatencyHistogram::Window::clear() {
+	for (auto& count : counts) {
+		count.store(0, std::memory_order_relaxed);
+	}
+	max.store(0, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+LatencyHistogram::LatencyHistogram()
+	: current(0) {
+	windows[0].clear();
+	windows[1].clear();
+}
+
+//--------------------------------------------------------------
+size_t LatencyHistogram::bucketFor(uint64_t micros) {
+	if (micros < SUB_BUCKETS) {
+		return micros;
+	}
+	
+	// Octave, then the top three bits below the leading one
+	int octave = 0;
+	for (uint64_t v = micros; v > 1; v >>= 1) {
+		octave++;
+	}
+	size_t bucket = (octave - 2) * SUB_BUCKETS + ((micros >> (octave - 3)) & (SUB_BUCKETS - 1));
+	return std::min<size_t>(bucket, BUCKETS - 1);
+}
+
+//--------------------------------------------------------------
+uint64_t LatencyHistogram::bucketUpperBound(size_t bucket) {
+	size_t next = bucket + 1;
+	if (next < SUB_BUCKETS) {
+		return next;
+	}
+	int octave = next / SUB_BUCKETS + 2;
+	return uint64_t(SUB_BUCKETS + next % SUB_BUCKETS) << (octave - 3);
+}
+
+//--------------------------------------------------------------
+void LatencyHistogram::record(uint64_t micros) {
+	Window& window = windows[current.load(std::memory_order_relaxed)];
+	window.counts[bucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+	
+	uint64_t max = window.max.load(std::memory_order_relaxed);
+	while (micros > max && !window.max.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+	}
+}
+
+//--------------------------------------------------------------
+double LatencyHistogram::getPercentile(double p) const {
+	std::array<uint64_t, BUCKETS> counts;
+	uint64_t total = 0;
+	for (size_t i = 0; i < BUCKETS; i++) {
+		counts[i] = windows[0].counts[i].load(std::memory_order_relaxed) + windows[1].counts[i].load(std::memory_order_relaxed);
+		total += counts[i];
+	}
+	if (total == 0) {
+		return 0;
+	}
+	
+	uint64_t rank = std::max<uint64_t>(1, uint64_t(std::ceil(ofClamp(p, 0, 1) * total)));
+	uint64_t seen = 0;
+	for (size_t i = 0; i < BUCKETS; i++) {
+		seen += counts[i];
+		if (seen >= rank) {
+			// Never report past the slowest sample actually seen
+			return std::min<double>(bucketUpperBound(i), getMax() * 1000.0) / 1000.0;
+		}
+	}
+	return getMax();
+}
+
+//--------------------------------------------------------------
+double LatencyHistogram::getMax() const {
+	return std::max(windows[0].max.load(std::memory_order_relaxed), windows[1].max.load(std::memory_order_relaxed)) / 1000.0;
+}
+
+//--------------------------------------------------------------
+uint64_t LatencyHistogram::getCount() const {
+	uint64_t total = 0;
+	for (const auto& window : windows) {
+		for (const auto& count : window.counts) {
+			total += count.load(std::memory_order_relaxed);
+		}
+	}
+	return total;
+}
+
+//--------------------------------------------------------------
+void LatencyHistogram::rotate() {
+	// Samples landing in the old window while it is cleared are lost,
+	// which is fine for statistics
+	int next = 1 - current.load(std::memory_order_relaxed);
+	windows[next].clear();
+	current.store(next, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+void LatencyStats::record(Stage stage, uint64_t micros) {
+	histograms[stage].record(micros);
+}
+
+//--------------------------------------------------------------
+const LatencyHistogram& LatencyStats::get(Stage stage) const {
+	return histograms[stage];
+}
+
+//--------------------------------------------------------------
+void LatencyStats::dump(const string& path) {
+	bool writeHeader = !ofFile::doesFileExist(path) || ofFile(path).getSize() == 0;
+	ofFile file(path, ofFile::Append);
+	if (!file.is_open()) {
+		ofLogWarning("LatencyStats") << "Could not write " << path;
+		return;
+	}
+	
+	if (writeHeader) {
+		file << "timestamp,stage,count,p50_ms,p95_ms,p99_ms,max_ms" << endl;
+	}
+	string timestamp = ofGetTimestampString("%Y-%m-%d %H:%M:%S");
+	for (int i = 0; i < STAGE_COUNT; i++) {
+		LatencyHistogram& histogram = histograms[i];
+		file << timestamp << "," << toString(Stage(i)) << "," << histogram.getCount() << ","
+			 << histogram.getPercentile(0.50) << "," << histogram.getPercentile(0.95) << ","
+			 << histogram.getPercentile(0.99) << "," << histogram.getMax() << endl;
+		histogram.rotate();
+	}
+}
+
+//--------------------------------------------------------------
+string LatencyStats::toString(Stage stage) {
+	switch (stage) {
+		case STAGE_CAPTURE: return "capture";
+		case STAGE_DETECT: return "detect";
+		case STAGE_PREPROCESS: return "preprocess";
+		case STAGE_QUEUE: return "queue";
+		case STAGE_OCR: return "ocr";
+		case STAGE_MATCH: return "match";
+		case STAGE_NETWORK: return "network";
+		case STAGE_CAPTURE_TO_TRIGGER: return "capture_to_trigger";
+		case STAGE_TRIGGER_TO_FRAME: return "trigger_to_frame";
+		case STAGE_TRIGGER_TO_VIDEO: return "trigger_to_video";
+		default: return "unknown";
+	}
+}
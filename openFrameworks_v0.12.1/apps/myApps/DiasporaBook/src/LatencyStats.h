@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ofMain.h"
+
+#include <array>
+#include <atomic>
+
+// Log-bucketed latency histogram that any thread can record into without
+// locking. Buckets are 1/8 of an octave wide (about 9% resolution) from
+// 1us up to about two minutes.
+//
+// Samples go into one of two windows. rotate() clears the older window
+// and makes it current, so percentiles cover between one and two rotation
+// periods: a rolling view rather than everything since startup.
+class LatencyHistogram {
+public:
+	LatencyHistogram();
+
+	void record(uint64_t micros);
+
+	// Over both windows, in milliseconds
+	double getPercentile(double p) const;
+	double getMax() const;
+	uint64_t getCount() const;
+
+	// Only one thread may rotate; recording may continue meanwhile
+	void rotate();
+
+private:
+	enum { SUB_BUCKETS = 8, BUCKETS = 200 };
+
+	struct Window {
+		std::array<std::atomic<uint64_t>, BUCKETS> counts;
+		std::atomic<uint64_t> max;
+		void clear();
+	};
+
+	static size_t bucketFor(uint64_t micros);
+	static uint64_t bucketUpperBound(size_t bucket);
+
+	std::array<Window, 2> windows;
+	std::atomic<int> current;
+};
+
+// Latency histograms for each stage from camera capture to the projection
+// showing its first frame.
+class LatencyStats {
+public:
+	enum Stage {
+		STAGE_CAPTURE, // grabbing a new camera frame
+		STAGE_DETECT, // MSER text regions, on the detector thread
+		STAGE_PREPROCESS, // region merge and OCR preprocessing
+		STAGE_QUEUE, // waiting in the OCR mailbox
+		STAGE_OCR, // Tesseract
+		STAGE_MATCH, // keyword matching
+		STAGE_NETWORK, // keyword event from a recognition node to the projection node
+		STAGE_CAPTURE_TO_TRIGGER, // camera frame to projection triggered
+		STAGE_TRIGGER_TO_FRAME, // trigger to first projected frame
+		STAGE_TRIGGER_TO_VIDEO, // trigger to first frame decoded by the video pipeline
+		STAGE_COUNT
+	};
+
+	void record(Stage stage, uint64_t micros);
+	const LatencyHistogram& get(Stage stage) const;
+
+	// Appends one line per stage to a CSV file and starts a new window
+	void dump(const string& path);
+
+	static string toString(Stage stage);
+
+private:
+	std::array<LatencyHistogram, STAGE_COUNT> histograms;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+// Single-slot "latest value wins" handoff between two threads.
+// Sending while a value is still pending replaces it, so the receiver only
+// ever sees the freshest value and the mailbox never holds more than one.
+template<typename T>
+class LatestMailbox {
+public:
+	LatestMailbox()
+		: hasValue(false)
+		, closed(false)
+		, dropped(0) {
+	}
+	
+	// Returns false if the mailbox was closed. The sent value is swapped
+	// with the stale one, so the caller gets its buffers back for reuse.
+	bool send(T& value) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			if (closed) {
+				return false;
+			}
+			if (hasValue) {
+				dropped++;
+			}
+			std::swap(slot, value);
+			hasValue = true;
+		}
+		condition.notify_one();
+		return true;
+	}
+	
+	bool send(T&& value) {
+		return send(value);
+	}
+	
+	// Blocks until a value arrives or the mailbox is closed.
+	bool receive(T& value) {
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [this] { return hasValue || closed; });
+		if (closed) {
+			return false;
+		}
+		std::swap(value, slot);
+		hasValue = false;
+		return true;
+	}
+	
+	void close() {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			closed = true;
+		}
+		condition.notify_all();
+	}
+	
+	void reopen() {
+		std::unique_lock<std::mutex> lock(mutex);
+		closed = false;
+		hasValue = false;
+	}
+	
+	bool hasPending() const {
+		std::unique_lock<std::mutex> lock(mutex);
+		return hasValue;
+	}
+	
+	uint64_t getDropped() const {
+		return dropped;
+	}
+	
+private:
+	T slot;
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+	bool hasValue;
+	bool closed;
+	std::atomic<uint64_t> dropped;
+};
@@ -0,0 +1,100 @@
+#include "OCRWords.h"
+
+//--------------------------------------------------------------
+void OCRWords::clear() {
+	text.clear();
+	words.clear();
+	lines.clear();
+}
+
+//--------------------------------------------------------------
+bool OCRWords::empty() const {
+	return words.empty();
+}
+
+//--------------------------------------------------------------
+void OCRWords::beginLine(const cv::Rect& box, uint32_t region) {
+	if (!text.empty()) {
+		text += '\n';
+	}
+	Line line;
+	line.box = box;
+	line.firstWord = words.size();
+	line.region = region;
+	lines.push_back(line);
+}
+
+//--------------------------------------------------------------
+void OCRWords::addWord(const char* word, const cv::Rect& box, float confidence) {
+	if (lines.empty()) {
+		beginLine(box, 0);
+	}
+	Line& line = lines.back();
+	if (line.wordCount > 0) {
+		text += ' ';
+	}
+
+	Word entry;
+	entry.box = box;
+	entry.confidence = confidence;
+	entry.offset = text.size();
+	text += word;
+	entry.length = text.size() - entry.offset;
+	entry.line = lines.size() - 1;
+	words.push_back(entry);
+	line.wordCount++;
+}
+
+//--------------------------------------------------------------
+void OCRWords::append(const OCRWords& other, uint32_t region) {
+	if (other.empty()) {
+		return;
+	}
+	if (!text.empty()) {
+		text += '\n';
+	}
+
+	uint32_t textOffset = text.size();
+	uint32_t wordOffset = words.size();
+	uint32_t lineOffset = lines.size();
+	text += other.text;
+	for (Word word : other.words) {
+		word.offset += textOffset;
+		word.line += lineOffset;
+		words.push_back(word);
+	}
+	for (Line line : other.lines) {
+		line.firstWord += wordOffset;
+		line.region = region;
+		lines.push_back(line);
+	}
+}
+
+//--------------------------------------------------------------
+string OCRWords::getText(size_t word) const {
+	if (word >= words.size()) {
+		return "";
+	}
+	return text.substr(words[word].offset, words[word].length);
+}
+
+//--------------------------------------------------------------
+cv::Rect OCRWords::getBounds(size_t first, size_t count) const {
+	cv::Rect bounds;
+	for (size_t i = first; i < std::min(words.size(), first + count); i++) {
+		bounds = bounds.area() > 0 ? (bounds | words[i].box) : words[i].box;
+	}
+	return bounds;
+}
+
+//--------------------------------------------------------------
+float OCRWords::getMeanConfidence() const {
+	if (words.empty()) {
+		return 0;
+	}
+	float sum = 0;
+	for (const auto& word : words) {
+		sum += word.confidence;
+	}
+	return sum / words.size();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxCv.h"
+
+// What Tesseract read on a page, line by line and word by word, with
+// boxes and confidences.
+//
+// All of the text lives in one buffer the words index into, so a page
+// costs three allocations however many words it has, and none at all
+// once a reused instance has grown to size. text doubles as the flat page
+// text: words separated by spaces, lines by newlines.
+struct OCRWords {
+	struct Word {
+		cv::Rect box; // in the coordinates of the recognized image
+		float confidence = 0; // 0-100
+		uint32_t offset = 0; // into text
+		uint32_t length = 0;
+		uint32_t line = 0;
+	};
+
+	struct Line {
+		cv::Rect box;
+		uint32_t firstWord = 0;
+		uint32_t wordCount = 0;
+		uint32_t region = 0; // the region (or page band) it was read in
+	};
+
+	string text;
+	vector<Word> words;
+	vector<Line> lines;
+
+	// Keeps the buffers
+	void clear();
+	bool empty() const;
+
+	void beginLine(const cv::Rect& box, uint32_t region);
+	void addWord(const char* word, const cv::Rect& box, float confidence);
+	// Appends another result's lines, read in the given region
+	void append(const OCRWords& other, uint32_t region);
+
+	string getText(size_t word) const;
+	// Union of the boxes of count words from first
+	cv::Rect getBounds(size_t first, size_t count) const;
+	float getMeanConfidence() const;
+};
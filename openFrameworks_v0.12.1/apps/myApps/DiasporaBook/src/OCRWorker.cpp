@@ -0,0 +1,166 @@
+#include "OCRWorker.h"
+
+//--------------------------------------------------------------
+OCRWorker::OCRWorker()
+	: ocrPool(nullptr)
+	, closed(true)
+	, served(0) {
+}
+
+//--------------------------------------------------------------
+OCRWorker::~OCRWorker() {
+	stop();
+}
+
+//--------------------------------------------------------------
+void OCRWorker::setup(TesseractPool* pool, size_t stations) {
+	ocrPool = pool;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		slots.clear();
+		slots.resize(std::max<size_t>(1, stations));
+		for (size_t i = 0; i < slots.size(); i++) {
+			slots[i].latency = i < latencies.size() ? latencies[i] : nullptr;
+			slots[i].results = std::make_unique<ofSpscChannel<OCRResult>>(4);
+		}
+		closed = false;
+	}
+	setThreadName("OCRWorker");
+	startThread();
+}
+
+//--------------------------------------------------------------
+void OCRWorker::stop() {
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		closed = true;
+	}
+	jobWaiting.notify_all();
+	
+	if (isThreadRunning()) {
+		// Joins after the page being recognized, if any, is done
+		waitForThread(true);
+	}
+	for (auto& slot : slots) {
+		slot.results->close();
+	}
+}
+
+//--------------------------------------------------------------
+size_t OCRWorker::getNumStations() const {
+	return slots.size();
+}
+
+//--------------------------------------------------------------
+void OCRWorker::setLatencyStats(LatencyStats* stats, size_t station) {
+	if (latencies.size() <= station) {
+		latencies.resize(station + 1, nullptr);
+	}
+	latencies[station] = stats;
+}
+
+//--------------------------------------------------------------
+void OCRWorker::submit(OCRJob& job) {
+	job.submitMicros = ofGetElapsedTimeMicros();
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (closed || job.station >= slots.size()) {
+			return;
+		}
+		Slot& slot = slots[job.station];
+		if (slot.pending) {
+			slot.dropped++;
+			// Don't let a periodic frame push out a settled page still waiting
+			job.settled = job.settled || slot.job.settled;
+		}
+		std::swap(slot.job, job);
+		slot.pending = true;
+	}
+	jobWaiting.notify_one();
+}
+
+//--------------------------------------------------------------
+bool OCRWorker::tryReceiveResult(OCRResult& result, size_t station) {
+	return station < slots.size() && slots[station].results->tryReceive(result);
+}
+
+//--------------------------------------------------------------
+bool OCRWorker::isBusy(size_t station) const {
+	std::unique_lock<std::mutex> lock(mutex);
+	return station < slots.size() && (slots[station].working || slots[station].pending);
+}
+
+//--------------------------------------------------------------
+uint64_t OCRWorker::getDroppedFrames(size_t station) const {
+	std::unique_lock<std::mutex> lock(mutex);
+	return station < slots.size() ? slots[station].dropped : 0;
+}
+
+//--------------------------------------------------------------
+bool OCRWorker::next(OCRJob& job) {
+	std::unique_lock<std::mutex> lock(mutex);
+	Slot* best = nullptr;
+	jobWaiting.wait(lock, [&] {
+		if (closed) {
+			return true;
+		}
+		best = nullptr;
+		for (auto& slot : slots) {
+			if (!slot.pending) {
+				continue;
+			}
+			if (!best ||
+				(slot.job.settled && !best->job.settled) ||
+				(slot.job.settled == best->job.settled && slot.lastServed < best->lastServed)) {
+				best = &slot;
+			}
+		}
+		return best != nullptr;
+	});
+	if (closed) {
+		return false;
+	}
+	
+	std::swap(job, best->job);
+	best->pending = false;
+	best->working = true;
+	best->lastServed = ++served;
+	return true;
+}
+
+//--------------------------------------------------------------
+void OCRWorker::threadedFunction() {
+	OCRJob jobToProcess;
+	
+	while (isThreadRunning() && next(jobToProcess)) {
+		Slot& slot = slots[jobToProcess.station];
+		uint64_t start = ofGetElapsedTimeMicros();
+		
+		OCRResult result;
+		result.station = jobToProcess.station;
+		result.frameId = jobToProcess.frameId;
+		result.captureMicros = jobToProcess.captureMicros;
+		result.toCamera = jobToProcess.toCamera;
+		if (ocrPool && jobToProcess.image.isAllocated()) {
+			// Spread over every engine in the pool, this thread just waits
+			cv::Mat mat = ofxCv::toCv(jobToProcess.image);
+			ocrPool->recognize(mat, jobToProcess.regions, jobToProcess.regionMode, jobToProcess.pageMode, result.words);
+			if (slot.latency) {
+				slot.latency->record(LatencyStats::STAGE_QUEUE, start - jobToProcess.submitMicros);
+				slot.latency->record(LatencyStats::STAGE_OCR, ofGetElapsedTimeMicros() - start);
+			}
+		}
+		
+		// Clear the flag before publishing so isBusy() is already false
+		// by the time the main thread sees the result
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			slot.working = false;
+		}
+		// Never blocks, so stop() can always join; a full channel means the
+		// main thread has stopped reading and the result would be stale anyway
+		if (jobToProcess.image.isAllocated()) {
+			slot.results->trySend(std::move(result));
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxCv.h"
+#include "TesseractPool.h"
+#include "LatencyStats.h"
+
+// A preprocessed frame plus the parts of it that should be recognized.
+struct OCRJob {
+	size_t station = 0; // reading station the frame came from
+	uint64_t frameId = 0;
+	uint64_t captureMicros = 0; // when the camera frame arrived
+	uint64_t submitMicros = 0; // set by submit()
+	bool settled = false; // a page that just came to rest, read before periodic frames
+	ofPixels image;
+	// In image coordinates; empty means the whole page is recognized
+	vector<cv::Rect> regions;
+	TesseractOCR::SegmentationMode regionMode = TesseractOCR::SEGMENT_SINGLE_LINE;
+	TesseractOCR::SegmentationMode pageMode = TesseractOCR::SEGMENT_AUTO; // without regions
+	cv::Mat toCamera; // 3x3 perspective transform from image to camera coordinates
+};
+
+struct OCRResult {
+	size_t station = 0;
+	uint64_t frameId = 0; // of the job this was recognized from
+	uint64_t captureMicros = 0;
+	OCRWords words; // boxes in the job's image coordinates
+	cv::Mat toCamera; // as in the job
+};
+
+// Long-lived OCR thread that feeds one TesseractPool from any number of
+// reading stations. Each station has a "latest frame wins" slot, so no
+// station falls behind its camera and the queue never holds more than one
+// job per station. Settled pages go first; among equals the station served
+// longest ago is next, so a busy station can't starve the others.
+class OCRWorker : public ofThread {
+public:
+	OCRWorker();
+	~OCRWorker();
+	
+	void setup(TesseractPool* pool, size_t stations = 1);
+	void stop();
+	size_t getNumStations() const;
+	
+	// Queue wait and OCR time of the station's jobs are recorded here,
+	// from the worker thread. Call before setup().
+	void setLatencyStats(LatencyStats* stats, size_t station = 0);
+	
+	// Hands a preprocessed frame to the worker. A job of the same station
+	// still waiting is dropped in favour of this one. The job is swapped,
+	// not copied: job comes back holding a spent job to refill.
+	void submit(OCRJob& job);
+	bool tryReceiveResult(OCRResult& result, size_t station = 0);
+	
+	bool isBusy(size_t station = 0) const;
+	uint64_t getDroppedFrames(size_t station = 0) const;
+	
+protected:
+	void threadedFunction() override;
+	
+private:
+	struct Slot {
+		OCRJob job;
+		bool pending = false;
+		bool working = false;
+		uint64_t lastServed = 0;
+		uint64_t dropped = 0;
+		LatencyStats* latency = nullptr;
+		std::unique_ptr<ofSpscChannel<OCRResult>> results; // this thread to the main thread
+	};
+	
+	// Blocks until a job is waiting; false once stopped
+	bool next(OCRJob& job);
+	
+	TesseractPool* ocrPool;
+	vector<LatencyStats*> latencies;
+	
+	vector<Slot> slots;
+	mutable std::mutex mutex;
+	std::condition_variable jobWaiting;
+	bool closed;
+	uint64_t served;
+};
@@ -0,0 +1,93 @@
+#include "PageCache.h"
+
+//--------------------------------------------------------------
+PageCache::PageCache()
+	: capacity(32)
+	, maxDistance(12)
+	, clock(0)
+	, hits(0)
+	, misses(0) {
+}
+
+//--------------------------------------------------------------
+void PageCache::setCapacity(size_t newCapacity) {
+	capacity = std::max<size_t>(1, newCapacity);
+	while (entries.size() > capacity) {
+		auto oldest = std::min_element(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+			return a.lastUsed < b.lastUsed;
+		});
+		entries.erase(oldest);
+	}
+}
+
+//--------------------------------------------------------------
+void PageCache::setMaxDistance(int bits) {
+	maxDistance = bits;
+}
+
+//--------------------------------------------------------------
+PageCache::Entry* PageCache::findClosest(const PageFingerprint& fingerprint) {
+	// A handful of pages, so a linear scan is all that's needed
+	Entry* closest = nullptr;
+	int closestDistance = maxDistance + 1;
+	for (auto& entry : entries) {
+		int distance = entry.fingerprint.distance(fingerprint);
+		if (distance < closestDistance) {
+			closest = &entry;
+			closestDistance = distance;
+		}
+	}
+	return closest;
+}
+
+//--------------------------------------------------------------
+const PageCache::Entry* PageCache::find(const PageFingerprint& fingerprint) {
+	Entry* entry = findClosest(fingerprint);
+	if (entry) {
+		entry->lastUsed = ++clock;
+		hits++;
+	} else {
+		misses++;
+	}
+	return entry;
+}
+
+//--------------------------------------------------------------
+void PageCache::insert(const PageFingerprint& fingerprint, const string& text, const vector<KeywordHit>& keywordHits) {
+	Entry* entry = findClosest(fingerprint);
+	if (!entry) {
+		if (entries.size() >= capacity) {
+			// Evict the least recently used page
+			entry = &*std::min_element(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+				return a.lastUsed < b.lastUsed;
+			});
+		} else {
+			entries.emplace_back();
+			entry = &entries.back();
+		}
+	}
+	entry->fingerprint = fingerprint;
+	entry->text = text;
+	entry->hits = keywordHits;
+	entry->lastUsed = ++clock;
+}
+
+//--------------------------------------------------------------
+void PageCache::clear() {
+	entries.clear();
+}
+
+//--------------------------------------------------------------
+uint64_t PageCache::getHits() const {
+	return hits;
+}
+
+//--------------------------------------------------------------
+uint64_t PageCache::getMisses() const {
+	return misses;
+}
+
+//--------------------------------------------------------------
+size_t PageCache::size() const {
+	return entries.size();
+}
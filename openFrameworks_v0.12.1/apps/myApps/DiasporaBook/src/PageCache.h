@@ -0,0 +1,41 @@
+#pragma once
+
+#include "PageStabilityGate.h"
+#include "KeywordMatcher.h"
+
+// Remembers OCR text and keyword hits for recently read pages, keyed by
+// page fingerprint, so turning back to a page doesn't run Tesseract again.
+class PageCache {
+public:
+	struct Entry {
+		PageFingerprint fingerprint;
+		string text;
+		vector<KeywordHit> hits;
+		uint64_t lastUsed = 0;
+	};
+	
+	PageCache();
+	
+	void setCapacity(size_t capacity);
+	// Fingerprints closer than this many bits are treated as the same page
+	void setMaxDistance(int bits);
+	
+	// Returns nullptr on a miss. The pointer stays valid until the next insert.
+	const Entry* find(const PageFingerprint& fingerprint);
+	void insert(const PageFingerprint& fingerprint, const string& text, const vector<KeywordHit>& hits);
+	void clear();
+	
+	uint64_t getHits() const;
+	uint64_t getMisses() const;
+	size_t size() const;
+	
+private:
+	Entry* findClosest(const PageFingerprint& fingerprint);
+	
+	vector<Entry> entries;
+	size_t capacity;
+	int maxDistance;
+	uint64_t clock;
+	uint64_t hits;
+	uint64_t misses;
+};
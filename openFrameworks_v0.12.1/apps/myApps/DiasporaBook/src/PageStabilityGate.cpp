@@ -0,0 +1,114 @@
+#include "PageStabilityGate.h"
+
+#include <bitset>
+
+//--------------------------------------------------------------
+int PageFingerprint::distance(const PageFingerprint& other) const {
+	int count = 0;
+	for (size_t i = 0; i < bits.size(); i++) {
+		count += std::bitset<64>(bits[i] ^ other.bits[i]).count();
+	}
+	return count;
+}
+
+//--------------------------------------------------------------
+PageStabilityGate::PageStabilityGate()
+	: motionThreshold(4.0)
+	, settleFrames(5)
+	, stillFrames(0)
+	, state(PAGE_MOVING)
+	, motion(0) {
+}
+
+//--------------------------------------------------------------
+void PageStabilityGate::setMotionThreshold(float threshold) {
+	motionThreshold = threshold;
+}
+
+//--------------------------------------------------------------
+void PageStabilityGate::setSettleFrames(int frames) {
+	settleFrames = std::max(1, frames);
+}
+
+//--------------------------------------------------------------
+PageStabilityGate::State PageStabilityGate::update(const ofPixels& frame) {
+	if (!frame.isAllocated()) {
+		return state;
+	}
+	
+	// Shrinking first keeps the color conversion nearly free
+	cv::Mat mat = ofxCv::toCv(frame);
+	cv::resize(mat, smallColor, cv::Size(64, 36), 0, 0, cv::INTER_AREA);
+	if (smallColor.channels() == 4) {
+		cv::cvtColor(smallColor, thumbnail, cv::COLOR_RGBA2GRAY);
+	} else if (smallColor.channels() == 3) {
+		cv::cvtColor(smallColor, thumbnail, cv::COLOR_RGB2GRAY);
+	} else {
+		smallColor.copyTo(thumbnail);
+	}
+	
+	if (previousThumbnail.empty()) {
+		motion = 255;
+	} else {
+		cv::absdiff(thumbnail, previousThumbnail, difference);
+		motion = cv::mean(difference)[0];
+	}
+	std::swap(thumbnail, previousThumbnail);
+	
+	if (motion > motionThreshold) {
+		stillFrames = 0;
+		state = PAGE_MOVING;
+	} else if (state == PAGE_SETTLED || state == PAGE_STABLE) {
+		state = PAGE_STABLE;
+	} else if (++stillFrames >= settleFrames) {
+		computeFingerprint();
+		state = PAGE_SETTLED;
+	} else {
+		state = PAGE_SETTLING;
+	}
+	
+	return state;
+}
+
+//--------------------------------------------------------------
+void PageStabilityGate::computeFingerprint() {
+	// previousThumbnail holds the current frame after the swap in update()
+	cv::resize(previousThumbnail, hashMat, cv::Size(17, 16), 0, 0, cv::INTER_AREA);
+	
+	fingerprint.bits.fill(0);
+	int bit = 0;
+	for (int y = 0; y < 16; y++) {
+		const uint8_t* row = hashMat.ptr<uint8_t>(y);
+		for (int x = 0; x < 16; x++, bit++) {
+			if (row[x] > row[x + 1]) {
+				fingerprint.bits[bit / 64] |= uint64_t(1) << (bit % 64);
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+PageStabilityGate::State PageStabilityGate::getState() const {
+	return state;
+}
+
+//--------------------------------------------------------------
+float PageStabilityGate::getMotion() const {
+	return motion;
+}
+
+//--------------------------------------------------------------
+const PageFingerprint& PageStabilityGate::getFingerprint() const {
+	return fingerprint;
+}
+
+//--------------------------------------------------------------
+string PageStabilityGate::toString(State state) {
+	switch (state) {
+		case PAGE_MOVING: return "moving";
+		case PAGE_SETTLING: return "settling";
+		case PAGE_SETTLED: return "settled";
+		case PAGE_STABLE: return "stable";
+	}
+	return "";
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxCv.h"
+
+#include <array>
+
+// 256-bit difference hash of a frame. Near-identical views of the same
+// page differ in only a few bits, so pages are compared by Hamming distance.
+struct PageFingerprint {
+	std::array<uint64_t, 4> bits = {};
+	
+	int distance(const PageFingerprint& other) const;
+};
+
+// Cheap per-frame motion gate. Each frame is reduced to a small grayscale
+// thumbnail and compared with the previous one; the page counts as settled
+// once the mean difference stays under the threshold for a few frames.
+class PageStabilityGate {
+public:
+	enum State {
+		PAGE_MOVING,
+		PAGE_SETTLING,
+		PAGE_SETTLED, // reported once, on the frame the page came to rest
+		PAGE_STABLE
+	};
+	
+	PageStabilityGate();
+	
+	void setMotionThreshold(float threshold);
+	void setSettleFrames(int frames);
+	
+	State update(const ofPixels& frame);
+	State getState() const;
+	// Mean absolute thumbnail difference to the previous frame, 0-255
+	float getMotion() const;
+	// Fingerprint of the latest frame, computed when the page settles
+	const PageFingerprint& getFingerprint() const;
+	
+	static string toString(State state);
+	
+private:
+	void computeFingerprint();
+	
+	float motionThreshold;
+	int settleFrames;
+	int stillFrames;
+	State state;
+	float motion;
+	PageFingerprint fingerprint;
+	
+	cv::Mat smallColor;
+	cv::Mat thumbnail;
+	cv::Mat previousThumbnail;
+	cv::Mat difference;
+	cv::Mat hashMat;
+};
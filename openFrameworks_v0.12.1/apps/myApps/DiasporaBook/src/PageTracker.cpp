@@ -0,0 +1,297 @@
+#include "PageTracker.h"
+
+//--------------------------------------------------------------
+PageTracker::PageTracker()
+	: found(false)
+	, framesSinceDetection(0)
+	, detections(0) {
+}
+
+//--------------------------------------------------------------
+void PageTracker::setSettings(const Settings& newSettings) {
+	if (newSettings.downscale != settings.downscale) {
+		// Tracked points and corners are in the old resolution
+		reset();
+	}
+	settings = newSettings;
+	settings.downscale = ofClamp(settings.downscale, 0.1f, 1.0f);
+	settings.minFeatures = std::max(4, settings.minFeatures);
+	if (found) {
+		updateHomography();
+	}
+}
+
+//--------------------------------------------------------------
+const PageTracker::Settings& PageTracker::getSettings() const {
+	return settings;
+}
+
+//--------------------------------------------------------------
+void PageTracker::reset() {
+	found = false;
+	points.clear();
+	corners.clear();
+	previous = cv::Mat();
+	framesSinceDetection = 0;
+}
+
+//--------------------------------------------------------------
+bool PageTracker::update(const ofPixels& frame) {
+	if (!frame.isAllocated()) {
+		return found;
+	}
+
+	cv::Mat mat = ofxCv::toCv(frame);
+	cv::Mat input = mat;
+	if (mat.channels() == 4) {
+		cv::cvtColor(mat, grayMat, cv::COLOR_RGBA2GRAY);
+		input = grayMat;
+	} else if (mat.channels() == 3) {
+		cv::cvtColor(mat, grayMat, cv::COLOR_RGB2GRAY);
+		input = grayMat;
+	}
+
+	// small is swapped into previous below, so it always has to own its pixels
+	if (settings.downscale < 1.0f) {
+		cv::resize(input, small, cv::Size(), settings.downscale, settings.downscale, cv::INTER_AREA);
+	} else {
+		input.copyTo(small);
+	}
+
+	bool tracked = false;
+	if (found) {
+		// Detecting now and then corrects slow drift; tracking carries on
+		// if the outline can't be seen in this frame
+		if (framesSinceDetection >= settings.redetectFrames) {
+			framesSinceDetection = 0;
+			tracked = detect();
+		}
+		if (!tracked) {
+			tracked = track();
+			framesSinceDetection++;
+		}
+	}
+	if (!tracked) {
+		tracked = detect();
+	}
+
+	found = tracked;
+	if (found) {
+		updateHomography();
+	} else {
+		points.clear();
+	}
+
+	std::swap(previous, small);
+	return found;
+}
+
+//--------------------------------------------------------------
+bool PageTracker::detect() {
+	cv::GaussianBlur(small, edges, cv::Size(5, 5), 0);
+	cv::Canny(edges, edges, 50, 150);
+	cv::dilate(edges, edges, cv::Mat());
+	cv::findContours(edges, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+	// The largest convex four-sided outline is taken to be the page
+	double largest = settings.minPageArea * small.cols * small.rows;
+	bool detected = false;
+	for (const auto& contour : contours) {
+		cv::approxPolyDP(contour, polygon, 0.02 * cv::arcLength(contour, true), true);
+		if (polygon.size() != 4 || !cv::isContourConvex(polygon)) {
+			continue;
+		}
+		double area = std::abs(cv::contourArea(polygon));
+		if (area <= largest) {
+			continue;
+		}
+		largest = area;
+		detected = true;
+
+		// Order clockwise from the top left: extremes of x + y and y - x
+		corners.assign(4, cv::Point2f());
+		auto sum = [](const cv::Point& p) { return p.x + p.y; };
+		auto diff = [](const cv::Point& p) { return p.y - p.x; };
+		corners[0] = *std::min_element(polygon.begin(), polygon.end(), [&](const cv::Point& a, const cv::Point& b) { return sum(a) < sum(b); });
+		corners[1] = *std::min_element(polygon.begin(), polygon.end(), [&](const cv::Point& a, const cv::Point& b) { return diff(a) < diff(b); });
+		corners[2] = *std::max_element(polygon.begin(), polygon.end(), [&](const cv::Point& a, const cv::Point& b) { return sum(a) < sum(b); });
+		corners[3] = *std::max_element(polygon.begin(), polygon.end(), [&](const cv::Point& a, const cv::Point& b) { return diff(a) < diff(b); });
+	}
+
+	if (detected) {
+		seedFeatures();
+		framesSinceDetection = 0;
+		detections++;
+	}
+	return detected;
+}
+
+//--------------------------------------------------------------
+void PageTracker::seedFeatures() {
+	// Corners of print inside the page only, the table doesn't move with it
+	mask.create(small.size(), CV_8UC1);
+	mask.setTo(cv::Scalar(0));
+	polygon.clear();
+	for (const auto& corner : corners) {
+		polygon.push_back(cv::Point(cvRound(corner.x), cvRound(corner.y)));
+	}
+	cv::fillConvexPoly(mask, polygon, cv::Scalar(255));
+	cv::goodFeaturesToTrack(small, points, settings.maxFeatures, 0.01, 8, mask);
+}
+
+//--------------------------------------------------------------
+bool PageTracker::track() {
+	if (previous.empty() || previous.size() != small.size() || int(points.size()) < settings.minFeatures) {
+		return false;
+	}
+
+	cv::calcOpticalFlowPyrLK(previous, small, points, nextPoints, status, errors, cv::Size(21, 21), 3);
+
+	fromPoints.clear();
+	toPoints.clear();
+	for (size_t i = 0; i < points.size(); i++) {
+		if (status[i]) {
+			fromPoints.push_back(points[i]);
+			toPoints.push_back(nextPoints[i]);
+		}
+	}
+	if (int(toPoints.size()) < settings.minFeatures) {
+		return false;
+	}
+
+	cv::Mat motion = cv::findHomography(fromPoints, toPoints, cv::RANSAC, 3, inliers);
+	if (motion.empty()) {
+		return false;
+	}
+
+	vector<cv::Point2f> moved;
+	cv::perspectiveTransform(corners, moved, motion);
+
+	// A bad fit folds or shrinks the outline
+	polygon.clear();
+	for (const auto& corner : moved) {
+		polygon.push_back(cv::Point(cvRound(corner.x), cvRound(corner.y)));
+	}
+	if (!cv::isContourConvex(polygon) ||
+		std::abs(cv::contourArea(polygon)) < settings.minPageArea * small.cols * small.rows) {
+		return false;
+	}
+	corners = moved;
+
+	// Outliers are dropped for good, the rest carry on to the next frame
+	points.clear();
+	for (size_t i = 0; i < toPoints.size(); i++) {
+		if (inliers[i]) {
+			points.push_back(toPoints[i]);
+		}
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+void PageTracker::updateHomography() {
+	cv::Point2f src[4];
+	for (int i = 0; i < 4; i++) {
+		src[i] = corners[i] * (1.0f / settings.downscale);
+	}
+	cv::Point2f dst[4] = {
+		cv::Point2f(0, 0),
+		cv::Point2f(settings.pageWidth, 0),
+		cv::Point2f(settings.pageWidth, settings.pageHeight),
+		cv::Point2f(0, settings.pageHeight)
+	};
+	homography = cv::getPerspectiveTransform(src, dst);
+	inverse = homography.inv();
+}
+
+//--------------------------------------------------------------
+bool PageTracker::hasPage() const {
+	return found;
+}
+
+//--------------------------------------------------------------
+vector<cv::Point2f> PageTracker::getCorners() const {
+	vector<cv::Point2f> full;
+	for (const auto& corner : corners) {
+		full.push_back(corner * (1.0f / settings.downscale));
+	}
+	return full;
+}
+
+//--------------------------------------------------------------
+const cv::Mat& PageTracker::getHomography() const {
+	return homography;
+}
+
+//--------------------------------------------------------------
+void PageTracker::warp(const cv::Mat& frame, cv::Mat& dst, float scale) const {
+	if (!found) {
+		return;
+	}
+
+	// Straight to the size OCR wants, so the page is only resampled once
+	float width = settings.pageWidth * scale;
+	float height = settings.pageHeight * scale;
+	cv::warpPerspective(frame, dst, getToCamera(scale), cv::Size(cvRound(width), cvRound(height)),
+						cv::INTER_LINEAR | cv::WARP_INVERSE_MAP, cv::BORDER_REPLICATE);
+}
+
+//--------------------------------------------------------------
+cv::Mat PageTracker::getToCamera(float scale) const {
+	cv::Point2f src[4];
+	for (int i = 0; i < 4; i++) {
+		src[i] = corners[i] * (1.0f / settings.downscale);
+	}
+	float width = settings.pageWidth * scale;
+	float height = settings.pageHeight * scale;
+	cv::Point2f target[4] = {
+		cv::Point2f(0, 0),
+		cv::Point2f(width, 0),
+		cv::Point2f(width, height),
+		cv::Point2f(0, height)
+	};
+	return cv::getPerspectiveTransform(target, src);
+}
+
+//--------------------------------------------------------------
+void PageTracker::toPage(const vector<cv::Rect>& cameraRects, float scale, vector<cv::Rect>& pageRects) const {
+	pageRects.clear();
+	if (!found) {
+		return;
+	}
+
+	cv::Rect bounds(0, 0, cvRound(settings.pageWidth * scale), cvRound(settings.pageHeight * scale));
+	vector<cv::Point2f> rectCorners(4);
+	vector<cv::Point2f> mapped;
+	for (const auto& rect : cameraRects) {
+		rectCorners[0] = cv::Point2f(rect.x, rect.y);
+		rectCorners[1] = cv::Point2f(rect.x + rect.width, rect.y);
+		rectCorners[2] = cv::Point2f(rect.x + rect.width, rect.y + rect.height);
+		rectCorners[3] = cv::Point2f(rect.x, rect.y + rect.height);
+		cv::perspectiveTransform(rectCorners, mapped, homography);
+		for (auto& point : mapped) {
+			point = point * scale;
+		}
+
+		cv::Rect pageRect = cv::boundingRect(mapped) & bounds;
+		if (pageRect.width > 4 && pageRect.height > 4) {
+			pageRects.push_back(pageRect);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+cv::Point2f PageTracker::toCamera(const cv::Point2f& pagePoint) const {
+	if (!found) {
+		return pagePoint;
+	}
+	vector<cv::Point2f> in(1, pagePoint);
+	vector<cv::Point2f> out;
+	cv::perspectiveTransform(in, out, inverse);
+	return out[0];
+}
+
+//--------------------------------------------------------------
+uint64_t PageTracker::getDetections() const {
+	return detections;
+}
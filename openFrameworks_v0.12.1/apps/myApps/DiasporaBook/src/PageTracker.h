@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxCv.h"
+
+// Finds the book page in the camera view and follows it from frame to
+// frame, so OCR can run on a flat, cropped page instead of the whole table.
+//
+// The page outline, the largest convex quadrilateral in the edge image, is
+// detected once. After that it is tracked at reduced resolution with
+// pyramidal Lucas-Kanade flow on corner features inside it: a RANSAC
+// homography between consecutive frames moves the outline along. The page
+// is detected again when too few features survive, and every few seconds
+// to correct drift.
+class PageTracker {
+public:
+	struct Settings {
+		float downscale = 0.5; // tracking resolution, relative to the camera
+		int pageWidth = 640; // canonical page size, before the OCR scale
+		int pageHeight = 900;
+		int maxFeatures = 150;
+		int minFeatures = 30; // fewer tracked points than this means detecting again
+		int redetectFrames = 150;
+		float minPageArea = 0.1; // fraction of the frame a page outline must cover
+	};
+
+	PageTracker();
+
+	void setSettings(const Settings& settings);
+	const Settings& getSettings() const;
+
+	// Returns true if the page is known in this frame
+	bool update(const ofPixels& frame);
+	void reset();
+
+	bool hasPage() const;
+	// Camera coordinates, clockwise from the top left corner
+	vector<cv::Point2f> getCorners() const;
+	// Maps camera coordinates to canonical page coordinates
+	const cv::Mat& getHomography() const;
+
+	// Warps the page out of a camera frame at scale times the canonical size
+	void warp(const cv::Mat& frame, cv::Mat& dst, float scale) const;
+	// Camera rectangles to their bounding boxes on the warped page,
+	// clipped to it; rectangles off the page are dropped
+	void toPage(const vector<cv::Rect>& cameraRects, float scale, vector<cv::Rect>& pageRects) const;
+	// Canonical page coordinates back to the camera, e.g. for word boxes
+	cv::Point2f toCamera(const cv::Point2f& pagePoint) const;
+	// The inverse of warp(): warped page coordinates at scale to the camera
+	cv::Mat getToCamera(float scale) const;
+
+	uint64_t getDetections() const;
+
+private:
+	bool detect();
+	bool track();
+	void seedFeatures();
+	void updateHomography();
+
+	Settings settings;
+
+	cv::Mat grayMat;
+	cv::Mat small;
+	cv::Mat previous;
+	cv::Mat edges;
+	cv::Mat mask;
+	vector<vector<cv::Point>> contours;
+	vector<cv::Point> polygon;
+	vector<cv::Point2f> points;
+	vector<cv::Point2f> nextPoints;
+	vector<cv::Point2f> fromPoints;
+	vector<cv::Point2f> toPoints;
+	vector<unsigned char> status;
+	vector<float> errors;
+	vector<unsigned char> inliers;
+
+	vector<cv::Point2f> corners; // at tracking resolution
+	cv::Mat homography;
+	cv::Mat inverse;
+	bool found;
+	int framesSinceDetection;
+	uint64_t detections;
+};
@@ -0,0 +1,384 @@
+#include "ParameterTuner.h"
+#include "ReplayApp.h"
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+bool ParameterTuner::parseArguments(int argc, char* argv[], Options& options) {
+	options.keywords = ofApp::getDefaultKeywords();
+
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--tune" && hasValue) {
+			options.source = argv[++i];
+		} else if (arg == "--truth" && hasValue) {
+			options.truthPath = argv[++i];
+		} else if (arg == "--profile" && hasValue) {
+			options.profilePath = argv[++i];
+		} else if (arg == "--out" && hasValue) {
+			options.outputPath = argv[++i];
+		} else if (arg == "--budget" && hasValue) {
+			options.budget = std::max(1, ofToInt(argv[++i]));
+		} else if (arg == "--max-ms" && hasValue) {
+			options.maxMillis = ofToFloat(argv[++i]);
+		} else if (arg == "--engines" && hasValue) {
+			options.engines = std::max(0, ofToInt(argv[++i]));
+		} else if (arg == "--seed" && hasValue) {
+			options.seed = ofToInt(argv[++i]);
+		} else if (arg == "--keywords" && hasValue) {
+			options.keywords = ofSplitString(argv[++i], ",", true, true);
+		} else if (arg == "--no-roi") {
+			options.roi = false;
+		} else {
+			ofLogError("ParameterTuner") << "Unknown argument or missing value: " << arg;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------
+ParameterTuner::ParameterTuner(const Options& tunerOptions)
+	: options(tunerOptions)
+	, expectedKeywords(0)
+	, nextCandidate(0)
+	, refined(false)
+	, random(tunerOptions.seed)
+	, finished(false) {
+}
+
+//--------------------------------------------------------------
+const vector<float>& ParameterTuner::grid(Parameter parameter) {
+	static const vector<float> grids[PARAM_COUNT] = {
+		{1.0, 1.5, 2.0, 2.5, 3.0}, // scale
+		{11, 15, 21, 31, 41}, // threshold block size
+		{4, 6, 8, 10, 12, 15}, // threshold C
+		{1, 2, 3, 4, 6}, // CLAHE clip limit
+		{1, 5, 9, 13}, // bilateral diameter, 1 is a no-op
+		{25, 50, 75, 100, 150}, // bilateral sigma
+		{TesseractOCR::SEGMENT_AUTO, TesseractOCR::SEGMENT_SINGLE_BLOCK},
+		{TesseractOCR::ENGINE_LSTM, TesseractOCR::ENGINE_COMBINED}
+	};
+	return grids[parameter];
+}
+
+//--------------------------------------------------------------
+float ParameterTuner::value(const Candidate& candidate, Parameter parameter) {
+	return grid(parameter)[candidate.steps[parameter]];
+}
+
+//--------------------------------------------------------------
+FramePreprocessor::Settings ParameterTuner::toSettings(const Candidate& candidate) {
+	FramePreprocessor::Settings settings;
+	settings.scale = value(candidate, PARAM_SCALE);
+	settings.threshBlockSize = value(candidate, PARAM_BLOCK_SIZE);
+	settings.threshC = value(candidate, PARAM_THRESH_C);
+	settings.claheClipLimit = value(candidate, PARAM_CLAHE);
+	settings.bilateralDiameter = value(candidate, PARAM_BILATERAL_DIAMETER);
+	settings.bilateralSigmaColor = value(candidate, PARAM_BILATERAL_SIGMA);
+	settings.bilateralSigmaSpace = value(candidate, PARAM_BILATERAL_SIGMA);
+	return settings;
+}
+
+//--------------------------------------------------------------
+string ParameterTuner::describe(const Candidate& candidate) {
+	return "scale " + ofToString(value(candidate, PARAM_SCALE)) +
+		   " block " + ofToString(value(candidate, PARAM_BLOCK_SIZE)) +
+		   " C " + ofToString(value(candidate, PARAM_THRESH_C)) +
+		   " clahe " + ofToString(value(candidate, PARAM_CLAHE)) +
+		   " bilateral " + ofToString(value(candidate, PARAM_BILATERAL_DIAMETER)) +
+		   "/" + ofToString(value(candidate, PARAM_BILATERAL_SIGMA)) +
+		   " psm " + ofToString(value(candidate, PARAM_PAGE_MODE)) +
+		   " oem " + ofToString(value(candidate, PARAM_ENGINE));
+}
+
+//--------------------------------------------------------------
+void ParameterTuner::setup() {
+	if (!ocrPool.setup(options.engines) || !loadFrames()) {
+		finished = true;
+		ofExit(1);
+		return;
+	}
+	keywordMatcher.setKeywords(options.keywords);
+	blank.allocate(64, 64, OF_PIXELS_GRAY);
+	blank.setColor(ofColor(255));
+
+	output.open(ofFilePath::getAbsolutePath(options.outputPath, false), ofFile::WriteOnly);
+	output << "scale,block_size,thresh_c,clahe,bilateral_diameter,bilateral_sigma,page_mode,engine,recall,false_triggers,ms_per_frame" << endl;
+
+	// The current defaults are always measured, as the baseline
+	Candidate defaults;
+	defaults.steps = {2, 2, 3, 1, 2, 2, 0, 0};
+	enqueue(defaults);
+	sample(options.budget);
+
+	ofLogNotice("ParameterTuner") << "Tuning on " << frames.size() << " frames with "
+								  << expectedKeywords << " expected keywords";
+}
+
+//--------------------------------------------------------------
+bool ParameterTuner::loadFrames() {
+	map<string, vector<string>> truth = ReplayApp::loadGroundTruth(options.truthPath);
+	if (truth.empty()) {
+		ofLogError("ParameterTuner") << "Tuning needs labeled frames, see --truth";
+		return false;
+	}
+
+	ofDirectory images(ofFilePath::getAbsolutePath(options.source, false));
+	images.allowExt("png");
+	images.allowExt("jpg");
+	images.allowExt("jpeg");
+	images.allowExt("bmp");
+	images.allowExt("tif");
+	images.listDir();
+	images.sort();
+
+	// Decode every labeled frame up front, on all cores
+	vector<of::filesystem::path> paths;
+	vector<Frame> labeledFrames;
+	for (size_t i = 0; i < images.size(); i++) {
+		auto labeled = truth.find(images.getName(i));
+		if (labeled == truth.end()) {
+			continue;
+		}
+		Frame frame;
+		frame.label = labeled->first;
+		frame.expected = labeled->second;
+		labeledFrames.push_back(std::move(frame));
+		paths.push_back(images.getPath(i));
+	}
+	vector<ofPixels> pixels;
+	vector<bool> loaded = ofLoadImages(pixels, paths);
+
+	TextRegionResult regionResult;
+	for (size_t i = 0; i < labeledFrames.size(); i++) {
+		if (!loaded[i]) {
+			continue;
+		}
+		Frame frame = std::move(labeledFrames[i]);
+		frame.pixels = std::move(pixels[i]);
+		// Regions don't depend on the tuned settings, so they're found once
+		if (options.roi) {
+			regionDetector.detect(i, frame.pixels, regionResult);
+			cv::Size frameSize(frame.pixels.getWidth(), frame.pixels.getHeight());
+			frame.regions = TextRegionDetector::mergeRegions(regionResult.regions, frameSize, false);
+		}
+		expectedKeywords += frame.expected.size();
+		frames.push_back(std::move(frame));
+	}
+
+	if (frames.empty()) {
+		ofLogError("ParameterTuner") << "No labeled frames found in " << options.source;
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ParameterTuner::enqueue(const Candidate& candidate) {
+	if (!seen.insert(candidate.steps).second) {
+		return false;
+	}
+	candidates.push_back(candidate);
+	return true;
+}
+
+//--------------------------------------------------------------
+void ParameterTuner::sample(size_t count) {
+	size_t first = candidates.size();
+	size_t attempts = 0;
+	while (candidates.size() - first < count && attempts++ < count * 20) {
+		Candidate candidate;
+		for (int p = 0; p < PARAM_COUNT; p++) {
+			std::uniform_int_distribution<int> step(0, grid(Parameter(p)).size() - 1);
+			candidate.steps[p] = step(random);
+		}
+		enqueue(candidate);
+	}
+
+	// Switching engine modes reloads every model, so group by it
+	std::stable_sort(candidates.begin() + first, candidates.end(), [](const Candidate& a, const Candidate& b) {
+		return a.steps[PARAM_ENGINE] < b.steps[PARAM_ENGINE];
+	});
+}
+
+//--------------------------------------------------------------
+void ParameterTuner::refine() {
+	// One step either way along each parameter from every point on the front
+	size_t first = candidates.size();
+	size_t limit = std::max(1, options.budget / 2);
+	for (size_t index : paretoFront()) {
+		Candidate base = candidates[index];
+		for (int p = 0; p < PARAM_COUNT && candidates.size() - first < limit; p++) {
+			for (int delta : {-1, 1}) {
+				Candidate neighbour;
+				neighbour.steps = base.steps;
+				neighbour.steps[p] += delta;
+				if (neighbour.steps[p] >= 0 && neighbour.steps[p] < int(grid(Parameter(p)).size()) &&
+					candidates.size() - first < limit) {
+					enqueue(neighbour);
+				}
+			}
+		}
+	}
+	std::stable_sort(candidates.begin() + first, candidates.end(), [](const Candidate& a, const Candidate& b) {
+		return a.steps[PARAM_ENGINE] < b.steps[PARAM_ENGINE];
+	});
+	ofLogNotice("ParameterTuner") << "Refining around the front with " << candidates.size() - first << " neighbours";
+}
+
+//--------------------------------------------------------------
+void ParameterTuner::update() {
+	if (finished) {
+		return;
+	}
+
+	if (nextCandidate == candidates.size()) {
+		if (!refined) {
+			refined = true;
+			refine();
+		}
+		if (nextCandidate == candidates.size()) {
+			finish();
+			return;
+		}
+	}
+
+	Candidate& candidate = candidates[nextCandidate++];
+	evaluate(candidate);
+
+	ofLogNotice("ParameterTuner") << nextCandidate << "/" << candidates.size() << " " << describe(candidate)
+								  << ": recall " << ofToString(candidate.recall, 3) << ", "
+								  << ofToString(candidate.millis, 1) << " ms/frame";
+	output << value(candidate, PARAM_SCALE) << "," << value(candidate, PARAM_BLOCK_SIZE) << ","
+		   << value(candidate, PARAM_THRESH_C) << "," << value(candidate, PARAM_CLAHE) << ","
+		   << value(candidate, PARAM_BILATERAL_DIAMETER) << "," << value(candidate, PARAM_BILATERAL_SIGMA) << ","
+		   << value(candidate, PARAM_PAGE_MODE) << "," << value(candidate, PARAM_ENGINE) << ","
+		   << candidate.recall << "," << candidate.falseTriggers << "," << candidate.millis << endl;
+}
+
+//--------------------------------------------------------------
+void ParameterTuner::evaluate(Candidate& candidate) {
+	preprocessor.setSettings(toSettings(candidate));
+	TesseractOCR::SegmentationMode pageMode = TesseractOCR::SegmentationMode(int(value(candidate, PARAM_PAGE_MODE)));
+
+	// Switching engines reloads every model, that is done before timing
+	TesseractOCR::EngineMode engineMode = TesseractOCR::EngineMode(int(value(candidate, PARAM_ENGINE)));
+	if (engineMode != ocrPool.getEngineMode()) {
+		ocrPool.setEngineMode(engineMode);
+		ocrPool.recognize(ofxCv::toCv(blank), {}, TesseractOCR::SEGMENT_SINGLE_LINE);
+	}
+
+	size_t found = 0;
+	candidate.falseTriggers = 0;
+	uint64_t micros = 0;
+	for (const auto& frame : frames) {
+		uint64_t start = ofGetElapsedTimeMicros();
+		preprocessor.process(ofxCv::toCv(frame.pixels), frame.regions, processed, scaledRegions);
+		ocrPool.recognize(ofxCv::toCv(processed), scaledRegions, TesseractOCR::SEGMENT_SINGLE_LINE, pageMode, words);
+		const vector<KeywordHit>& hits = keywordMatcher.match(words);
+		micros += ofGetElapsedTimeMicros() - start;
+
+		for (const auto& keyword : frame.expected) {
+			bool hit = std::any_of(hits.begin(), hits.end(), [&](const KeywordHit& h) { return h.keyword == keyword; });
+			found += hit ? 1 : 0;
+		}
+		if (frame.expected.empty() && !hits.empty()) {
+			candidate.falseTriggers++;
+		}
+	}
+
+	candidate.recall = expectedKeywords > 0 ? float(found) / expectedKeywords : 0;
+	candidate.millis = micros / 1000.0 / frames.size();
+}
+
+//--------------------------------------------------------------
+vector<size_t> ParameterTuner::paretoFront() const {
+	// Not beaten on both recall and time by any other evaluated setting
+	vector<size_t> front;
+	for (size_t i = 0; i < nextCandidate; i++) {
+		const Candidate& a = candidates[i];
+		bool dominated = false;
+		for (size_t j = 0; j < nextCandidate && !dominated; j++) {
+			const Candidate& b = candidates[j];
+			dominated = b.recall >= a.recall && b.millis <= a.millis && (b.recall > a.recall || b.millis < a.millis);
+		}
+		if (!dominated) {
+			front.push_back(i);
+		}
+	}
+	std::sort(front.begin(), front.end(), [&](size_t a, size_t b) {
+		return candidates[a].millis < candidates[b].millis;
+	});
+	return front;
+}
+
+//--------------------------------------------------------------
+void ParameterTuner::finish() {
+	finished = true;
+	output.close();
+
+	vector<size_t> front = paretoFront();
+	ofLogNotice("ParameterTuner") << "Pareto front, recall vs ms/frame:";
+	for (size_t index : front) {
+		const Candidate& candidate = candidates[index];
+		ofLogNotice("ParameterTuner") << "  " << ofToString(candidate.recall, 3) << "  "
+									  << ofToString(candidate.millis, 1) << " ms  "
+									  << candidate.falseTriggers << " false  " << describe(candidate);
+	}
+
+	// Best recall that fits the budget, then fewest false triggers, then fastest
+	const Candidate* chosen = nullptr;
+	for (size_t index : front) {
+		const Candidate& candidate = candidates[index];
+		if (options.maxMillis > 0 && candidate.millis > options.maxMillis) {
+			continue;
+		}
+		if (!chosen || candidate.recall > chosen->recall ||
+			(candidate.recall == chosen->recall && candidate.falseTriggers < chosen->falseTriggers)) {
+			chosen = &candidate;
+		}
+	}
+	if (!chosen) {
+		ofLogWarning("ParameterTuner") << "Nothing ran within " << options.maxMillis << " ms, using the fastest setting";
+		chosen = &candidates[front.front()];
+	}
+
+	if (saveProfile(*chosen)) {
+		ofLogNotice("ParameterTuner") << "Chose " << describe(*chosen) << ", written to " << options.profilePath;
+	}
+	ofExit();
+}
+
+//--------------------------------------------------------------
+bool ParameterTuner::saveProfile(const Candidate& candidate) const {
+	// Names and types must match the sliders in ofApp::setupGUI(), so
+	// the panel can load the file as its own
+	ofParameterGroup group;
+	group.setName("OCR Controls");
+	ofParameter<float> scale("Scale Factor", value(candidate, PARAM_SCALE));
+	ofParameter<int> blockSize("Thresh Block Size", value(candidate, PARAM_BLOCK_SIZE));
+	ofParameter<float> threshC("Thresh C", value(candidate, PARAM_THRESH_C));
+	ofParameter<float> clahe("CLAHE Clip Limit", value(candidate, PARAM_CLAHE));
+	ofParameter<int> diameter("Bilateral Diameter", value(candidate, PARAM_BILATERAL_DIAMETER));
+	ofParameter<float> sigma("Bilateral Sigma", value(candidate, PARAM_BILATERAL_SIGMA));
+	ofParameter<int> pageMode("Page Seg Mode", value(candidate, PARAM_PAGE_MODE));
+	ofParameter<int> engine("Tesseract Engine", value(candidate, PARAM_ENGINE));
+	ofParameter<bool> roi("ROI OCR", options.roi);
+	group.add(scale, blockSize, threshC, clahe, diameter, sigma, pageMode, engine, roi);
+
+	// Other settings already saved from the panel are kept
+	ofJson json;
+	if (ofFile::doesFileExist(options.profilePath)) {
+		json = ofLoadJson(options.profilePath);
+	}
+	ofSerialize(json, group);
+	return ofSavePrettyJson(options.profilePath, json);
+}
+
+//--------------------------------------------------------------
+void ParameterTuner::exit() {
+	ocrPool.stop();
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxCv.h"
+#include "TesseractPool.h"
+#include "TextRegionDetector.h"
+#include "FramePreprocessor.h"
+#include "KeywordMatcher.h"
+
+#include <random>
+
+// Offline search for the preprocessing and Tesseract settings that give
+// the best keyword recall for the time they cost, on frames captured at
+// the venue.
+//
+// Run as: DiasporaBook --tune <dir> --truth labels.csv [--budget N] [--max-ms M]
+//         [--profile ocr_profile.json] [--out tune_results.csv] [--no-roi]
+//         [--engines N] [--seed N] [--keywords a,b,c]
+//
+// The labeled frames of the image directory (same ground-truth format as
+// --replay) are loaded once. Settings are then evaluated on all of them:
+// first a random sample of the parameter grid, then the one-step
+// neighbours of every point on the Pareto front of keyword recall against
+// milliseconds per frame. Every evaluation goes to a CSV and the front is
+// logged. The best recall within --max-ms (or overall) is written to the
+// profile file the "OCR Controls" panel loads at startup.
+class ParameterTuner : public ofBaseApp {
+public:
+	struct Options {
+		string source;
+		string truthPath;
+		string profilePath = "ocr_profile.json";
+		string outputPath = "tune_results.csv";
+		int budget = 48; // random samples; refinement adds up to half as many
+		float maxMillis = 0; // 0 for no latency limit
+		bool roi = true;
+		int engines = 0;
+		unsigned seed = 1;
+		vector<string> keywords;
+	};
+
+	// Returns false, after logging why, on an argument that doesn't belong
+	// to a tuning run or lacks its value
+	static bool parseArguments(int argc, char* argv[], Options& options);
+
+	ParameterTuner(const Options& options);
+
+	void setup();
+	void update();
+	void exit();
+
+private:
+	enum Parameter {
+		PARAM_SCALE,
+		PARAM_BLOCK_SIZE,
+		PARAM_THRESH_C,
+		PARAM_CLAHE,
+		PARAM_BILATERAL_DIAMETER,
+		PARAM_BILATERAL_SIGMA,
+		PARAM_PAGE_MODE,
+		PARAM_ENGINE,
+		PARAM_COUNT
+	};
+
+	struct Candidate {
+		std::array<int, PARAM_COUNT> steps; // index into each parameter's grid
+		float recall = 0;
+		int falseTriggers = 0; // frames that should not trigger but did
+		float millis = 0; // per frame
+	};
+
+	struct Frame {
+		string label;
+		ofPixels pixels;
+		vector<cv::Rect> regions;
+		vector<string> expected;
+	};
+
+	bool loadFrames();
+	void evaluate(Candidate& candidate);
+	void sample(size_t count);
+	void refine();
+	bool enqueue(const Candidate& candidate);
+	vector<size_t> paretoFront() const;
+	void finish();
+	bool saveProfile(const Candidate& candidate) const;
+
+	static const vector<float>& grid(Parameter parameter);
+	static float value(const Candidate& candidate, Parameter parameter);
+	static string describe(const Candidate& candidate);
+	static FramePreprocessor::Settings toSettings(const Candidate& candidate);
+
+	Options options;
+
+	vector<Frame> frames;
+	size_t expectedKeywords;
+
+	// Evaluated in order; candidates past nextCandidate are still to run
+	vector<Candidate> candidates;
+	size_t nextCandidate;
+	std::set<std::array<int, PARAM_COUNT>> seen;
+	bool refined;
+	std::mt19937 random;
+
+	TesseractPool ocrPool;
+	TextRegionDetector regionDetector;
+	FramePreprocessor preprocessor;
+	KeywordMatcher keywordMatcher;
+	OCRWords words;
+	ofPixels processed;
+	ofPixels blank; // for loading engines outside the timed part
+	vector<cv::Rect> scaledRegions;
+
+	ofFile output;
+	bool finished;
+};
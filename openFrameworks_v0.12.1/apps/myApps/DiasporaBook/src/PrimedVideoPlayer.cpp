@@ -0,0 +1,185 @@
+#include "PrimedVideoPlayer.h"
+
+//--------------------------------------------------------------
+PrimedVideoPlayer::PrimedVideoPlayer()
+	: frameDuration(1 / 30.f)
+	, volume(1)
+	, loaded(false)
+	, playing(false)
+	, live(false)
+	, triggerMicros(0)
+	, firstFrameMicros(0)
+	, firstLiveFrameMicros(0) {
+}
+
+//--------------------------------------------------------------
+bool PrimedVideoPlayer::load(const string& path, size_t primedFrames) {
+	loaded = player.load(path);
+	primed.clear();
+	if (!loaded) {
+		return false;
+	}
+
+	player.setLoopState(OF_LOOP_NONE);
+	if (player.getTotalNumFrames() > 0 && player.getDuration() > 0) {
+		frameDuration = player.getDuration() / player.getTotalNumFrames();
+	}
+
+	// Run the pipeline up to playing once and pause it again: from then on
+	// unpausing goes straight to playing without waiting for a preroll
+	player.setVolume(0);
+	player.play();
+	player.setPaused(true);
+
+	// Decode the opening frames ahead of time and keep them on the GPU
+	size_t count = std::min<size_t>(primedFrames, std::max(1, player.getTotalNumFrames()));
+	for (size_t i = 0; i < count; i++) {
+		player.setFrame(i);
+		if (!waitForFrame()) {
+			break;
+		}
+		primed.emplace_back();
+		primed.back().allocate(player.getPixels());
+		primed.back().loadData(player.getPixels());
+	}
+	ofLogNotice("PrimedVideoPlayer") << "Primed " << primed.size() << " frames of " << path;
+
+	rewind();
+	player.setVolume(volume);
+	return true;
+}
+
+//--------------------------------------------------------------
+bool PrimedVideoPlayer::waitForFrame() {
+	// A seek on a paused pipeline needs a few updates to show up
+	for (int attempt = 0; attempt < 200; attempt++) {
+		player.update();
+		if (player.isFrameNew()) {
+			return true;
+		}
+		ofSleepMillis(5);
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+bool PrimedVideoPlayer::isLoaded() const {
+	return loaded && player.isLoaded();
+}
+
+//--------------------------------------------------------------
+void PrimedVideoPlayer::setVolume(float newVolume) {
+	volume = newVolume;
+	player.setVolume(volume);
+}
+
+//--------------------------------------------------------------
+void PrimedVideoPlayer::play() {
+	if (!loaded) return;
+
+	triggerMicros = ofGetElapsedTimeMicros();
+	firstFrameMicros = 0;
+	firstLiveFrameMicros = 0;
+	live = primed.empty();
+	playing = true;
+
+	// Already sitting on frame 0, so no seek here
+	player.setPaused(false);
+}
+
+//--------------------------------------------------------------
+void PrimedVideoPlayer::rewind() {
+	if (!loaded) return;
+
+	playing = false;
+	live = false;
+	// Seeking now, while nothing is shown, lets the pipeline preroll
+	// frame 0 long before the next trigger
+	player.setPaused(true);
+	player.setFrame(0);
+}
+
+//--------------------------------------------------------------
+void PrimedVideoPlayer::update() {
+	if (!playing) return;
+
+	player.update();
+	if (!player.isFrameNew()) {
+		return;
+	}
+
+	if (firstLiveFrameMicros == 0) {
+		firstLiveFrameMicros = ofGetElapsedTimeMicros();
+	}
+	// Hand over once the player has caught up with the primed frames, so
+	// the picture never steps backwards
+	if (!live && size_t(std::max(0, player.getCurrentFrame())) >= getPrimedIndex()) {
+		live = true;
+	}
+}
+
+//--------------------------------------------------------------
+size_t PrimedVideoPlayer::getPrimedIndex() const {
+	double elapsed = (ofGetElapsedTimeMicros() - triggerMicros) / 1000000.0;
+	return std::min(primed.size() - 1, size_t(elapsed / frameDuration));
+}
+
+//--------------------------------------------------------------
+void PrimedVideoPlayer::draw(float x, float y, float w, float h) {
+	if (!playing) return;
+
+	if (live) {
+		player.draw(x, y, w, h);
+	} else {
+		primed[getPrimedIndex()].draw(x, y, w, h);
+	}
+
+	if (firstFrameMicros == 0) {
+		firstFrameMicros = ofGetElapsedTimeMicros();
+	}
+}
+
+//--------------------------------------------------------------
+bool PrimedVideoPlayer::isPlaying() const {
+	return playing;
+}
+
+//--------------------------------------------------------------
+bool PrimedVideoPlayer::getIsMovieDone() const {
+	return playing && player.getIsMovieDone();
+}
+
+//--------------------------------------------------------------
+float PrimedVideoPlayer::getPosition() const {
+	return player.getPosition();
+}
+
+//--------------------------------------------------------------
+float PrimedVideoPlayer::getDuration() const {
+	return player.getDuration();
+}
+
+//--------------------------------------------------------------
+uint64_t PrimedVideoPlayer::getTriggerMicros() const {
+	return triggerMicros;
+}
+
+//--------------------------------------------------------------
+uint64_t PrimedVideoPlayer::getFirstFrameMicros() const {
+	return firstFrameMicros;
+}
+
+//--------------------------------------------------------------
+uint64_t PrimedVideoPlayer::getFirstLiveFrameMicros() const {
+	return firstLiveFrameMicros;
+}
+
+//--------------------------------------------------------------
+bool PrimedVideoPlayer::isShowingPrimedFrames() const {
+	return playing && !live;
+}
+
+//--------------------------------------------------------------
+size_t PrimedVideoPlayer::getNumPrimedFrames() const {
+	return primed.size();
+}
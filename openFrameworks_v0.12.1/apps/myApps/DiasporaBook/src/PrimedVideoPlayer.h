@@ -0,0 +1,58 @@
+#pragma once
+
+#include "ofMain.h"
+
+// Projection video that shows its first frame on the same tick play() is
+// called.
+//
+// Starting an idle player means a seek plus a paused -> playing state
+// change, which on GStreamer can take hundreds of milliseconds before a
+// frame comes out. Instead, the first few frames are decoded at load time
+// and kept as textures, and between runs the player is left paused on
+// frame 0 with its pipeline prerolled. play() only unpauses it; until the
+// player delivers frames of its own, draw() shows the primed textures at
+// the video's frame rate.
+class PrimedVideoPlayer {
+public:
+	PrimedVideoPlayer();
+
+	bool load(const string& path, size_t primedFrames = 8);
+	bool isLoaded() const;
+	void setVolume(float volume);
+
+	// Starts from frame 0
+	void play();
+	// Pauses and rewinds to frame 0, ready for the next play()
+	void rewind();
+	void update();
+	void draw(float x, float y, float w, float h);
+
+	bool isPlaying() const;
+	bool getIsMovieDone() const;
+	float getPosition() const;
+	float getDuration() const;
+
+	// In ofGetElapsedTimeMicros(): the last play(), the first frame drawn
+	// after it and the first frame the player itself delivered. 0 until
+	// that has happened.
+	uint64_t getTriggerMicros() const;
+	uint64_t getFirstFrameMicros() const;
+	uint64_t getFirstLiveFrameMicros() const;
+	bool isShowingPrimedFrames() const;
+	size_t getNumPrimedFrames() const;
+
+private:
+	bool waitForFrame();
+	size_t getPrimedIndex() const;
+
+	ofVideoPlayer player;
+	vector<ofTexture> primed;
+	float frameDuration; // seconds
+	float volume;
+	bool loaded;
+	bool playing;
+	bool live; // drawing from the player rather than the primed frames
+	uint64_t triggerMicros;
+	uint64_t firstFrameMicros;
+	uint64_t firstLiveFrameMicros;
+};
@@ -0,0 +1,470 @@
+#include "ReadingStation.h"
+
+//--------------------------------------------------------------
+vector<ReadingStation::Config> ReadingStation::loadConfig(const string& path) {
+	vector<Config> configs;
+	ofJson json;
+	if (ofFile::doesFileExist(path)) {
+		json = ofLoadJson(path);
+	}
+	if (json.is_array()) {
+		for (const auto& entry : json) {
+			Config config;
+			config.name = entry.value("name", "Station " + ofToString(configs.size() + 1));
+			config.deviceId = entry.value("device", int(configs.size()));
+			configs.push_back(config);
+		}
+	}
+	if (configs.empty()) {
+		configs.push_back({"Station 1", 0});
+	}
+	return configs;
+}
+
+//--------------------------------------------------------------
+ReadingStation::ReadingStation(size_t index, const string& name, int deviceId)
+	: index(index)
+	, name(name)
+	, deviceId(deviceId)
+	, previewDirty(false)
+	, cameraWidth(0)
+	, cameraHeight(0)
+	, cameraFrameId(0)
+	, frameCaptureMicros(0)
+	, ocrWorker(nullptr)
+	, processingFrame(false)
+	, textRegionsFrameId(0)
+	, showProcessed(false)
+	, lastDetectionTime(0)
+	, detectionCooldown(2.0) { // seconds
+	ocrJob.station = index;
+	trigger.station = index;
+}
+
+//--------------------------------------------------------------
+ReadingStation::~ReadingStation() {
+	stop();
+}
+
+//--------------------------------------------------------------
+bool ReadingStation::setup(int width, int height, OCRWorker* worker, const vector<string>& keywords) {
+	cameraWidth = width;
+	cameraHeight = height;
+	ocrWorker = worker;
+	keywordMatcher.setKeywords(keywords);
+
+	camera.setVerbose(true);
+	camera.setDeviceID(deviceId);
+	camera.setDesiredFrameRate(30);
+	// No grabber texture: detection and OCR only need the pixels, the
+	// preview is uploaded separately and only when it is drawn
+	bool ready = camera.setup(cameraWidth, cameraHeight, false);
+
+	regionDetector.setLatencyStats(&latency);
+	regionDetector.setup();
+
+	ofLogNotice("ReadingStation") << name << ": camera " << deviceId << " " << cameraWidth << "x" << cameraHeight
+								  << (ready ? "" : " failed to open");
+	return ready;
+}
+
+//--------------------------------------------------------------
+void ReadingStation::stop() {
+	regionDetector.stop();
+	camera.close();
+}
+
+//--------------------------------------------------------------
+void ReadingStation::setSettings(const Settings& newSettings) {
+	settings = newSettings;
+	keywordMatcher.setMinConfidence(settings.minWordConfidence);
+}
+
+//--------------------------------------------------------------
+bool ReadingStation::update() {
+	bool trigger = false;
+
+	uint64_t captureStart = ofGetElapsedTimeMicros();
+	camera.update();
+
+	if (camera.isFrameNew()) {
+		frameCaptureMicros = ofGetElapsedTimeMicros();
+		latency.record(LatencyStats::STAGE_CAPTURE, frameCaptureMicros - captureStart);
+		cameraFrameId++;
+		previewDirty = true;
+
+		// Follow the page so OCR can read it flattened and cropped
+		if (settings.rectifyPage) {
+			pageTracker.update(camera.getPixels());
+		} else if (pageTracker.hasPage()) {
+			pageTracker.reset();
+		}
+
+		if (settings.stabilityGate) {
+			// OCR once per page, when it comes to rest after being turned
+			pageGate.setMotionThreshold(settings.motionThreshold);
+			pageGate.setSettleFrames(settings.settleFrames);
+			if (pageGate.update(camera.getPixels()) == PageStabilityGate::PAGE_SETTLED && settings.enableOCR) {
+				trigger = handleSettledPage();
+			}
+		} else if (cameraFrameId % 30 == 0 && settings.enableOCR) {
+			// Perform OCR processing every 30 frames (similar to Python version)
+			performOCR(false);
+		}
+
+		// Text regions are detected asynchronously for visual feedback and ROI OCR
+		if (cameraFrameId % std::max(1, settings.mserFrameStride) == 0) {
+			regionDetector.setDownscale(settings.mserDownscale);
+			regionDetector.submit(cameraFrameId, camera.getPixels());
+		}
+	}
+
+	// Pick up the newest detected regions, if any were published
+	TextRegionResult regionResult;
+	if (regionDetector.tryReceiveLatest(regionResult)) {
+		textRegions = std::move(regionResult.regions);
+		textRegionsFrameId = regionResult.frameId;
+	}
+
+	// Check for OCR results
+	OCRResult ocrResult;
+	if (ocrWorker && ocrWorker->tryReceiveResult(ocrResult, index)) {
+		uint64_t matchStart = ofGetElapsedTimeMicros();
+		const vector<KeywordHit>& hits = keywordMatcher.match(ocrResult.words);
+		latency.record(LatencyStats::STAGE_MATCH, ofGetElapsedTimeMicros() - matchStart);
+
+		// Remember what was read on this page for the next time it is shown
+		for (const auto& pending : pendingPages) {
+			if (pending.first == ocrResult.frameId) {
+				pageCache.insert(pending.second, ocrResult.words.text, hits);
+			}
+		}
+		ofRemove(pendingPages, [&](const pair<uint64_t, PageFingerprint>& pending) {
+			return pending.first <= ocrResult.frameId;
+		});
+
+		if (acceptKeywordHits(hits)) {
+			ofLogNotice() << "The keyword is captured at " << name;
+			// Where on the page each hit was read, back in camera coordinates
+			hitBoxes.clear();
+			vector<cv::Point2f> corners(4);
+			vector<cv::Point2f> mapped;
+			for (const auto& hit : hits) {
+				cv::Rect box = ocrResult.words.getBounds(hit.wordIndex, hit.wordCount);
+				if (box.area() == 0 || ocrResult.toCamera.empty()) continue;
+				corners[0] = cv::Point2f(box.x, box.y);
+				corners[1] = cv::Point2f(box.x + box.width, box.y);
+				corners[2] = cv::Point2f(box.x + box.width, box.y + box.height);
+				corners[3] = cv::Point2f(box.x, box.y + box.height);
+				cv::perspectiveTransform(corners, mapped, ocrResult.toCamera);
+				hitBoxes.push_back(cv::boundingRect(mapped));
+			}
+			setTrigger(hits, hitBoxes, ocrResult.frameId, ocrResult.captureMicros);
+			latency.record(LatencyStats::STAGE_CAPTURE_TO_TRIGGER, ofGetElapsedTimeMicros() - ocrResult.captureMicros);
+			trigger = true;
+		}
+	}
+	processingFrame = ocrWorker && ocrWorker->isBusy(index);
+
+	return trigger;
+}
+
+//--------------------------------------------------------------
+bool ReadingStation::handleSettledPage() {
+	const PageFingerprint& fingerprint = pageGate.getFingerprint();
+
+	if (const PageCache::Entry* cached = pageCache.find(fingerprint)) {
+		// Seen this page before, reuse what was read instead of running OCR
+		ofLogVerbose() << name << ": page already read, reusing cached OCR result";
+		if (acceptKeywordHits(cached->hits)) {
+			ofLogNotice() << "The keyword is captured at " << name << " (cached page)";
+			// The page may lie elsewhere now, so no word boxes
+			hitBoxes.clear();
+			setTrigger(cached->hits, hitBoxes, cameraFrameId, frameCaptureMicros);
+			latency.record(LatencyStats::STAGE_CAPTURE_TO_TRIGGER, ofGetElapsedTimeMicros() - frameCaptureMicros);
+			return true;
+		}
+		return false;
+	}
+
+	// Only the job in progress and the one waiting can still report back
+	if (pendingPages.size() >= 2) {
+		pendingPages.erase(pendingPages.begin());
+	}
+	pendingPages.emplace_back(cameraFrameId, fingerprint);
+	// A freshly turned page is what a reader is waiting on, so it jumps
+	// ahead of other stations' periodic frames
+	performOCR(true);
+	return false;
+}
+
+//--------------------------------------------------------------
+void ReadingStation::performOCR(bool settled) {
+	if (!ocrWorker) return;
+
+	processingFrame = true;
+
+	// Process frame for OCR
+	uint64_t start = ofGetElapsedTimeMicros();
+	processFrameForOCR(camera.getPixels());
+	latency.record(LatencyStats::STAGE_PREPROCESS, ofGetElapsedTimeMicros() - start);
+	ocrJob.station = index;
+	ocrJob.frameId = cameraFrameId;
+	ocrJob.captureMicros = frameCaptureMicros;
+	ocrJob.settled = settled;
+
+	// Hand the job to the shared OCR worker, replacing any job of this
+	// station it has not picked up yet. ocrJob comes back holding a spent
+	// job whose buffers are reused.
+	ocrWorker->submit(ocrJob);
+}
+
+//--------------------------------------------------------------
+void ReadingStation::processFrameForOCR(const ofPixels& frame) {
+	bool rectified = settings.rectifyPage && pageTracker.hasPage();
+
+	// A rectified page is warped straight to the OCR scale
+	FramePreprocessor::Settings preprocess = settings.preprocess;
+	float scale = preprocess.scale;
+	if (rectified) {
+		preprocess.scale = 1.0f;
+	}
+	preprocessor.setSettings(preprocess);
+
+	ocrRegions.clear();
+	if (settings.roiOCR) {
+		ocrRegions = TextRegionDetector::mergeRegions(textRegions, cv::Size(cameraWidth, cameraHeight), settings.roiParagraphs);
+	}
+
+	// Writes straight into the job's recycled buffers
+	if (rectified) {
+		// Only the page, flattened, instead of the whole skewed table
+		pageTracker.warp(ofxCv::toCv(frame), pageMat, scale);
+		// With no detected text on the page, the whole page is read
+		pageTracker.toPage(ocrRegions, scale, pageRegions);
+		preprocessor.process(pageMat, pageRegions, ocrJob.image, ocrJob.regions);
+		ocrJob.toCamera = pageTracker.getToCamera(scale);
+	} else {
+		preprocessor.process(ofxCv::toCv(frame), ocrRegions, ocrJob.image, ocrJob.regions);
+		ocrJob.toCamera = cv::Mat::eye(3, 3, CV_64F);
+		ocrJob.toCamera.at<double>(0, 0) = 1.0 / scale;
+		ocrJob.toCamera.at<double>(1, 1) = 1.0 / scale;
+	}
+	ocrJob.regionMode = settings.roiParagraphs ? TesseractOCR::SEGMENT_SINGLE_BLOCK : TesseractOCR::SEGMENT_SINGLE_LINE;
+	ocrJob.pageMode = settings.pageMode;
+
+	// Only pay for a texture upload when the result is on screen
+	if (showProcessed) {
+		processedFrame.setFromPixels(ocrJob.image);
+	}
+}
+
+//--------------------------------------------------------------
+bool ReadingStation::acceptKeywordHits(const vector<KeywordHit>& hits) {
+	if (hits.empty()) {
+		return false;
+	}
+
+	// Hits come best first
+	const KeywordHit& best = hits.front();
+	ofLogVerbose() << name << ": keyword hit: " << best.keyword << " at word " << best.wordIndex
+				   << " (edits " << best.distance << ", score " << best.score << ")";
+
+	float currentTime = ofGetElapsedTimef();
+	if (currentTime - lastDetectionTime > detectionCooldown) {
+		lastDetectionTime = currentTime;
+		return true;
+	}
+
+	return false;
+}
+
+//--------------------------------------------------------------
+void ReadingStation::setTrigger(const vector<KeywordHit>& hits, const vector<cv::Rect>& boxes, uint64_t frameId, uint64_t captureMicros) {
+	// Hits come best first
+	const KeywordHit& best = hits.front();
+	trigger.frameId = frameId;
+	trigger.captureMicros = captureMicros;
+	trigger.keyword = best.keyword;
+	trigger.score = best.score;
+
+	// The words themselves; failing those the boxes last read on this
+	// page, or the page itself
+	trigger.boxes.clear();
+	float scaleX = 1.0f / std::max(1, cameraWidth);
+	float scaleY = 1.0f / std::max(1, cameraHeight);
+	const vector<cv::Rect>& rects = boxes.empty() ? ocrRegions : boxes;
+	for (const auto& rect : rects) {
+		trigger.boxes.emplace_back(rect.x * scaleX, rect.y * scaleY, rect.width * scaleX, rect.height * scaleY);
+	}
+	if (trigger.boxes.empty() && pageTracker.hasPage()) {
+		cv::Rect page = cv::boundingRect(pageTracker.getCorners());
+		trigger.boxes.emplace_back(page.x * scaleX, page.y * scaleY, page.width * scaleX, page.height * scaleY);
+	}
+}
+
+//--------------------------------------------------------------
+const KeywordEvent& ReadingStation::getTrigger() const {
+	return trigger;
+}
+
+//--------------------------------------------------------------
+void ReadingStation::updatePreview() {
+	const ofPixels& pixels = camera.getPixels();
+	if (!previewDirty || !pixels.isAllocated()) {
+		return;
+	}
+	previewDirty = false;
+
+	const ofPixels* upload = &pixels;
+	if (settings.previewScale < 1.0) {
+		// Downscale on the CPU so less data crosses the bus
+		int w = std::max(1, int(pixels.getWidth() * settings.previewScale));
+		int h = std::max(1, int(pixels.getHeight() * settings.previewScale));
+		previewPixels.allocate(w, h, pixels.getPixelFormat());
+		cv::Mat dst = ofxCv::toCv(previewPixels);
+		cv::resize(ofxCv::toCv(pixels), dst, dst.size(), 0, 0, cv::INTER_AREA);
+		upload = &previewPixels;
+	}
+
+	// Reallocate only when the preview scale changed
+	if (preview.getWidth() != upload->getWidth() || preview.getHeight() != upload->getHeight()) {
+		preview.allocate(*upload);
+	}
+	preview.loadData(*upload);
+}
+
+//--------------------------------------------------------------
+void ReadingStation::draw(float x, float y, float w, float h) {
+	// Upload the latest frame only now that it is needed
+	updatePreview();
+	ofSetColor(255);
+	if (preview.isAllocated()) {
+		preview.draw(x, y, w, h);
+	}
+
+	ofPushMatrix();
+	ofTranslate(x, y);
+	ofNoFill();
+	ofSetLineWidth(2);
+
+	float scaleX = w / std::max(1, cameraWidth);
+	float scaleY = h / std::max(1, cameraHeight);
+
+	// Draw detected text regions
+	ofSetColor(255, 0, 0, 100);
+	for (const auto& rect : textRegions) {
+		ofDrawRectangle(rect.x * scaleX, rect.y * scaleY,
+					   rect.width * scaleX, rect.height * scaleY);
+	}
+
+	// Draw the merged boxes last sent to OCR
+	ofSetColor(0, 160, 255, 160);
+	for (const auto& rect : ocrRegions) {
+		ofDrawRectangle(rect.x * scaleX, rect.y * scaleY,
+					   rect.width * scaleX, rect.height * scaleY);
+	}
+
+	// Draw where the last keyword was read
+	ofSetColor(255, 220, 0, 220);
+	for (const auto& box : trigger.boxes) {
+		ofDrawRectangle(box.x * w, box.y * h, box.width * w, box.height * h);
+	}
+
+	// Draw the tracked page outline
+	if (settings.rectifyPage && pageTracker.hasPage()) {
+		ofSetColor(0, 255, 120, 200);
+		ofBeginShape();
+		for (const auto& corner : pageTracker.getCorners()) {
+			ofVertex(corner.x * scaleX, corner.y * scaleY);
+		}
+		ofEndShape(true);
+	}
+
+	ofFill();
+	ofPopMatrix();
+
+	ofSetColor(processingFrame ? ofColor(255, 255, 0) : ofColor(0, 255, 0));
+	ofDrawBitmapString(name + (processingFrame ? "  PROCESSING OCR..." : ""), x + 10, y + h - 10);
+}
+
+//--------------------------------------------------------------
+void ReadingStation::drawProcessed(float x, float y, float w, float h) {
+	if (!showProcessed || processedFrame.getWidth() == 0) {
+		return;
+	}
+	ofSetColor(255);
+	processedFrame.draw(x, y, w, h);
+	ofSetColor(255, 0, 0);
+	ofDrawBitmapString("Processed Frame (" + name + ")", x, y + h + 20);
+}
+
+//--------------------------------------------------------------
+size_t ReadingStation::getIndex() const {
+	return index;
+}
+
+//--------------------------------------------------------------
+const string& ReadingStation::getName() const {
+	return name;
+}
+
+//--------------------------------------------------------------
+int ReadingStation::getDeviceId() const {
+	return deviceId;
+}
+
+//--------------------------------------------------------------
+LatencyStats& ReadingStation::getLatency() {
+	return latency;
+}
+
+//--------------------------------------------------------------
+const LatencyStats& ReadingStation::getLatency() const {
+	return latency;
+}
+
+//--------------------------------------------------------------
+const PageStabilityGate& ReadingStation::getPageGate() const {
+	return pageGate;
+}
+
+//--------------------------------------------------------------
+const PageCache& ReadingStation::getPageCache() const {
+	return pageCache;
+}
+
+//--------------------------------------------------------------
+bool ReadingStation::isProcessing() const {
+	return processingFrame;
+}
+
+//--------------------------------------------------------------
+uint64_t ReadingStation::getDroppedFrames() const {
+	return ocrWorker ? ocrWorker->getDroppedFrames(index) : 0;
+}
+
+//--------------------------------------------------------------
+size_t ReadingStation::getNumTextRegions() const {
+	return textRegions.size();
+}
+
+//--------------------------------------------------------------
+uint64_t ReadingStation::getTextRegionsAge() const {
+	return cameraFrameId - textRegionsFrameId;
+}
+
+//--------------------------------------------------------------
+const ofPixels& ReadingStation::getPixels() const {
+	return camera.getPixels();
+}
+
+//--------------------------------------------------------------
+void ReadingStation::clearCache() {
+	pageCache.clear();
+}
+
+//--------------------------------------------------------------
+void ReadingStation::setShowProcessed(bool show) {
+	showProcessed = show;
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxCv.h"
+#include "OCRWorker.h"
+#include "TextRegionDetector.h"
+#include "FramePreprocessor.h"
+#include "KeywordMatcher.h"
+#include "PageStabilityGate.h"
+#include "PageCache.h"
+#include "LatencyStats.h"
+#include "PageTracker.h"
+
+// A keyword read at a station
+struct KeywordEvent {
+	int station = 0;
+	uint64_t frameId = 0;
+	uint64_t captureMicros = 0; // when the camera frame arrived
+	uint64_t sendMicros = 0; // set when sent to a projection node
+	string keyword;
+	float score = 0;
+	vector<ofRectangle> boxes; // where it was read, normalized to the camera frame
+};
+
+// One book under one camera: capture, page tracking and gating, text
+// region detection, preprocessing and keyword matching. OCR itself runs
+// on the OCRWorker and engine pool all stations share.
+class ReadingStation {
+public:
+	// Shared by all stations, set from the GUI every frame
+	struct Settings {
+		bool enableOCR = true;
+		bool roiOCR = true;
+		bool roiParagraphs = false;
+		bool stabilityGate = true;
+		float motionThreshold = 4.0;
+		int settleFrames = 5;
+		bool rectifyPage = true;
+		float mserDownscale = 0.5;
+		int mserFrameStride = 2;
+		float previewScale = 0.5;
+		float minWordConfidence = 0; // words Tesseract is less sure of are not matched
+		FramePreprocessor::Settings preprocess;
+		TesseractOCR::SegmentationMode pageMode = TesseractOCR::SEGMENT_AUTO;
+	};
+
+	struct Config {
+		string name;
+		int deviceId = 0;
+	};
+
+	// A JSON list of stations, e.g.
+	// [{"name": "Station 1", "device": 0}, {"name": "Station 2", "device": 1}]
+	// Without the file there is a single station on the first camera.
+	static vector<Config> loadConfig(const string& path);
+
+	ReadingStation(size_t index, const string& name, int deviceId);
+	~ReadingStation();
+
+	// The worker must have a slot for this station's index
+	bool setup(int width, int height, OCRWorker* worker, const vector<string>& keywords);
+	void stop();
+
+	void setSettings(const Settings& settings);
+
+	// Returns true when a keyword read on this station's page should
+	// trigger the projection
+	bool update();
+	// What the last trigger was about
+	const KeywordEvent& getTrigger() const;
+
+	void draw(float x, float y, float w, float h);
+	void drawProcessed(float x, float y, float w, float h);
+
+	size_t getIndex() const;
+	const string& getName() const;
+	int getDeviceId() const;
+
+	LatencyStats& getLatency();
+	const LatencyStats& getLatency() const;
+	const PageStabilityGate& getPageGate() const;
+	const PageCache& getPageCache() const;
+
+	bool isProcessing() const;
+	uint64_t getDroppedFrames() const;
+	size_t getNumTextRegions() const;
+	uint64_t getTextRegionsAge() const; // in camera frames
+
+	const ofPixels& getPixels() const;
+	void clearCache();
+	// Shows the preprocessed OCR input, paid for only while it is drawn
+	void setShowProcessed(bool show);
+
+private:
+	void processFrameForOCR(const ofPixels& frame);
+	void performOCR(bool settled);
+	bool handleSettledPage();
+	bool acceptKeywordHits(const vector<KeywordHit>& hits);
+	// Camera boxes of the hits; without any, the boxes last read or the page
+	void setTrigger(const vector<KeywordHit>& hits, const vector<cv::Rect>& hitBoxes, uint64_t frameId, uint64_t captureMicros);
+	void updatePreview();
+
+	size_t index;
+	string name;
+	int deviceId;
+
+	// CPU-only, frames are read through getPixels()
+	ofVideoGrabber camera;
+	ofTexture preview;
+	ofPixels previewPixels;
+	bool previewDirty;
+	int cameraWidth, cameraHeight;
+	uint64_t cameraFrameId;
+	uint64_t frameCaptureMicros; // when the current camera frame arrived
+
+	Settings settings;
+	OCRWorker* ocrWorker;
+	bool processingFrame;
+
+	// Page stability gating and OCR result cache
+	PageStabilityGate pageGate;
+	PageCache pageCache;
+	vector<pair<uint64_t, PageFingerprint>> pendingPages; // OCR jobs in flight, by frame id
+
+	// Text regions, detected on this station's own thread
+	TextRegionDetector regionDetector;
+	uint64_t textRegionsFrameId;
+	vector<cv::Rect> textRegions;
+	vector<cv::Rect> ocrRegions; // merged line/paragraph boxes, camera coordinates
+
+	// Page rectification: OCR runs on the tracked page, warped flat
+	PageTracker pageTracker;
+	cv::Mat pageMat;
+	vector<cv::Rect> pageRegions; // ocrRegions on the warped page
+
+	FramePreprocessor preprocessor;
+	OCRJob ocrJob; // filled in place, buffers are recycled through the worker's slot
+	bool showProcessed;
+	ofImage processedFrame;
+
+	KeywordMatcher keywordMatcher;
+	float lastDetectionTime;
+	float detectionCooldown;
+	KeywordEvent trigger;
+	vector<cv::Rect> hitBoxes;
+
+	LatencyStats latency;
+};
@@ -0,0 +1,196 @@
+#include "RecognitionNode.h"
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+bool RecognitionNode::parseArguments(int argc, char* argv[], Options& options) {
+	options.keywords = ofApp::getDefaultKeywords();
+
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--recognize") {
+			// the mode flag, already seen by main
+		} else if (arg == "--send" && hasValue) {
+			vector<string> address = ofSplitString(argv[++i], ":", true, true);
+			if (!address.empty()) {
+				options.host = address[0];
+			}
+			if (address.size() > 1) {
+				options.port = ofToInt(address[1]);
+			}
+		} else if (arg == "--listen" && hasValue) {
+			options.listenPort = ofToInt(argv[++i]);
+		} else if (arg == "--stations" && hasValue) {
+			options.stationsPath = argv[++i];
+		} else if (arg == "--profile" && hasValue) {
+			options.profilePath = argv[++i];
+		} else if (arg == "--engines" && hasValue) {
+			options.engines = std::max(0, ofToInt(argv[++i]));
+		} else if (arg == "--keywords" && hasValue) {
+			options.keywords = ofSplitString(argv[++i], ",", true, true);
+		} else if (arg == "--synthetic" && hasValue) {
+			options.synthetic = std::max(0.1f, ofToFloat(argv[++i]));
+		} else {
+			ofLogError("RecognitionNode") << "Unknown argument or missing value: " << arg;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------
+RecognitionNode::RecognitionNode(const Options& nodeOptions)
+	: options(nodeOptions)
+	, engineMode(TesseractOCR::ENGINE_LSTM)
+	, lastSynthetic(0)
+	, lastReport(0) {
+}
+
+//--------------------------------------------------------------
+void RecognitionNode::setup() {
+	// Cameras deliver 30 fps; polling faster only burns a core
+	ofSetFrameRate(60);
+
+	if (!sender.setup(options.host, options.port, options.listenPort)) {
+		ofLogError("RecognitionNode") << "Could not open OSC on " << options.host << ":" << options.port;
+		ofExit(1);
+		return;
+	}
+	if (options.synthetic > 0) {
+		ofLogNotice("RecognitionNode") << "Sending a synthetic keyword event every " << options.synthetic << " s";
+		return;
+	}
+
+	loadProfile();
+	if (!ocrPool.setup(options.engines, engineMode)) {
+		ofLogError("RecognitionNode") << "Failed to initialize OCR engines";
+		ofExit(1);
+		return;
+	}
+
+	for (const auto& config : ReadingStation::loadConfig(options.stationsPath)) {
+		stations.push_back(std::make_unique<ReadingStation>(stations.size(), config.name, config.deviceId));
+	}
+	for (auto& station : stations) {
+		station->setSettings(settings);
+		station->setup(1280, 720, &ocrWorker, options.keywords);
+		ocrWorker.setLatencyStats(&station->getLatency(), station->getIndex());
+	}
+	ocrWorker.setup(&ocrPool, stations.size());
+
+	ofLogNotice("RecognitionNode") << "Reading stations: " << stations.size() << ", sharing " << ocrPool.size() << " OCR engines";
+}
+
+//--------------------------------------------------------------
+void RecognitionNode::loadProfile() {
+	// Names and types must match the sliders in ofApp::setupGUI()
+	ReadingStation::Settings defaults;
+	ofParameterGroup group;
+	group.setName("OCR Controls");
+	ofParameter<float> scale("Scale Factor", defaults.preprocess.scale);
+	ofParameter<int> blockSize("Thresh Block Size", defaults.preprocess.threshBlockSize);
+	ofParameter<float> threshC("Thresh C", defaults.preprocess.threshC);
+	ofParameter<float> clahe("CLAHE Clip Limit", defaults.preprocess.claheClipLimit);
+	ofParameter<int> diameter("Bilateral Diameter", defaults.preprocess.bilateralDiameter);
+	ofParameter<float> sigma("Bilateral Sigma", defaults.preprocess.bilateralSigmaColor);
+	ofParameter<int> pageMode("Page Seg Mode", defaults.pageMode);
+	ofParameter<int> engine("Tesseract Engine", TesseractOCR::ENGINE_LSTM);
+	ofParameter<bool> enableOCR("Enable OCR", defaults.enableOCR);
+	ofParameter<bool> roi("ROI OCR", defaults.roiOCR);
+	ofParameter<bool> paragraphs("ROI Paragraphs", defaults.roiParagraphs);
+	ofParameter<float> mserDownscale("MSER Downscale", defaults.mserDownscale);
+	ofParameter<int> mserStride("MSER Frame Stride", defaults.mserFrameStride);
+	ofParameter<bool> gate("Stability Gate", defaults.stabilityGate);
+	ofParameter<float> motion("Motion Threshold", defaults.motionThreshold);
+	ofParameter<int> settle("Settle Frames", defaults.settleFrames);
+	ofParameter<bool> rectify("Rectify Page", defaults.rectifyPage);
+	ofParameter<float> minConfidence("Min Word Confidence", defaults.minWordConfidence);
+	group.add(scale, blockSize, threshC, clahe, diameter, sigma, pageMode, engine, enableOCR);
+	group.add(roi, paragraphs, mserDownscale, mserStride, gate, motion, settle, rectify, minConfidence);
+
+	if (ofFile::doesFileExist(options.profilePath)) {
+		ofDeserialize(ofLoadJson(options.profilePath), group);
+		ofLogNotice("RecognitionNode") << "Loaded OCR profile: " << options.profilePath;
+	}
+
+	settings.preprocess.scale = scale;
+	settings.preprocess.threshBlockSize = blockSize;
+	settings.preprocess.threshC = threshC;
+	settings.preprocess.claheClipLimit = clahe;
+	settings.preprocess.bilateralDiameter = diameter;
+	settings.preprocess.bilateralSigmaColor = sigma;
+	settings.preprocess.bilateralSigmaSpace = sigma;
+	settings.pageMode = TesseractOCR::SegmentationMode(int(pageMode));
+	settings.enableOCR = enableOCR;
+	settings.roiOCR = roi;
+	settings.roiParagraphs = paragraphs;
+	settings.mserDownscale = mserDownscale;
+	settings.mserFrameStride = mserStride;
+	settings.stabilityGate = gate;
+	settings.motionThreshold = motion;
+	settings.settleFrames = settle;
+	settings.rectifyPage = rectify;
+	settings.minWordConfidence = minConfidence;
+	engineMode = TesseractOCR::EngineMode(int(engine));
+}
+
+//--------------------------------------------------------------
+void RecognitionNode::update() {
+	sender.update();
+
+	if (options.synthetic > 0) {
+		if (ofGetElapsedTimef() - lastSynthetic >= options.synthetic) {
+			lastSynthetic = ofGetElapsedTimef();
+			sendSynthetic();
+		}
+	}
+
+	for (auto& station : stations) {
+		if (station->update()) {
+			KeywordEvent event = station->getTrigger();
+			sender.send(event);
+		}
+	}
+
+	// Roll the latency windows over and keep a record of them
+	if (ofGetElapsedTimef() - lastReport > 10) {
+		lastReport = ofGetElapsedTimef();
+		for (size_t i = 0; i < stations.size(); i++) {
+			stations[i]->getLatency().dump(getLatencyPath(i));
+		}
+		ofLogNotice("RecognitionNode") << sender.getEventsSent() << " events sent, "
+									   << sender.getPingsAnswered() << " clock pings answered";
+	}
+}
+
+//--------------------------------------------------------------
+void RecognitionNode::sendSynthetic() {
+	// Stamped as if a camera frame had just arrived
+	KeywordEvent event;
+	event.frameId = ofGetFrameNum();
+	event.captureMicros = ofGetElapsedTimeMicros();
+	event.keyword = options.keywords.empty() ? "diaspora" : options.keywords.front();
+	event.score = 1;
+	event.boxes.emplace_back(0.4, 0.45, 0.2, 0.1);
+	sender.send(event);
+}
+
+//--------------------------------------------------------------
+string RecognitionNode::getLatencyPath(size_t station) const {
+	if (stations.size() == 1) {
+		return ofToDataPath("latency.csv");
+	}
+	return ofToDataPath("latency_station" + ofToString(station + 1) + ".csv");
+}
+
+//--------------------------------------------------------------
+void RecognitionNode::exit() {
+	ocrWorker.stop();
+	for (size_t i = 0; i < stations.size(); i++) {
+		stations[i]->stop();
+		stations[i]->getLatency().dump(getLatencyPath(i));
+	}
+	ocrPool.stop();
+}
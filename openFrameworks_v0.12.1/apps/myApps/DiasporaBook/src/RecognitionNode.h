@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ofMain.h"
+#include "TesseractPool.h"
+#include "OCRWorker.h"
+#include "ReadingStation.h"
+#include "RemoteTrigger.h"
+
+// Headless capture and recognition for a separate projection process, so
+// OCR never competes with video decoding for the render loop.
+//
+// Run as: DiasporaBook --recognize [--send host:port] [--listen port]
+//         [--stations stations.json] [--profile ocr_profile.json]
+//         [--engines N] [--keywords a,b,c] [--synthetic seconds]
+//
+// Keyword events go to the projection node (DiasporaBook --project) over
+// OSC, 127.0.0.1:9000 by default; clock pings are answered on port 9001.
+// With --synthetic no camera or OCR is used: an event is sent every few
+// seconds instead, to try the two processes against each other locally.
+class RecognitionNode : public ofBaseApp {
+public:
+	struct Options {
+		string host = "127.0.0.1";
+		int port = 9000;
+		int listenPort = 9001;
+		string stationsPath = "stations.json";
+		string profilePath = "ocr_profile.json";
+		int engines = 0;
+		vector<string> keywords;
+		float synthetic = 0; // seconds between made-up events, 0 for real ones
+	};
+
+	// Returns false, after logging why, on an argument that doesn't belong
+	// to a recognition node or lacks its value
+	static bool parseArguments(int argc, char* argv[], Options& options);
+
+	RecognitionNode(const Options& options);
+
+	void setup();
+	void update();
+	void exit();
+
+private:
+	// The same file the "OCR Controls" panel saves
+	void loadProfile();
+	void sendSynthetic();
+	string getLatencyPath(size_t station) const;
+
+	Options options;
+
+	TesseractPool ocrPool;
+	OCRWorker ocrWorker;
+	vector<std::unique_ptr<ReadingStation>> stations;
+	ReadingStation::Settings settings;
+	TesseractOCR::EngineMode engineMode;
+
+	TriggerSender sender;
+	float lastSynthetic;
+	float lastReport;
+};
@@ -0,0 +1,265 @@
+#include "RemoteTrigger.h"
+
+namespace {
+	const string keywordAddress = "/diaspora/keyword";
+	const string pingAddress = "/diaspora/ping";
+	const string pongAddress = "/diaspora/pong";
+
+	const size_t maxClockSamples = 16;
+	// Quickly at first, then just enough to follow drift
+	const uint64_t fastPingMicros = 100000;
+	const uint64_t pingMicros = 1000000;
+}
+
+//--------------------------------------------------------------
+ClockOffset::ClockOffset() {
+	reset();
+}
+
+//--------------------------------------------------------------
+void ClockOffset::addSample(int64_t sent, int64_t peerReceived, int64_t peerReplied, int64_t received) {
+	Sample sample;
+	sample.offset = ((peerReceived - sent) + (peerReplied - received)) / 2;
+	sample.roundTrip = (received - sent) - (peerReplied - peerReceived);
+	if (sample.roundTrip < 0) {
+		return;
+	}
+
+	samples.push_back(sample);
+	if (samples.size() > maxClockSamples) {
+		samples.pop_front();
+	}
+	best = *std::min_element(samples.begin(), samples.end(), [](const Sample& a, const Sample& b) {
+		return a.roundTrip < b.roundTrip;
+	});
+}
+
+//--------------------------------------------------------------
+void ClockOffset::reset() {
+	samples.clear();
+	best.offset = 0;
+	best.roundTrip = 0;
+}
+
+//--------------------------------------------------------------
+bool ClockOffset::isValid() const {
+	return !samples.empty();
+}
+
+//--------------------------------------------------------------
+size_t ClockOffset::getNumSamples() const {
+	return samples.size();
+}
+
+//--------------------------------------------------------------
+int64_t ClockOffset::getOffset() const {
+	return best.offset;
+}
+
+//--------------------------------------------------------------
+int64_t ClockOffset::getRoundTrip() const {
+	return best.roundTrip;
+}
+
+//--------------------------------------------------------------
+uint64_t ClockOffset::toLocal(uint64_t peerMicros) const {
+	return int64_t(peerMicros) - best.offset;
+}
+
+//--------------------------------------------------------------
+TriggerSender::TriggerSender()
+	: pongPort(0)
+	, eventsSent(0)
+	, pingsAnswered(0) {
+}
+
+//--------------------------------------------------------------
+bool TriggerSender::setup(const string& host, int port, int listenPort) {
+	bool ready = sender.setup(host, port) && receiver.setup(listenPort);
+	ofLogNotice("TriggerSender") << "Keyword events to " << host << ":" << port
+								 << ", clock pings on port " << listenPort << (ready ? "" : " (failed)");
+	return ready;
+}
+
+//--------------------------------------------------------------
+void TriggerSender::update() {
+	ofxOscMessage message;
+	while (receiver.getNextMessage(message)) {
+		int64_t received = ofGetElapsedTimeMicros();
+		if (message.getAddress() != pingAddress || message.getNumArgs() < 3) {
+			continue;
+		}
+
+		// Reply to whoever asked, on the port it listens on
+		string host = message.getRemoteHost();
+		int port = message.getArgAsInt32(2);
+		if (host != pongHost || port != pongPort) {
+			pongHost = host;
+			pongPort = port;
+			pongSender.setup(pongHost, pongPort);
+		}
+
+		ofxOscMessage pong;
+		pong.setAddress(pongAddress);
+		pong.addIntArg(message.getArgAsInt32(0));
+		pong.addInt64Arg(message.getArgAsInt64(1));
+		pong.addInt64Arg(received);
+		pong.addInt64Arg(ofGetElapsedTimeMicros());
+		pongSender.sendMessage(pong, false);
+		pingsAnswered++;
+	}
+}
+
+//--------------------------------------------------------------
+void TriggerSender::send(KeywordEvent& event) {
+	event.sendMicros = ofGetElapsedTimeMicros();
+
+	ofxOscMessage message;
+	message.setAddress(keywordAddress);
+	message.addIntArg(event.station);
+	message.addInt64Arg(event.frameId);
+	message.addInt64Arg(event.captureMicros);
+	message.addInt64Arg(event.sendMicros);
+	message.addStringArg(event.keyword);
+	message.addFloatArg(event.score);
+	message.addIntArg(event.boxes.size());
+	for (const auto& box : event.boxes) {
+		message.addFloatArg(box.x);
+		message.addFloatArg(box.y);
+		message.addFloatArg(box.width);
+		message.addFloatArg(box.height);
+	}
+	if (sender.sendMessage(message, false)) {
+		eventsSent++;
+	}
+}
+
+//--------------------------------------------------------------
+uint64_t TriggerSender::getEventsSent() const {
+	return eventsSent;
+}
+
+//--------------------------------------------------------------
+uint64_t TriggerSender::getPingsAnswered() const {
+	return pingsAnswered;
+}
+
+//--------------------------------------------------------------
+TriggerReceiver::TriggerReceiver()
+	: listenPort(0)
+	, latency(nullptr)
+	, pingSequence(0)
+	, lastPingMicros(0)
+	, eventsReceived(0)
+	, lastLatencyMs(0) {
+}
+
+//--------------------------------------------------------------
+bool TriggerReceiver::setup(int port, const string& host, int recognitionPort) {
+	listenPort = port;
+	clock.reset();
+	bool ready = receiver.setup(listenPort) && sender.setup(host, recognitionPort);
+	ofLogNotice("TriggerReceiver") << "Keyword events on port " << listenPort << ", clock pings to "
+								   << host << ":" << recognitionPort << (ready ? "" : " (failed)");
+	return ready;
+}
+
+//--------------------------------------------------------------
+void TriggerReceiver::setLatencyStats(LatencyStats* stats) {
+	latency = stats;
+}
+
+//--------------------------------------------------------------
+bool TriggerReceiver::update(KeywordEvent& event) {
+	uint64_t now = ofGetElapsedTimeMicros();
+	uint64_t interval = clock.getNumSamples() < 8 ? fastPingMicros : pingMicros;
+	if (now - lastPingMicros >= interval) {
+		ping();
+	}
+
+	ofxOscMessage message;
+	while (receiver.getNextMessage(message)) {
+		if (message.getAddress() == pongAddress) {
+			handlePong(message);
+		} else if (message.getAddress() == keywordAddress && readEvent(message, event)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+void TriggerReceiver::ping() {
+	lastPingMicros = ofGetElapsedTimeMicros();
+
+	ofxOscMessage message;
+	message.setAddress(pingAddress);
+	message.addIntArg(++pingSequence);
+	message.addInt64Arg(lastPingMicros);
+	message.addIntArg(listenPort);
+	sender.sendMessage(message, false);
+}
+
+//--------------------------------------------------------------
+void TriggerReceiver::handlePong(const ofxOscMessage& message) {
+	if (message.getNumArgs() < 4) {
+		return;
+	}
+	clock.addSample(message.getArgAsInt64(1), message.getArgAsInt64(2), message.getArgAsInt64(3), ofGetElapsedTimeMicros());
+}
+
+//--------------------------------------------------------------
+bool TriggerReceiver::readEvent(const ofxOscMessage& message, KeywordEvent& event) {
+	uint64_t received = ofGetElapsedTimeMicros();
+	if (message.getNumArgs() < 7) {
+		return false;
+	}
+
+	event.station = message.getArgAsInt32(0);
+	event.frameId = message.getArgAsInt64(1);
+	event.keyword = message.getArgAsString(4);
+	event.score = message.getArgAsFloat(5);
+	size_t boxCount = std::max(0, message.getArgAsInt32(6));
+	boxCount = std::min<size_t>(boxCount, (message.getNumArgs() - 7) / 4);
+	event.boxes.resize(boxCount);
+	for (size_t i = 0; i < boxCount; i++) {
+		size_t arg = 7 + i * 4;
+		event.boxes[i].set(message.getArgAsFloat(arg), message.getArgAsFloat(arg + 1),
+						   message.getArgAsFloat(arg + 2), message.getArgAsFloat(arg + 3));
+	}
+	eventsReceived++;
+
+	// Without an offset yet the event still triggers, it just can't be timed
+	if (!clock.isValid()) {
+		event.captureMicros = received;
+		event.sendMicros = received;
+		return true;
+	}
+	event.captureMicros = clock.toLocal(message.getArgAsInt64(2));
+	event.sendMicros = clock.toLocal(message.getArgAsInt64(3));
+	// The offset is only good to about half the round trip, so a fast
+	// hop can come out slightly negative
+	uint64_t network = received > event.sendMicros ? received - event.sendMicros : 0;
+	uint64_t endToEnd = received > event.captureMicros ? received - event.captureMicros : 0;
+	lastLatencyMs = endToEnd / 1000.0;
+	if (latency) {
+		latency->record(LatencyStats::STAGE_NETWORK, network);
+		latency->record(LatencyStats::STAGE_CAPTURE_TO_TRIGGER, endToEnd);
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+const ClockOffset& TriggerReceiver::getClock() const {
+	return clock;
+}
+
+//--------------------------------------------------------------
+uint64_t TriggerReceiver::getEventsReceived() const {
+	return eventsReceived;
+}
+
+//--------------------------------------------------------------
+float TriggerReceiver::getLastLatencyMs() const {
+	return lastLatencyMs;
+}
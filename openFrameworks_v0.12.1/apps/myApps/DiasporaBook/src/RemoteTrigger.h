@@ -0,0 +1,106 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxOsc.h"
+#include "LatencyStats.h"
+#include "ReadingStation.h"
+
+#include <deque>
+
+// Keyword events between a headless recognition node and a projection
+// node, over OSC. Each process stamps with its own ofGetElapsedTimeMicros()
+// clock; the projection node estimates the offset between the two.
+//
+//   /diaspora/keyword  station, frameId, captureMicros, sendMicros,
+//                      keyword, score, box count, then x y w h per box
+//   /diaspora/ping     seq, sentMicros, reply port       (projection to recognition)
+//   /diaspora/pong     seq, sentMicros, receivedMicros, repliedMicros
+
+// Offset of a peer's clock from ours, from NTP-style ping exchanges. Of the
+// recent samples the one with the shortest round trip is used: queueing
+// only ever adds delay, so it is the least skewed.
+class ClockOffset {
+public:
+	ClockOffset();
+
+	// Our send time, the peer's receive and reply times, our receive time
+	void addSample(int64_t sent, int64_t peerReceived, int64_t peerReplied, int64_t received);
+	void reset();
+
+	bool isValid() const;
+	size_t getNumSamples() const;
+	int64_t getOffset() const; // peer clock minus ours
+	int64_t getRoundTrip() const;
+	uint64_t toLocal(uint64_t peerMicros) const;
+
+private:
+	struct Sample {
+		int64_t offset;
+		int64_t roundTrip;
+	};
+
+	std::deque<Sample> samples;
+	Sample best;
+};
+
+// Recognition side: sends keyword events and answers clock pings
+class TriggerSender {
+public:
+	TriggerSender();
+
+	// Events go to host:port, pings are answered on listenPort
+	bool setup(const string& host, int port, int listenPort);
+	void update();
+
+	// Stamps sendMicros
+	void send(KeywordEvent& event);
+
+	uint64_t getEventsSent() const;
+	uint64_t getPingsAnswered() const;
+
+private:
+	ofxOscSender sender;
+	ofxOscReceiver receiver;
+	ofxOscSender pongSender;
+	string pongHost;
+	int pongPort;
+	uint64_t eventsSent;
+	uint64_t pingsAnswered;
+};
+
+// Projection side: receives keyword events and keeps the clock offset to
+// the recognition node up to date
+class TriggerReceiver {
+public:
+	TriggerReceiver();
+
+	// Events arrive on listenPort, pings go to the recognition node at host:port
+	bool setup(int listenPort, const string& host, int port);
+
+	// Network delay and capture to receipt are recorded here, once the
+	// clock offset is known
+	void setLatencyStats(LatencyStats* stats);
+
+	// Pings now and then and drains incoming messages. Returns true with
+	// the next event, its timestamps converted to our clock.
+	bool update(KeywordEvent& event);
+
+	const ClockOffset& getClock() const;
+	uint64_t getEventsReceived() const;
+	float getLastLatencyMs() const; // capture at the recognition node to receipt here
+
+private:
+	void ping();
+	void handlePong(const ofxOscMessage& message);
+	bool readEvent(const ofxOscMessage& message, KeywordEvent& event);
+
+	ofxOscSender sender;
+	ofxOscReceiver receiver;
+	int listenPort;
+	LatencyStats* latency;
+	ClockOffset clock;
+	int pingSequence;
+	uint64_t lastPingMicros;
+	uint64_t eventsReceived;
+	float lastLatencyMs;
+};
@@ -0,0 +1,357 @@
+#include "ReplayApp.h"
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+static double percentile(vector<double> values, double p) {
+	if (values.empty()) return 0;
+	size_t index = std::min(values.size() - 1, size_t(p * (values.size() - 1) + 0.5));
+	std::nth_element(values.begin(), values.begin() + index, values.end());
+	return values[index];
+}
+
+//--------------------------------------------------------------
+bool ReplayApp::parseArguments(int argc, char* argv[], Options& options) {
+	options.keywords = ofApp::getDefaultKeywords();
+
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--replay" && hasValue) {
+			options.source = argv[++i];
+		} else if (arg == "--truth" && hasValue) {
+			options.truthPath = argv[++i];
+		} else if (arg == "--out" && hasValue) {
+			options.outputPath = argv[++i];
+		} else if (arg == "--keywords" && hasValue) {
+			options.keywords = ofSplitString(argv[++i], ",", true, true);
+		} else if (arg == "--stride" && hasValue) {
+			options.stride = std::max(1, ofToInt(argv[++i]));
+		} else if (arg == "--engines" && hasValue) {
+			options.engines = std::max(0, ofToInt(argv[++i]));
+		} else if (arg == "--max-frames" && hasValue) {
+			options.maxFrames = ofToInt(argv[++i]);
+		} else if (arg == "--scale" && hasValue) {
+			options.preprocess.scale = ofToFloat(argv[++i]);
+		} else if (arg == "--mser-downscale" && hasValue) {
+			options.mserDownscale = ofToFloat(argv[++i]);
+		} else if (arg == "--gate") {
+			options.gate = true;
+		} else if (arg == "--no-roi") {
+			options.roi = false;
+		} else if (arg == "--paragraphs") {
+			options.paragraphs = true;
+		} else {
+			ofLogError("ReplayApp") << "Unknown argument or missing value: " << arg;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------
+ReplayApp::ReplayApp(const Options& replayOptions)
+	: options(replayOptions)
+	, fromVideo(false)
+	, frameIndex(0)
+	, ocrRuns(0)
+	, truePositives(0)
+	, falsePositives(0)
+	, falseNegatives(0)
+	, trueNegatives(0)
+	, expectedKeywords(0)
+	, foundKeywords(0)
+	, startMicros(0)
+	, finished(false) {
+}
+
+//--------------------------------------------------------------
+void ReplayApp::setup() {
+	if (!ocrPool.setup(options.engines)) {
+		ofLogError("ReplayApp") << "Failed to initialize OCR engine";
+		finished = true;
+		ofExit(1);
+		return;
+	}
+
+	regionDetector.setDownscale(options.mserDownscale);
+	preprocessor.setSettings(options.preprocess);
+	keywordMatcher.setKeywords(options.keywords);
+	groundTruth = loadGroundTruth(options.truthPath);
+
+	if (!openSource()) {
+		finished = true;
+		ofExit(1);
+		return;
+	}
+
+	output.open(ofFilePath::getAbsolutePath(options.outputPath, false), ofFile::WriteOnly);
+	output << "frame,regions,ocr,detect_ms,preprocess_ms,ocr_ms,match_ms,total_ms,hits,expected,outcome" << endl;
+
+	ofLogNotice("ReplayApp") << "Replaying " << options.source << (options.gate ? " (gated)" : "")
+							 << ", writing timings to " << options.outputPath;
+	startMicros = ofGetElapsedTimeMicros();
+}
+
+//--------------------------------------------------------------
+bool ReplayApp::openSource() {
+	string path = ofFilePath::getAbsolutePath(options.source, false);
+
+	if (ofDirectory::doesDirectoryExist(path, false)) {
+		images.open(path);
+		images.allowExt("png");
+		images.allowExt("jpg");
+		images.allowExt("jpeg");
+		images.allowExt("bmp");
+		images.allowExt("tif");
+		images.listDir();
+		images.sort();
+		fromVideo = false;
+		ofLogNotice("ReplayApp") << "Image sequence with " << images.size() << " frames";
+		return images.size() > 0;
+	}
+
+	// Decoded on the CPU only, nothing is ever drawn
+	video.setUseTexture(false);
+	if (!video.load(path)) {
+		ofLogError("ReplayApp") << "Could not open replay source: " << path;
+		return false;
+	}
+	video.setLoopState(OF_LOOP_NONE);
+	video.setPaused(true);
+	fromVideo = true;
+	ofLogNotice("ReplayApp") << "Video with " << video.getTotalNumFrames() << " frames";
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ReplayApp::nextFrame() {
+	if (options.maxFrames > 0 && frameIndex >= size_t(options.maxFrames)) {
+		return false;
+	}
+
+	if (!fromVideo) {
+		if (frameIndex >= images.size()) {
+			return false;
+		}
+		frameLabel = images.getName(frameIndex);
+		return ofLoadImage(frame, images.getPath(frameIndex));
+	}
+
+	if (frameIndex >= size_t(std::max(0, video.getTotalNumFrames()))) {
+		return false;
+	}
+	if (frameIndex > 0) {
+		video.nextFrame();
+	}
+	// Stepping a paused pipeline can take a few updates to deliver
+	for (int attempt = 0; attempt < 100; attempt++) {
+		video.update();
+		if (video.isFrameNew() || (frameIndex == 0 && video.getPixels().isAllocated())) {
+			break;
+		}
+		ofSleepMillis(1);
+	}
+	frameLabel = ofToString(frameIndex);
+	frame = video.getPixels();
+	return frame.isAllocated();
+}
+
+//--------------------------------------------------------------
+void ReplayApp::update() {
+	if (finished) {
+		return;
+	}
+
+	if (!nextFrame()) {
+		finished = true;
+		writeSummary();
+		ofExit();
+		return;
+	}
+
+	processFrame();
+	frameIndex++;
+}
+
+//--------------------------------------------------------------
+void ReplayApp::processFrame() {
+	FrameTiming timing;
+	uint64_t frameStart = ofGetElapsedTimeMicros();
+
+	// Decide whether this frame is read, the same way the installation does
+	bool runOCR = false;
+	bool scored = true;
+	if (options.gate) {
+		PageStabilityGate::State state = pageGate.update(frame);
+		if (state == PageStabilityGate::PAGE_MOVING) {
+			pageKeywords.clear();
+		} else if (state == PageStabilityGate::PAGE_SETTLED) {
+			if (const PageCache::Entry* cached = pageCache.find(pageGate.getFingerprint())) {
+				pageKeywords.clear();
+				for (const auto& hit : cached->hits) {
+					pageKeywords.push_back(hit.keyword);
+				}
+			} else {
+				runOCR = true;
+			}
+		}
+	} else {
+		runOCR = frameIndex % options.stride == 0;
+		scored = runOCR;
+	}
+
+	size_t regionCount = 0;
+	if (runOCR) {
+		uint64_t start = ofGetElapsedTimeMicros();
+		regionDetector.detect(frameIndex, frame, regionResult);
+		cv::Size frameSize(frame.getWidth(), frame.getHeight());
+		ocrRegions.clear();
+		if (options.roi) {
+			ocrRegions = TextRegionDetector::mergeRegions(regionResult.regions, frameSize, options.paragraphs);
+		}
+		regionCount = ocrRegions.size();
+		timing.detect = (ofGetElapsedTimeMicros() - start) / 1000.0;
+
+		start = ofGetElapsedTimeMicros();
+		preprocessor.process(ofxCv::toCv(frame), ocrRegions, processedFrame, scaledRegions);
+		timing.preprocess = (ofGetElapsedTimeMicros() - start) / 1000.0;
+
+		start = ofGetElapsedTimeMicros();
+		cv::Mat processed = ofxCv::toCv(processedFrame);
+		TesseractOCR::SegmentationMode mode = options.paragraphs ? TesseractOCR::SEGMENT_SINGLE_BLOCK : TesseractOCR::SEGMENT_SINGLE_LINE;
+		ocrPool.recognize(processed, scaledRegions, mode, TesseractOCR::SEGMENT_AUTO, words);
+		timing.ocr = (ofGetElapsedTimeMicros() - start) / 1000.0;
+		ocrRuns++;
+
+		start = ofGetElapsedTimeMicros();
+		const vector<KeywordHit>& hits = keywordMatcher.match(words);
+		timing.match = (ofGetElapsedTimeMicros() - start) / 1000.0;
+
+		pageKeywords.clear();
+		for (const auto& hit : hits) {
+			pageKeywords.push_back(hit.keyword);
+		}
+		if (options.gate) {
+			pageCache.insert(pageGate.getFingerprint(), words.text, hits);
+		}
+	}
+	timing.total = (ofGetElapsedTimeMicros() - frameStart) / 1000.0;
+	timings.push_back(timing);
+
+	string outcome = "-";
+	string expected = "-";
+	auto truth = groundTruth.find(frameLabel);
+	if (scored && truth != groundTruth.end()) {
+		expected = ofJoinString(truth->second, ";");
+		bool expectedHit = !truth->second.empty();
+		bool predictedHit = !pageKeywords.empty();
+		if (expectedHit && predictedHit) {
+			truePositives++;
+			outcome = "TP";
+		} else if (predictedHit) {
+			falsePositives++;
+			outcome = "FP";
+		} else if (expectedHit) {
+			falseNegatives++;
+			outcome = "FN";
+		} else {
+			trueNegatives++;
+			outcome = "TN";
+		}
+		scoreFrame(truth->second);
+	}
+
+	output << frameLabel << "," << regionCount << "," << (runOCR ? 1 : 0) << ","
+		   << timing.detect << "," << timing.preprocess << "," << timing.ocr << ","
+		   << timing.match << "," << timing.total << ","
+		   << ofJoinString(pageKeywords, ";") << "," << expected << "," << outcome << endl;
+}
+
+//--------------------------------------------------------------
+void ReplayApp::scoreFrame(const vector<string>& expected) {
+	for (const auto& keyword : expected) {
+		expectedKeywords++;
+		if (std::find(pageKeywords.begin(), pageKeywords.end(), keyword) != pageKeywords.end()) {
+			foundKeywords++;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+map<string, vector<string>> ReplayApp::loadGroundTruth(const string& path) {
+	map<string, vector<string>> truth;
+	if (path.empty()) {
+		return truth;
+	}
+
+	ofBuffer buffer = ofBufferFromFile(ofFilePath::getAbsolutePath(path, false));
+	for (const auto& line : buffer.getLines()) {
+		string trimmed = ofTrim(line);
+		if (trimmed.empty() || trimmed[0] == '#') continue;
+
+		size_t comma = trimmed.find(',');
+		string label = ofTrim(trimmed.substr(0, comma));
+		vector<string> keywords;
+		if (comma != string::npos) {
+			for (const auto& keyword : ofSplitString(trimmed.substr(comma + 1), ";", true, true)) {
+				keywords.push_back(ofToLower(keyword));
+			}
+		}
+		truth[label] = keywords;
+	}
+	ofLogNotice("ReplayApp") << "Loaded " << truth.size() << " labeled frames";
+	return truth;
+}
+
+//--------------------------------------------------------------
+void ReplayApp::writeSummary() {
+	output.close();
+
+	double seconds = (ofGetElapsedTimeMicros() - startMicros) / 1000000.0;
+	auto stage = [&](double FrameTiming::*field, bool ocrOnly) {
+		vector<double> values;
+		for (const auto& timing : timings) {
+			if (!ocrOnly || timing.ocr > 0) {
+				values.push_back(timing.*field);
+			}
+		}
+		ofJson json;
+		json["p50"] = percentile(values, 0.50);
+		json["p95"] = percentile(values, 0.95);
+		json["p99"] = percentile(values, 0.99);
+		json["max"] = values.empty() ? 0.0 : *std::max_element(values.begin(), values.end());
+		return json;
+	};
+
+	size_t predicted = truePositives + falsePositives;
+	size_t actual = truePositives + falseNegatives;
+
+	ofJson summary;
+	summary["source"] = options.source;
+	summary["frames"] = timings.size();
+	summary["ocr_runs"] = ocrRuns;
+	summary["ocr_engines"] = ocrPool.size();
+	summary["cache_hits"] = pageCache.getHits();
+	summary["seconds"] = seconds;
+	summary["fps"] = seconds > 0 ? timings.size() / seconds : 0.0;
+	summary["ms"]["detect"] = stage(&FrameTiming::detect, true);
+	summary["ms"]["preprocess"] = stage(&FrameTiming::preprocess, true);
+	summary["ms"]["ocr"] = stage(&FrameTiming::ocr, true);
+	summary["ms"]["match"] = stage(&FrameTiming::match, true);
+	summary["ms"]["total"] = stage(&FrameTiming::total, false);
+	summary["frames_scored"] = truePositives + falsePositives + falseNegatives + trueNegatives;
+	summary["precision"] = predicted > 0 ? double(truePositives) / predicted : 0.0;
+	summary["recall"] = actual > 0 ? double(truePositives) / actual : 0.0;
+	summary["keyword_recall"] = expectedKeywords > 0 ? double(foundKeywords) / expectedKeywords : 0.0;
+
+	string summaryPath = ofFilePath::removeExt(options.outputPath) + "_summary.json";
+	ofSavePrettyJson(ofFilePath::getAbsolutePath(summaryPath, false), summary);
+	ofLogNotice("ReplayApp") << "Replay finished:\n" << summary.dump(2);
+}
+
+//--------------------------------------------------------------
+void ReplayApp::exit() {
+	ocrPool.stop();
+}
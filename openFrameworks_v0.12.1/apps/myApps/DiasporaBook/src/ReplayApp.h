@@ -0,0 +1,104 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxCv.h"
+#include "TesseractPool.h"
+#include "TextRegionDetector.h"
+#include "FramePreprocessor.h"
+#include "KeywordMatcher.h"
+#include "PageStabilityGate.h"
+#include "PageCache.h"
+
+// Headless replay of the recognition pipeline for benchmarking.
+//
+// Feeds frames from a recorded video or an image directory through the same
+// region detection -> preprocessing -> Tesseract -> keyword matching chain
+// the installation uses, synchronously and without a window, and writes
+// per-frame timings plus keyword hit/miss against a ground-truth file.
+//
+// Run as: DiasporaBook --replay <video|dir> [--truth labels.csv] [--out timings.csv]
+//         [--stride N] [--gate] [--no-roi] [--paragraphs] [--scale S]
+//         [--mser-downscale S] [--max-frames N] [--keywords a,b,c] [--engines N]
+//
+// The ground-truth file has one "<frame>,<keyword;keyword...>" line per
+// labeled frame, where <frame> is the frame index for videos or the file
+// name for image directories. An empty keyword list marks a frame that
+// must not trigger; unlisted frames are timed but not scored.
+class ReplayApp : public ofBaseApp {
+public:
+	struct Options {
+		string source;
+		string truthPath;
+		string outputPath = "replay_timings.csv";
+		int stride = 1; // OCR every Nth frame when not gated
+		bool gate = false; // use the page stability gate and cache instead
+		bool roi = true;
+		bool paragraphs = false;
+		float mserDownscale = 0.5;
+		int maxFrames = 0;
+		int engines = 0; // OCR engines, 0 for one per core
+		vector<string> keywords; // defaults to the installation's list
+		FramePreprocessor::Settings preprocess;
+	};
+
+	// Returns false, after logging why, on an argument that doesn't belong
+	// to a replay run or lacks its value
+	static bool parseArguments(int argc, char* argv[], Options& options);
+	// Frame label -> expected keywords, lowercased
+	static map<string, vector<string>> loadGroundTruth(const string& path);
+
+	ReplayApp(const Options& options);
+
+	void setup();
+	void update();
+	void exit();
+
+private:
+	struct FrameTiming {
+		double detect = 0;
+		double preprocess = 0;
+		double ocr = 0;
+		double match = 0;
+		double total = 0;
+	};
+
+	bool openSource();
+	bool nextFrame();
+	void processFrame();
+	void scoreFrame(const vector<string>& expected);
+	void writeSummary();
+
+	Options options;
+
+	// Frame source
+	ofVideoPlayer video;
+	ofDirectory images;
+	bool fromVideo;
+	size_t frameIndex;
+	string frameLabel;
+	ofPixels frame;
+
+	// Pipeline, the same stages the installation runs
+	TesseractPool ocrPool;
+	TextRegionDetector regionDetector;
+	TextRegionResult regionResult;
+	FramePreprocessor preprocessor;
+	KeywordMatcher keywordMatcher;
+	OCRWords words;
+	PageStabilityGate pageGate;
+	PageCache pageCache;
+	vector<cv::Rect> ocrRegions;
+	ofPixels processedFrame;
+	vector<cv::Rect> scaledRegions;
+	vector<string> pageKeywords; // hits for the page in view, carried while it is still
+
+	// Results
+	map<string, vector<string>> groundTruth;
+	ofFile output;
+	vector<FrameTiming> timings;
+	size_t ocrRuns;
+	size_t truePositives, falsePositives, falseNegatives, trueNegatives;
+	size_t expectedKeywords, foundKeywords;
+	uint64_t startMicros;
+	bool finished;
+};
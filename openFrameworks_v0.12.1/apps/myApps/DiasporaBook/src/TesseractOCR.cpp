@@ -0,0 +1,198 @@
+#include "TesseractOCR.h"
+#include <tesseract/baseapi.h>
+#include <leptonica/allheaders.h>
+
+//--------------------------------------------------------------
+static tesseract::PageSegMode toPageSegMode(TesseractOCR::SegmentationMode mode) {
+	switch (mode) {
+		case TesseractOCR::SEGMENT_SINGLE_LINE:
+			return tesseract::PSM_SINGLE_LINE;
+		case TesseractOCR::SEGMENT_SINGLE_BLOCK:
+			return tesseract::PSM_SINGLE_BLOCK;
+		default:
+			return tesseract::PSM_AUTO;
+	}
+}
+
+//--------------------------------------------------------------
+TesseractOCR::TesseractOCR() : tesseractAPI(nullptr), initialized(false), engineMode(ENGINE_LSTM) {
+	configString = "-c tessedit_char_whitelist=ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz --psm 6";
+}
+
+//--------------------------------------------------------------
+TesseractOCR::~TesseractOCR() {
+	cleanup();
+}
+
+//--------------------------------------------------------------
+bool TesseractOCR::initialize(EngineMode mode) {
+	cleanup();
+	tesseract::TessBaseAPI* api = new tesseract::TessBaseAPI();
+	
+	tesseract::OcrEngineMode oem = tesseract::OEM_LSTM_ONLY;
+	if (mode == ENGINE_LEGACY) {
+		oem = tesseract::OEM_TESSERACT_ONLY;
+	} else if (mode == ENGINE_COMBINED) {
+		oem = tesseract::OEM_TESSERACT_LSTM_COMBINED;
+	}
+	
+	if (api->Init(NULL, "eng", oem)) {
+		ofLogError() << "Could not initialize Tesseract";
+		delete api;
+		return false;
+	}
+	
+	api->SetPageSegMode(tesseract::PSM_AUTO);
+	tesseractAPI = static_cast<void*>(api);
+	initialized = true;
+	engineMode = mode;
+	
+	return true;
+}
+
+//--------------------------------------------------------------
+TesseractOCR::EngineMode TesseractOCR::getEngineMode() const {
+	return engineMode;
+}
+
+//--------------------------------------------------------------
+string TesseractOCR::recognizeText(const cv::Mat& image, SegmentationMode mode) {
+	if (!initialized || !tesseractAPI) {
+		return "";
+	}
+	
+	tesseract::TessBaseAPI* api = static_cast<tesseract::TessBaseAPI*>(tesseractAPI);
+	
+	api->SetPageSegMode(toPageSegMode(mode));
+	api->SetImage(image.data, image.cols, image.rows, image.channels(), image.step);
+	
+	char* result = api->GetUTF8Text();
+	string textResult = "";
+	
+	if (result) {
+		textResult = string(result);
+		delete[] result;
+	}
+	
+	api->SetPageSegMode(tesseract::PSM_AUTO);
+	
+	return textResult;
+}
+
+//--------------------------------------------------------------
+string TesseractOCR::recognizeRegions(const cv::Mat& image, const vector<cv::Rect>& regions, SegmentationMode mode) {
+	if (!initialized || !tesseractAPI) {
+		return "";
+	}
+	
+	tesseract::TessBaseAPI* api = static_cast<tesseract::TessBaseAPI*>(tesseractAPI);
+	
+	api->SetPageSegMode(toPageSegMode(mode));
+	
+	// The image is only set once, each rectangle is then recognized on its own
+	api->SetImage(image.data, image.cols, image.rows, image.channels(), image.step);
+	
+	string textResult = "";
+	for (const auto& region : regions) {
+		api->SetRectangle(region.x, region.y, region.width, region.height);
+		
+		char* result = api->GetUTF8Text();
+		if (result) {
+			if (!textResult.empty()) {
+				textResult += "\n";
+			}
+			textResult += result;
+			delete[] result;
+		}
+	}
+	
+	api->SetPageSegMode(tesseract::PSM_AUTO);
+	
+	return textResult;
+}
+
+//--------------------------------------------------------------
+void TesseractOCR::recognizeWords(const cv::Mat& image, OCRWords& result, SegmentationMode mode, cv::Point origin, uint32_t region) {
+	if (!initialized || !tesseractAPI) {
+		return;
+	}
+	
+	tesseract::TessBaseAPI* api = static_cast<tesseract::TessBaseAPI*>(tesseractAPI);
+	
+	api->SetPageSegMode(toPageSegMode(mode));
+	api->SetImage(image.data, image.cols, image.rows, image.channels(), image.step);
+	readWords(result, origin, region);
+	api->SetPageSegMode(tesseract::PSM_AUTO);
+}
+
+//--------------------------------------------------------------
+void TesseractOCR::recognizeRegions(const cv::Mat& image, const vector<cv::Rect>& regions, SegmentationMode mode, OCRWords& result) {
+	if (!initialized || !tesseractAPI) {
+		return;
+	}
+	
+	tesseract::TessBaseAPI* api = static_cast<tesseract::TessBaseAPI*>(tesseractAPI);
+	
+	api->SetPageSegMode(toPageSegMode(mode));
+	api->SetImage(image.data, image.cols, image.rows, image.channels(), image.step);
+	
+	// Boxes come back in whole image coordinates, rectangle or not
+	for (size_t i = 0; i < regions.size(); i++) {
+		const cv::Rect& region = regions[i];
+		api->SetRectangle(region.x, region.y, region.width, region.height);
+		readWords(result, cv::Point(), i);
+	}
+	
+	api->SetPageSegMode(tesseract::PSM_AUTO);
+}
+
+//--------------------------------------------------------------
+void TesseractOCR::readWords(OCRWords& result, cv::Point origin, uint32_t region) {
+	tesseract::TessBaseAPI* api = static_cast<tesseract::TessBaseAPI*>(tesseractAPI);
+	if (api->Recognize(nullptr) != 0) {
+		return;
+	}
+	
+	tesseract::ResultIterator* it = api->GetIterator();
+	if (!it) {
+		return;
+	}
+	
+	int left, top, right, bottom;
+	if (!it->Empty(tesseract::RIL_WORD)) {
+		do {
+			if (it->IsAtBeginningOf(tesseract::RIL_TEXTLINE) &&
+				it->BoundingBox(tesseract::RIL_TEXTLINE, &left, &top, &right, &bottom)) {
+				result.beginLine(cv::Rect(left + origin.x, top + origin.y, right - left, bottom - top), region);
+			}
+			
+			char* word = it->GetUTF8Text(tesseract::RIL_WORD);
+			if (word) {
+				it->BoundingBox(tesseract::RIL_WORD, &left, &top, &right, &bottom);
+				result.addWord(word, cv::Rect(left + origin.x, top + origin.y, right - left, bottom - top),
+							   it->Confidence(tesseract::RIL_WORD));
+				delete[] word;
+			}
+		} while (it->Next(tesseract::RIL_WORD));
+	}
+	delete it;
+}
+
+//--------------------------------------------------------------
+void TesseractOCR::cleanup() {
+	if (tesseractAPI) {
+		tesseract::TessBaseAPI* api = static_cast<tesseract::TessBaseAPI*>(tesseractAPI);
+		api->End();
+		delete api;
+		tesseractAPI = nullptr;
+	}
+	initialized = false;
+}
+
+//--------------------------------------------------------------
+void TesseractOCR::swap(TesseractOCR& other) {
+	std::swap(tesseractAPI, other.tesseractAPI);
+	std::swap(initialized, other.initialized);
+	std::swap(engineMode, other.engineMode);
+	std::swap(configString, other.configString);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxCv.h"
+#include "OCRWords.h"
+
+// Thin wrapper around a single TessBaseAPI instance.
+// Not thread safe: one instance must only be used from one thread at a time.
+class TesseractOCR {
+public:
+	// Mirrors the subset of tesseract::PageSegMode the app uses
+	enum SegmentationMode {
+		SEGMENT_AUTO,
+		SEGMENT_SINGLE_BLOCK,
+		SEGMENT_SINGLE_LINE
+	};
+	
+	// Mirrors tesseract::OcrEngineMode; the legacy engines need
+	// traineddata that still includes the legacy model
+	enum EngineMode {
+		ENGINE_LSTM,
+		ENGINE_LEGACY,
+		ENGINE_COMBINED
+	};
+	
+	TesseractOCR();
+	~TesseractOCR();
+	
+	bool initialize(EngineMode mode = ENGINE_LSTM);
+	EngineMode getEngineMode() const;
+	// The image may be a view into a larger one, only its pixels are copied
+	string recognizeText(const cv::Mat& image, SegmentationMode mode = SEGMENT_AUTO);
+	// Recognizes only the given rectangles of the image, one unit each,
+	// and returns their text joined by newlines in the order given.
+	string recognizeRegions(const cv::Mat& image, const vector<cv::Rect>& regions, SegmentationMode mode);
+	
+	// Word-level versions of the above, appending to result. Boxes are
+	// offset by origin, e.g. where a cropped image came from; lines are
+	// tagged with region, or with the index of the rectangle they were in.
+	void recognizeWords(const cv::Mat& image, OCRWords& result, SegmentationMode mode = SEGMENT_AUTO,
+						cv::Point origin = cv::Point(), uint32_t region = 0);
+	void recognizeRegions(const cv::Mat& image, const vector<cv::Rect>& regions, SegmentationMode mode, OCRWords& result);
+	void cleanup();
+	// Exchanges the engines, so a new one can be made ready before it
+	// replaces this one
+	void swap(TesseractOCR& other);
+	
+private:
+	// Walks the last recognition result word by word
+	void readWords(OCRWords& result, cv::Point origin, uint32_t region);
+	
+
+	void* tesseractAPI; // Will hold TessBaseAPI*
+	bool initialized;
+	EngineMode engineMode;
+	string configString;
+};
@@ -0,0 +1,238 @@
+#include "TesseractPool.h"
+
+//--------------------------------------------------------------
+TesseractPool::Engine::Engine(TesseractPool& owner)
+	: pool(owner) {
+}
+
+//--------------------------------------------------------------
+void TesseractPool::Engine::threadedFunction() {
+	uint64_t generation = 0;
+	while (pool.waitForBatch(generation)) {
+		pool.runBatch(ocr);
+	}
+}
+
+//--------------------------------------------------------------
+TesseractPool::TesseractPool()
+	: engineMode(TesseractOCR::ENGINE_LSTM)
+	, requestedEngineMode(TesseractOCR::ENGINE_LSTM)
+	, generation(0)
+	, stopping(false)
+	, activeEngines(0)
+	, pendingTasks(0)
+	, batchMode(TesseractOCR::SEGMENT_AUTO)
+	, nextTask(0) {
+}
+
+//--------------------------------------------------------------
+TesseractPool::~TesseractPool() {
+	stop();
+}
+
+//--------------------------------------------------------------
+bool TesseractPool::setup(size_t engineCount, TesseractOCR::EngineMode mode) {
+	stop();
+	stopping = false;
+	engineMode = mode;
+	requestedEngineMode = mode;
+
+	if (engineCount == 0) {
+		engineCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// Engines are initialized one after the other, loading the language
+	// model is not something to do concurrently
+	for (size_t i = 0; i < engineCount; i++) {
+		auto engine = std::make_unique<Engine>(*this);
+		if (!engine->ocr.initialize(mode)) {
+			break;
+		}
+		engine->setThreadName("Tesseract " + ofToString(i));
+		engine->startThread();
+		engines.push_back(std::move(engine));
+	}
+
+	ofLogNotice("TesseractPool") << engines.size() << " of " << engineCount << " OCR engines ready";
+	return !engines.empty();
+}
+
+//--------------------------------------------------------------
+void TesseractPool::stop() {
+	{
+		std::unique_lock<std::mutex> lock(batchMutex);
+		stopping = true;
+	}
+	batchStarted.notify_all();
+
+	for (auto& engine : engines) {
+		engine->waitForThread(true);
+		engine->ocr.cleanup();
+	}
+	engines.clear();
+}
+
+//--------------------------------------------------------------
+size_t TesseractPool::size() const {
+	return engines.size();
+}
+
+//--------------------------------------------------------------
+void TesseractPool::setEngineMode(TesseractOCR::EngineMode mode) {
+	requestedEngineMode = mode;
+}
+
+//--------------------------------------------------------------
+TesseractOCR::EngineMode TesseractPool::getEngineMode() const {
+	return TesseractOCR::EngineMode(requestedEngineMode.load());
+}
+
+//--------------------------------------------------------------
+void TesseractPool::applyEngineMode() {
+	// Called with every engine idle, waiting for a batch
+	TesseractOCR::EngineMode mode = TesseractOCR::EngineMode(requestedEngineMode.load());
+	if (mode == engineMode) {
+		return;
+	}
+	// Every engine is loaded in the new mode before any is replaced, so a
+	// failure halfway leaves the whole pool in the mode it was in
+	vector<TesseractOCR> fresh(engines.size());
+	for (auto& ocr : fresh) {
+		if (!ocr.initialize(mode)) {
+			ofLogWarning("TesseractPool") << "Engine mode " << mode << " not available, staying on " << engineMode;
+			requestedEngineMode = engineMode;
+			return;
+		}
+	}
+	for (size_t i = 0; i < engines.size(); i++) {
+		engines[i]->ocr.swap(fresh[i]);
+	}
+	engineMode = mode;
+	// fresh now holds the old engines, cleaned up when it goes out of scope
+}
+
+//--------------------------------------------------------------
+string TesseractPool::recognize(const cv::Mat& image, const vector<cv::Rect>& regions, TesseractOCR::SegmentationMode mode,
+								TesseractOCR::SegmentationMode pageMode) {
+	OCRWords words;
+	recognize(image, regions, mode, pageMode, words);
+	return words.text;
+}
+
+//--------------------------------------------------------------
+void TesseractPool::recognize(const cv::Mat& image, const vector<cv::Rect>& regions, TesseractOCR::SegmentationMode mode,
+							  TesseractOCR::SegmentationMode pageMode, OCRWords& result) {
+	result.clear();
+	if (engines.empty() || image.empty()) {
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(batchMutex);
+	// An engine that woke up late for the last batch may still be looking at it
+	batchFinished.wait(lock, [&] { return activeEngines == 0; });
+	applyEngineMode();
+
+	tasks.clear();
+	if (regions.empty()) {
+		for (const auto& band : splitIntoBands(image, engines.size())) {
+			tasks.push_back({band, tasks.size()});
+		}
+		batchMode = pageMode;
+	} else {
+		cv::Rect bounds(0, 0, image.cols, image.rows);
+		for (const auto& region : regions) {
+			tasks.push_back({region & bounds, tasks.size()});
+		}
+		batchMode = mode;
+	}
+
+	// Largest first, so one long line doesn't end up last on an engine
+	std::sort(tasks.begin(), tasks.end(), [](const Task& a, const Task& b) {
+		return a.rect.area() > b.rect.area();
+	});
+
+	if (results.size() < tasks.size()) {
+		results.resize(tasks.size());
+	}
+	for (size_t i = 0; i < tasks.size(); i++) {
+		results[i].clear();
+	}
+	batchImage = image;
+	pendingTasks = tasks.size();
+	nextTask = 0;
+	generation++;
+	batchStarted.notify_all();
+
+	batchFinished.wait(lock, [&] { return pendingTasks == 0 || stopping; });
+	batchImage = cv::Mat();
+
+	for (size_t i = 0; i < tasks.size(); i++) {
+		result.append(results[i], i);
+	}
+}
+
+//--------------------------------------------------------------
+bool TesseractPool::waitForBatch(uint64_t& seenGeneration) {
+	std::unique_lock<std::mutex> lock(batchMutex);
+	batchStarted.wait(lock, [&] { return stopping || generation != seenGeneration; });
+	if (stopping) {
+		return false;
+	}
+	seenGeneration = generation;
+	activeEngines++;
+	return true;
+}
+
+//--------------------------------------------------------------
+void TesseractPool::runBatch(TesseractOCR& ocr) {
+	size_t done = 0;
+	for (size_t i = nextTask++; i < tasks.size(); i = nextTask++) {
+		const Task& task = tasks[i];
+		if (task.rect.area() > 0) {
+			// Boxes in page coordinates, not the crop's
+			ocr.recognizeWords(batchImage(task.rect), results[task.index], batchMode, task.rect.tl(), task.index);
+		}
+		done++;
+	}
+
+	std::unique_lock<std::mutex> lock(batchMutex);
+	activeEngines--;
+	pendingTasks -= done;
+	if (pendingTasks == 0 || activeEngines == 0) {
+		batchFinished.notify_all();
+	}
+}
+
+//--------------------------------------------------------------
+vector<cv::Rect> TesseractPool::splitIntoBands(const cv::Mat& image, size_t bandCount) {
+	// Bands much shorter than a few lines of text are not worth it
+	bandCount = std::max<size_t>(1, std::min<size_t>(bandCount, image.rows / 96));
+	if (bandCount == 1 || image.channels() != 1) {
+		return {cv::Rect(0, 0, image.cols, image.rows)};
+	}
+
+	// Brightness per row; on the binarized page the brightest rows are the
+	// gaps between lines
+	cv::Mat rowSums;
+	cv::reduce(image, rowSums, 1, cv::REDUCE_SUM, CV_32S);
+
+	vector<cv::Rect> bands;
+	int top = 0;
+	int window = image.rows / int(bandCount * 4);
+	for (size_t i = 1; i < bandCount; i++) {
+		int target = int(image.rows * i / bandCount);
+		int cut = target;
+		int brightest = -1;
+		for (int y = std::max(top + 1, target - window); y < std::min(image.rows - 1, target + window); y++) {
+			int sum = rowSums.at<int>(y, 0);
+			if (sum > brightest) {
+				brightest = sum;
+				cut = y;
+			}
+		}
+		bands.push_back(cv::Rect(0, top, image.cols, cut - top));
+		top = cut;
+	}
+	bands.push_back(cv::Rect(0, top, image.cols, image.rows - top));
+	return bands;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxCv.h"
+#include "TesseractOCR.h"
+
+#include <condition_variable>
+
+// A fixed set of Tesseract engines, each initialized once and owned by its
+// own thread, that recognize the parts of one page in parallel.
+//
+// recognize() hands out region crops (or horizontal page bands) largest
+// first to whichever engine is free, then joins the text back together in
+// the order the parts were given, so a page costs roughly its slowest line
+// instead of the sum of all of them.
+class TesseractPool {
+public:
+	TesseractPool();
+	~TesseractPool();
+
+	// Starts one engine per hardware thread when engineCount is 0.
+	// Returns false if no engine could be initialized.
+	bool setup(size_t engineCount = 0, TesseractOCR::EngineMode mode = TesseractOCR::ENGINE_LSTM);
+	void stop();
+
+	size_t size() const;
+
+	// Takes effect at the start of the next recognize(), on the thread
+	// calling it, since every engine has to load its model again
+	void setEngineMode(TesseractOCR::EngineMode mode);
+	TesseractOCR::EngineMode getEngineMode() const;
+
+	// Blocks until every region is recognized and fills result with their
+	// words, in the order given, boxes in image coordinates. Without
+	// regions the page is cut into one band per engine at the gaps between
+	// lines, read with pageMode. Only one thread may call this at a time.
+	void recognize(const cv::Mat& image, const vector<cv::Rect>& regions, TesseractOCR::SegmentationMode mode,
+				   TesseractOCR::SegmentationMode pageMode, OCRWords& result);
+	// Just the text, lines joined by newlines
+	string recognize(const cv::Mat& image, const vector<cv::Rect>& regions, TesseractOCR::SegmentationMode mode,
+					 TesseractOCR::SegmentationMode pageMode = TesseractOCR::SEGMENT_AUTO);
+
+	// Splits a binarized page into horizontal bands, cutting at the
+	// emptiest rows near evenly spaced positions
+	static vector<cv::Rect> splitIntoBands(const cv::Mat& image, size_t bandCount);
+
+private:
+	class Engine : public ofThread {
+	public:
+		Engine(TesseractPool& pool);
+
+		TesseractOCR ocr;
+
+	protected:
+		void threadedFunction() override;
+
+	private:
+		TesseractPool& pool;
+	};
+
+	struct Task {
+		cv::Rect rect;
+		size_t index; // where the words go in the result
+	};
+
+	bool waitForBatch(uint64_t& generation);
+	void runBatch(TesseractOCR& ocr);
+	void applyEngineMode();
+
+	vector<std::unique_ptr<Engine>> engines;
+	TesseractOCR::EngineMode engineMode;
+	std::atomic<int> requestedEngineMode;
+
+	// The batch in progress, written only while no engine is working on it
+	std::mutex batchMutex;
+	std::condition_variable batchStarted;
+	std::condition_variable batchFinished;
+	uint64_t generation;
+	bool stopping;
+	size_t activeEngines;
+	size_t pendingTasks;
+	cv::Mat batchImage;
+	TesseractOCR::SegmentationMode batchMode;
+	vector<Task> tasks;
+	vector<OCRWords> results; // reused, so their buffers are too
+	std::atomic<size_t> nextTask;
+};
@@ -0,0 +1,206 @@
+#include "TextRegionDetector.h"
+
+//--------------------------------------------------------------
+TextRegionDetector::TextRegionDetector()
+	: latency(nullptr)
+	, mserScale(0)
+	, downscale(0.5f)
+	, resultChannel(1, OF_CHANNEL_OVERFLOW_KEEP_LATEST) {
+}
+
+//--------------------------------------------------------------
+TextRegionDetector::~TextRegionDetector() {
+	stop();
+}
+
+//--------------------------------------------------------------
+void TextRegionDetector::setup() {
+	mailbox.reopen();
+	setThreadName("TextRegionDetector");
+	startThread();
+}
+
+//--------------------------------------------------------------
+void TextRegionDetector::stop() {
+	mailbox.close();
+	
+	if (isThreadRunning()) {
+		waitForThread(true);
+	}
+	resultChannel.close();
+}
+
+//--------------------------------------------------------------
+void TextRegionDetector::setDownscale(float scale) {
+	downscale = ofClamp(scale, 0.1f, 1.0f);
+}
+
+//--------------------------------------------------------------
+void TextRegionDetector::setLatencyStats(LatencyStats* stats) {
+	latency = stats;
+}
+
+//--------------------------------------------------------------
+void TextRegionDetector::submit(uint64_t frameId, const ofPixels& frame) {
+	// pendingFrame holds whatever buffer the mailbox handed back last
+	// time, so in steady state this copy doesn't allocate
+	pendingFrame.id = frameId;
+	pendingFrame.pixels = frame;
+	mailbox.send(pendingFrame);
+}
+
+//--------------------------------------------------------------
+bool TextRegionDetector::tryReceiveLatest(TextRegionResult& result) {
+	// The channel only ever holds the newest result
+	return resultChannel.tryReceive(result);
+}
+
+//--------------------------------------------------------------
+uint64_t TextRegionDetector::getDroppedFrames() const {
+	return mailbox.getDropped();
+}
+
+//--------------------------------------------------------------
+void TextRegionDetector::threadedFunction() {
+	Frame frame;
+	
+	while (isThreadRunning() && mailbox.receive(frame)) {
+		TextRegionResult result;
+		uint64_t start = ofGetElapsedTimeMicros();
+		detect(frame.id, frame.pixels, result);
+		if (latency) {
+			latency->record(LatencyStats::STAGE_DETECT, ofGetElapsedTimeMicros() - start);
+		}
+		resultChannel.send(std::move(result));
+	}
+}
+
+//--------------------------------------------------------------
+void TextRegionDetector::detect(uint64_t frameId, const ofPixels& frame, TextRegionResult& result) {
+	result.frameId = frameId;
+	result.regions.clear();
+	if (!frame.isAllocated()) {
+		return;
+	}
+	
+	float scale = downscale;
+	
+	// The detector is kept between frames, only its area limits follow
+	// the working resolution (defaults are for full resolution)
+	if (!mser || scale != mserScale) {
+		float areaScale = scale * scale;
+		mser = cv::MSER::create(5, std::max(4, int(60 * areaScale)), std::max(16, int(14400 * areaScale)));
+		mserScale = scale;
+	}
+	
+	cv::Mat mat = ofxCv::toCv(frame);
+	cv::Mat input = mat;
+	if (mat.channels() == 4) {
+		cv::cvtColor(mat, grayMat, cv::COLOR_RGBA2GRAY);
+		input = grayMat;
+	} else if (mat.channels() == 3) {
+		cv::cvtColor(mat, grayMat, cv::COLOR_RGB2GRAY);
+		input = grayMat;
+	}
+	
+	if (scale < 1.0f) {
+		cv::resize(input, smallMat, cv::Size(), scale, scale, cv::INTER_AREA);
+		input = smallMat;
+	}
+	
+	mser->detectRegions(input, regionPoints, boxes);
+	
+	// Filter regions by size (likely to contain text), in full resolution units
+	float inv = 1.0f / scale;
+	for (const auto& bbox : boxes) {
+		cv::Rect full(cvRound(bbox.x * inv), cvRound(bbox.y * inv),
+					  cvRound(bbox.width * inv), cvRound(bbox.height * inv));
+		if (full.width > 20 && full.width < 300 &&
+			full.height > 10 && full.height < 100) {
+			result.regions.push_back(full);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+vector<cv::Rect> TextRegionDetector::mergeRegions(const vector<cv::Rect>& regions, cv::Size frameSize, bool paragraphs) {
+	// MSER mostly returns one box per glyph (plus nested duplicates), so
+	// first chain boxes left to right into lines of similar height
+	vector<cv::Rect> sorted = regions;
+	std::sort(sorted.begin(), sorted.end(), [](const cv::Rect& a, const cv::Rect& b) {
+		return a.x < b.x;
+	});
+	
+	vector<cv::Rect> lines;
+	for (const auto& box : sorted) {
+		bool merged = false;
+		for (auto& line : lines) {
+			int overlapY = std::min(line.br().y, box.br().y) - std::max(line.y, box.y);
+			int gapX = box.x - line.br().x;
+			int height = std::max(line.height, box.height);
+			if (overlapY > 0.5 * std::min(line.height, box.height) && gapX < height * 1.5) {
+				line |= box;
+				merged = true;
+				break;
+			}
+		}
+		if (!merged) {
+			lines.push_back(box);
+		}
+	}
+	
+	// Lines that ended up overlapping each other describe the same text
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (size_t i = 0; i < lines.size() && !changed; i++) {
+			for (size_t j = i + 1; j < lines.size(); j++) {
+				if ((lines[i] & lines[j]).area() > 0) {
+					lines[i] |= lines[j];
+					lines.erase(lines.begin() + j);
+					changed = true;
+					break;
+				}
+			}
+		}
+	}
+	
+	if (paragraphs) {
+		// Stack vertically adjacent, horizontally overlapping lines into blocks
+		std::sort(lines.begin(), lines.end(), [](const cv::Rect& a, const cv::Rect& b) {
+			return a.y < b.y;
+		});
+		vector<cv::Rect> blocks;
+		for (const auto& line : lines) {
+			bool merged = false;
+			for (auto& block : blocks) {
+				int overlapX = std::min(block.br().x, line.br().x) - std::max(block.x, line.x);
+				int gapY = line.y - block.br().y;
+				if (overlapX > 0 && gapY < line.height) {
+					block |= line;
+					merged = true;
+					break;
+				}
+			}
+			if (!merged) {
+				blocks.push_back(line);
+			}
+		}
+		lines = blocks;
+	}
+	
+	// Pad so glyph edges are not clipped, and keep reading order
+	cv::Rect frameRect(0, 0, frameSize.width, frameSize.height);
+	vector<cv::Rect> result;
+	for (const auto& line : lines) {
+		if (line.width < 20 || line.height < 10) continue;
+		int pad = std::max(4, line.height / 4);
+		cv::Rect padded(line.x - pad, line.y - pad, line.width + pad * 2, line.height + pad * 2);
+		result.push_back(padded & frameRect);
+	}
+	std::sort(result.begin(), result.end(), [](const cv::Rect& a, const cv::Rect& b) {
+		return a.y < b.y || (a.y == b.y && a.x < b.x);
+	});
+	
+	return result;
+}
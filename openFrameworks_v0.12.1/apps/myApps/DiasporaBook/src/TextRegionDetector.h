@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ofMain.h"
+#include "ofxCv.h"
+#include "LatestMailbox.h"
+#include "LatencyStats.h"
+
+struct TextRegionResult {
+	uint64_t frameId = 0;
+	// In full camera resolution coordinates
+	vector<cv::Rect> regions;
+};
+
+// Runs MSER text-region detection on its own thread at reduced resolution,
+// so candidate boxes never cost the render thread anything but a copy.
+class TextRegionDetector : public ofThread {
+public:
+	TextRegionDetector();
+	~TextRegionDetector();
+	
+	void setup();
+	void stop();
+	
+	// Resolution MSER runs at, relative to the submitted frame
+	void setDownscale(float downscale);
+	
+	// Detection time on the detector thread is recorded here
+	void setLatencyStats(LatencyStats* stats);
+	
+	void submit(uint64_t frameId, const ofPixels& frame);
+	// Drains published results, keeping only the newest one
+	bool tryReceiveLatest(TextRegionResult& result);
+	
+	uint64_t getDroppedFrames() const;
+	
+	// Runs detection synchronously on the calling thread. Only safe while
+	// the detector thread is not running, e.g. for offline replay.
+	void detect(uint64_t frameId, const ofPixels& frame, TextRegionResult& result);
+	
+	// Chains per-glyph boxes into padded line boxes (or paragraph blocks),
+	// clipped to the frame and sorted in reading order.
+	static vector<cv::Rect> mergeRegions(const vector<cv::Rect>& regions, cv::Size frameSize, bool paragraphs);
+	
+protected:
+	void threadedFunction() override;
+	
+private:
+	struct Frame {
+		uint64_t id = 0;
+		ofPixels pixels;
+	};
+	
+	LatencyStats* latency;
+	cv::Ptr<cv::MSER> mser;
+	float mserScale;
+	std::atomic<float> downscale;
+	cv::Mat grayMat;
+	cv::Mat smallMat;
+	vector<vector<cv::Point>> regionPoints;
+	vector<cv::Rect> boxes;
+	
+	Frame pendingFrame;
+	LatestMailbox<Frame> mailbox;
+	ofThreadChannel<TextRegionResult> resultChannel;
+};
@@ -1,13 +1,90 @@
 #include "ofMain.h"
 #include "ofApp.h"
+#include "ofAppNoWindow.h"
+#include "ReplayApp.h"
+#include "ParameterTuner.h"
+#include "RecognitionNode.h"
 
 //========================================================================
-int main( ){
-	// Setup window size for your project
-	ofSetupOpenGL(1024, 768, OF_WINDOW);
-	
-	// Create and run the application
-	ofRunApp(new ofApp());
+// Each mode has its own options, so the command line goes only to the
+// parser of the mode it asks for, which then knows every valid flag
+enum class Mode {
+	Interactive,
+	Replay,
+	Tune,
+	Recognize
+};
+
+static Mode findMode(int argc, char* argv[]) {
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		if (arg == "--replay") {
+			return Mode::Replay;
+		} else if (arg == "--tune") {
+			return Mode::Tune;
+		} else if (arg == "--recognize") {
+			return Mode::Recognize;
+		}
+	}
+	return Mode::Interactive;
+}
+
+//========================================================================
+int main(int argc, char* argv[]){
+	// The OCR, camera and detector threads log; keep the console off their path
+	ofSetLoggerChannel(std::make_shared<ofAsyncLoggerChannel>(ofGetLoggerChannel()));
 	
+	switch (findMode(argc, argv)) {
+		// Headless benchmark run: DiasporaBook --replay <video|dir> ...
+		case Mode::Replay: {
+			ReplayApp::Options options;
+			if (!ReplayApp::parseArguments(argc, argv, options)) {
+				return 1;
+			}
+			auto window = std::make_shared<ofAppNoWindow>();
+			ofSetupOpenGL(window, 1024, 768, OF_WINDOW);
+			ofRunApp(window, std::make_shared<ReplayApp>(options));
+			return ofRunMainLoop();
+		}
+		
+		// Offline settings search: DiasporaBook --tune <dir> --truth labels.csv ...
+		case Mode::Tune: {
+			ParameterTuner::Options options;
+			if (!ParameterTuner::parseArguments(argc, argv, options)) {
+				return 1;
+			}
+			auto window = std::make_shared<ofAppNoWindow>();
+			ofSetupOpenGL(window, 1024, 768, OF_WINDOW);
+			ofRunApp(window, std::make_shared<ParameterTuner>(options));
+			return ofRunMainLoop();
+		}
+		
+		// Headless recognition feeding a projection node: DiasporaBook --recognize ...
+		case Mode::Recognize: {
+			RecognitionNode::Options options;
+			if (!RecognitionNode::parseArguments(argc, argv, options)) {
+				return 1;
+			}
+			auto window = std::make_shared<ofAppNoWindow>();
+			ofSetupOpenGL(window, 1024, 768, OF_WINDOW);
+			ofRunApp(window, std::make_shared<RecognitionNode>(options));
+			return ofRunMainLoop();
+		}
+		
+		// Projection only with --project, otherwise everything in one process
+		case Mode::Interactive: {
+			ofApp::Options options;
+			if (!ofApp::parseArguments(argc, argv, options)) {
+				return 1;
+			}
+			
+			// Setup window size for your project
+			ofSetupOpenGL(1024, 768, OF_WINDOW);
+			
+			// Create and run the application
+			ofRunApp(new ofApp(options));
+			return 0;
+		}
+	}
 	return 0;
 }
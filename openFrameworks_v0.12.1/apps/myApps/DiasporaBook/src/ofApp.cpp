@@ -1,6 +1,40 @@
 #include "ofApp.h"
-#include <tesseract/baseapi.h>
-#include <leptonica/allheaders.h>
+
+//--------------------------------------------------------------
+bool ofApp::parseArguments(int argc, char* argv[], Options& options) {
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		
+		if (arg == "--project") {
+			options.projectionOnly = true;
+		} else if (arg == "--listen" && hasValue) {
+			options.listenPort = ofToInt(argv[++i]);
+		} else if (arg == "--recognizer" && hasValue) {
+			vector<string> address = ofSplitString(argv[++i], ":", true, true);
+			if (!address.empty()) {
+				options.recognitionHost = address[0];
+			}
+			if (address.size() > 1) {
+				options.recognitionPort = ofToInt(address[1]);
+			}
+		} else {
+			ofLogError("ofApp") << "Unknown argument or missing value: " << arg;
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+//--------------------------------------------------------------
+ofApp::ofApp() {
+}
+
+//--------------------------------------------------------------
+ofApp::ofApp(const Options& appOptions)
+	: options(appOptions) {
+}
 
 //--------------------------------------------------------------
 void ofApp::setup() {
@@ -11,25 +45,37 @@ void ofApp::setup() {
 	// Initialize variables
 	projectionActive = false;
 	videoLoaded = false;
-	processingFrame = false;
-	lastDetectionTime = 0;
-	detectionCooldown = 2.0; // seconds
 	showDebugInfo = true;
 	showProcessedImage = false;
-	ocrThreadRunning = false;
+	selectedStation = 0;
+	triggerStation = 0;
+	triggerMicros = 0;
+	awaitingFirstFrame = false;
+	awaitingLiveVideo = false;
+	lastTriggerToFrameMs = 0;
+	lastLatencyDump = 0;
 	
 	// Set video path
 	videoPath = "diaspora_video.mp4";
+	ocrProfilePath = "ocr_profile.json";
+	stationsPath = "stations.json";
 	
 	// Setup target keywords
-	targetKeywords = {"immigrants", "immigrant", "immigration", "migrant", "migrants", "diaspora"};
+	targetKeywords = getDefaultKeywords();
 	
 	// Setup components
-	setupCamera();
 	setupVideo();
-	setupOCR();
 	setupFallbackContent();
 	setupGUI();
+	if (options.projectionOnly) {
+		// Cameras and OCR run in the recognition node's process
+		triggerReceiver.setLatencyStats(&remoteLatency);
+		triggerReceiver.setup(options.listenPort, options.recognitionHost, options.recognitionPort);
+	} else {
+		setupOCR();
+		setupStations();
+		startOCRThread();
+	}
 	
 	ofLogNotice() << "=== Diaspora Book Interactive System ===";
 	ofLogNotice() << "Target keywords: immigrants, immigrant, immigration, migrant, migrants, diaspora";
@@ -38,20 +84,28 @@ void ofApp::setup() {
 }
 
 //--------------------------------------------------------------
-void ofApp::setupCamera() {
+vector<string> ofApp::getDefaultKeywords() {
+	return {"immigrants", "immigrant", "immigration", "migrant", "migrants", "diaspora"};
+}
+
+//--------------------------------------------------------------
+void ofApp::setupStations() {
 	cameraWidth = 1280;
 	cameraHeight = 720;
 	
-	camera.setVerbose(true);
-	camera.setDeviceID(0);
-	camera.setDesiredFrameRate(30);
-	camera.initGrabber(cameraWidth, cameraHeight);
+	// One entry per reading station in stations.json
+	for (const auto& config : ReadingStation::loadConfig(stationsPath)) {
+		stations.push_back(std::make_unique<ReadingStation>(stations.size(), config.name, config.deviceId));
+	}
 	
-	currentFrame.allocate(cameraWidth, cameraHeight, OF_IMAGE_COLOR);
-	processedFrame.allocate(cameraWidth, cameraHeight, OF_IMAGE_GRAYSCALE);
-	debugImage.allocate(cameraWidth, cameraHeight, OF_IMAGE_GRAYSCALE);
+	ReadingStation::Settings settings = getStationSettings();
+	for (auto& station : stations) {
+		station->setSettings(settings);
+		station->setup(cameraWidth, cameraHeight, &ocrWorker, targetKeywords);
+		ocrWorker.setLatencyStats(&station->getLatency(), station->getIndex());
+	}
 	
-	ofLogNotice() << "Camera initialized: " << cameraWidth << "x" << cameraHeight;
+	ofLogNotice() << "Reading stations: " << stations.size() << ", sharing " << ocrPool.size() << " OCR engines";
 }
 
 //--------------------------------------------------------------
@@ -59,11 +113,11 @@ void ofApp::setupVideo() {
 	projectionWidth = 800;
 	projectionHeight = 600;
 	
-	// Try to load video file
+	// Try to load video file, decoding its opening frames up front so a
+	// trigger can show them straight away
 	videoLoaded = diasporaVideo.load(videoPath);
 	
 	if (videoLoaded) {
-		diasporaVideo.setLoopState(OF_LOOP_NORMAL);
 		diasporaVideo.setVolume(1.0);
 		ofLogNotice() << "Video loaded successfully: " << videoPath;
 		ofLogNotice() << "Video duration: " << diasporaVideo.getDuration() << " seconds";
@@ -75,11 +129,10 @@ void ofApp::setupVideo() {
 
 //--------------------------------------------------------------
 void ofApp::setupOCR() {
-	ocrEngine = new TesseractOCR();
-	if (!ocrEngine->initialize()) {
+	if (!ocrPool.setup()) {
 		ofLogError() << "Failed to initialize OCR engine";
 	} else {
-		ofLogNotice() << "OCR engine initialized successfully";
+		ofLogNotice() << "OCR engines initialized successfully: " << ocrPool.size();
 	}
 }
 
@@ -112,47 +165,119 @@ void ofApp::setupFallbackContent() {
 
 //--------------------------------------------------------------
 void ofApp::setupGUI() {
-	gui.setup("OCR Controls");
+	// The panel's save button writes the same file the offline tuner does
+	gui.setup("OCR Controls", ocrProfilePath);
 	gui.add(scaleFactor.setup("Scale Factor", 2.0, 1.0, 4.0));
 	gui.add(adaptiveThreshBlockSize.setup("Thresh Block Size", 21, 3, 51));
 	gui.add(adaptiveThreshC.setup("Thresh C", 10, 2, 20));
 	gui.add(claheClipLimit.setup("CLAHE Clip Limit", 2.0, 1.0, 8.0));
+	gui.add(bilateralDiameter.setup("Bilateral Diameter", 9, 1, 15));
+	gui.add(bilateralSigma.setup("Bilateral Sigma", 75, 10, 150));
+	gui.add(pageSegMode.setup("Page Seg Mode", TesseractOCR::SEGMENT_AUTO, TesseractOCR::SEGMENT_AUTO, TesseractOCR::SEGMENT_SINGLE_LINE));
+	gui.add(tesseractEngine.setup("Tesseract Engine", TesseractOCR::ENGINE_LSTM, TesseractOCR::ENGINE_LSTM, TesseractOCR::ENGINE_COMBINED));
 	gui.add(enableOCR.setup("Enable OCR", true));
+	gui.add(roiOCR.setup("ROI OCR", true));
+	gui.add(roiParagraphs.setup("ROI Paragraphs", false));
+	gui.add(mserDownscale.setup("MSER Downscale", 0.5, 0.25, 1.0));
+	gui.add(mserFrameStride.setup("MSER Frame Stride", 2, 1, 10));
+	gui.add(previewScale.setup("Preview Scale", 0.5, 0.25, 1.0));
+	gui.add(stabilityGate.setup("Stability Gate", true));
+	gui.add(motionThreshold.setup("Motion Threshold", 4.0, 1.0, 20.0));
+	gui.add(settleFrames.setup("Settle Frames", 5, 1, 30));
+	gui.add(rectifyPage.setup("Rectify Page", true));
+	gui.add(minWordConfidence.setup("Min Word Confidence", 0, 0, 100));
+	
+	// Per venue settings, e.g. chosen by --tune
+	if (ofFile::doesFileExist(ocrProfilePath)) {
+		gui.loadFromFile(ocrProfilePath);
+		ofLogNotice() << "Loaded OCR profile: " << ocrProfilePath;
+	}
 }
 
 //--------------------------------------------------------------
 void ofApp::update() {
-	camera.update();
-	
-	if (camera.isFrameNew()) {
-		currentFrame.setFromPixels(camera.getPixels());
-		
-		// Perform OCR processing every 30 frames (similar to Python version)
-		if (ofGetFrameNum() % 30 == 0 && enableOCR && !processingFrame) {
-			performOCR();
+	// Reloading the engines happens on the OCR thread, and only on a change
+	ocrPool.setEngineMode(TesseractOCR::EngineMode(int(tesseractEngine)));
+	
+	ReadingStation::Settings settings = getStationSettings();
+	for (auto& station : stations) {
+		station->setSettings(settings);
+		station->setShowProcessed(showProcessedImage && station->getIndex() == selectedStation);
+		if (station->update()) {
+			triggerProjection(station->getIndex());
 		}
-		
-		// Always detect text regions for visual feedback
-		detectTextRegions(currentFrame);
 	}
 	
-	// Check for OCR results
-	string ocrResult;
-	if (resultChannel.tryReceive(ocrResult)) {
-		processingFrame = false;
-		
-		if (checkForKeywords(ocrResult)) {
-			ofLogNotice() << "The keyword is captured";
-			triggerProjection();
-		}
+	KeywordEvent event;
+	while (options.projectionOnly && triggerReceiver.update(event)) {
+		ofLogNotice() << "The keyword is captured at station " << event.station << " (remote): " << event.keyword;
+		lastRemoteEvent = event;
+		triggerProjection(event.station);
 	}
 	
 	// Update video if playing
 	if (projectionActive && videoLoaded) {
 		diasporaVideo.update();
+		if (awaitingLiveVideo && diasporaVideo.getFirstLiveFrameMicros() > 0) {
+			awaitingLiveVideo = false;
+			getTriggerLatency().record(LatencyStats::STAGE_TRIGGER_TO_VIDEO, diasporaVideo.getFirstLiveFrameMicros() - triggerMicros);
+		}
+	}
+	
+	// Roll the latency windows over and keep a record of them
+	if (ofGetElapsedTimef() - lastLatencyDump > 10) {
+		lastLatencyDump = ofGetElapsedTimef();
+		for (size_t i = 0; i < stations.size(); i++) {
+			stations[i]->getLatency().dump(getLatencyPath(i));
+		}
+		if (options.projectionOnly) {
+			remoteLatency.dump(getLatencyPath(0));
+		}
 	}
 }
 
+//--------------------------------------------------------------
+ReadingStation::Settings ofApp::getStationSettings() {
+	ReadingStation::Settings settings;
+	settings.enableOCR = enableOCR;
+	settings.roiOCR = roiOCR;
+	settings.roiParagraphs = roiParagraphs;
+	settings.stabilityGate = stabilityGate;
+	settings.motionThreshold = motionThreshold;
+	settings.settleFrames = settleFrames;
+	settings.rectifyPage = rectifyPage;
+	settings.minWordConfidence = minWordConfidence;
+	settings.mserDownscale = mserDownscale;
+	settings.mserFrameStride = mserFrameStride;
+	settings.previewScale = previewScale;
+	settings.preprocess.scale = scaleFactor;
+	settings.preprocess.threshBlockSize = adaptiveThreshBlockSize;
+	settings.preprocess.threshC = adaptiveThreshC;
+	settings.preprocess.claheClipLimit = claheClipLimit;
+	settings.preprocess.bilateralDiameter = bilateralDiameter;
+	settings.preprocess.bilateralSigmaColor = bilateralSigma;
+	settings.preprocess.bilateralSigmaSpace = bilateralSigma;
+	settings.pageMode = TesseractOCR::SegmentationMode(int(pageSegMode));
+	return settings;
+}
+
+//--------------------------------------------------------------
+string ofApp::getLatencyPath(size_t station) const {
+	// A single station keeps the file name it always had
+	if (stations.size() <= 1) {
+		return ofToDataPath("latency.csv");
+	}
+	return ofToDataPath("latency_station" + ofToString(station + 1) + ".csv");
+}
+
+//--------------------------------------------------------------
+LatencyStats& ofApp::getTriggerLatency() {
+	if (triggerStation < stations.size()) {
+		return stations[triggerStation]->getLatency();
+	}
+	return remoteLatency;
+}
+
 //--------------------------------------------------------------
 void ofApp::draw() {
 	ofBackground(30);
@@ -175,27 +300,37 @@ void ofApp::draw() {
 
 //--------------------------------------------------------------
 void ofApp::drawCameraFeed() {
-	// Draw camera feed
-	ofSetColor(255);
-	currentFrame.draw(0, 0, ofGetWidth() * 0.6, ofGetHeight() * 0.6);
+	// Camera previews tiled into the left part of the window
+	size_t columns = std::ceil(std::sqrt(double(stations.size())));
+	size_t rows = (stations.size() + columns - 1) / std::max<size_t>(1, columns);
+	float tileWidth = ofGetWidth() * 0.6 / std::max<size_t>(1, columns);
+	float tileHeight = ofGetHeight() * 0.6 / std::max<size_t>(1, rows);
+	for (size_t i = 0; i < stations.size(); i++) {
+		stations[i]->draw((i % columns) * tileWidth, (i / columns) * tileHeight, tileWidth, tileHeight);
+	}
 	
 	// Draw processed image if enabled
-	if (showProcessedImage && processedFrame.getWidth() > 0) {
-		processedFrame.draw(ofGetWidth() * 0.65, 0, ofGetWidth() * 0.35, ofGetHeight() * 0.35);
-		ofSetColor(255, 0, 0);
-		ofDrawBitmapString("Processed Frame", ofGetWidth() * 0.65, ofGetHeight() * 0.35 + 20);
+	if (showProcessedImage && selectedStation < stations.size()) {
+		stations[selectedStation]->drawProcessed(ofGetWidth() * 0.65, 0, ofGetWidth() * 0.35, ofGetHeight() * 0.35);
 	}
 	
-	// Draw text regions
-	drawTextRegions();
-	
 	// Status overlay
 	ofSetColor(0, 255, 0);
-	ofDrawBitmapString("Searching for keywords: immigrants, immigrant, immigration, migrant, migrants, diaspora", 10, 30);
-	
-	if (processingFrame) {
-		ofSetColor(255, 255, 0);
-		ofDrawBitmapString("PROCESSING OCR...", 10, 50);
+	if (options.projectionOnly) {
+		ofDrawBitmapString("Waiting for keyword events on port " + ofToString(options.listenPort), 10, 30);
+		
+		// Where the last keyword was read, on a frame the size of a preview
+		ofNoFill();
+		ofSetColor(0, 160, 255, 160);
+		float w = ofGetWidth() * 0.6;
+		float h = ofGetHeight() * 0.6;
+		ofDrawRectangle(0, 0, w, h);
+		for (const auto& box : lastRemoteEvent.boxes) {
+			ofDrawRectangle(box.x * w, box.y * h, box.width * w, box.height * h);
+		}
+		ofFill();
+	} else {
+		ofDrawBitmapString("Searching for keywords: immigrants, immigrant, immigration, migrant, migrants, diaspora", 10, 30);
 	}
 }
 
@@ -205,6 +340,7 @@ void ofApp::drawProjection() {
 		// Draw video projection
 		ofSetColor(255);
 		diasporaVideo.draw(0, 0, ofGetWidth(), ofGetHeight());
+		recordFirstProjectedFrame(diasporaVideo.getFirstFrameMicros());
 		
 		// Video controls overlay
 		ofSetColor(255, 255, 255, 200);
@@ -215,6 +351,7 @@ void ofApp::drawProjection() {
 		// Check if video ended
 		if (diasporaVideo.getIsMovieDone()) {
 			projectionActive = false;
+			diasporaVideo.rewind();
 			ofLogNotice() << "Video projection ended";
 		}
 	} else {
@@ -226,6 +363,7 @@ void ofApp::drawProjection() {
 //--------------------------------------------------------------
 void ofApp::drawFallbackProjection() {
 	ofBackground(245, 245, 220); // Cream background
+	recordFirstProjectedFrame(ofGetElapsedTimeMicros());
 	
 	float currentTime = ofGetElapsedTimef() - fallbackStartTime;
 	
@@ -259,186 +397,106 @@ void ofApp::drawFallbackProjection() {
 	}
 }
 
-//--------------------------------------------------------------
-void ofApp::drawTextRegions() {
-	// Draw detected text regions
-	ofSetColor(255, 0, 0, 100);
-	ofNoFill();
-	ofSetLineWidth(2);
-	
-	float scaleX = (ofGetWidth() * 0.6) / cameraWidth;
-	float scaleY = (ofGetHeight() * 0.6) / cameraHeight;
-	
-	for (const auto& rect : textRegions) {
-		ofDrawRectangle(rect.x * scaleX, rect.y * scaleY,
-					   rect.width * scaleX, rect.height * scaleY);
-	}
-	
-	ofFill();
-}
-
 //--------------------------------------------------------------
 void ofApp::drawDebugInfo() {
 	// Debug information overlay
 	ofSetColor(255, 255, 0);
-	int yPos = ofGetHeight() - 120;
+	int rows = options.projectionOnly ? 1 : stations.size() + 2;
+	int yPos = ofGetHeight() - 120 - 15 * (LatencyStats::STAGE_COUNT + rows);
 	
 	ofDrawBitmapString("=== Debug Info ===", 10, yPos);
 	yPos += 15;
 	ofDrawBitmapString("Frame: " + ofToString(ofGetFrameNum()), 10, yPos);
 	yPos += 15;
-	ofDrawBitmapString("FPS: " + ofToString(ofGetFrameRate(), 1), 10, yPos);
-	yPos += 15;
-	ofDrawBitmapString("Text Regions: " + ofToString(textRegions.size()), 10, yPos);
-	yPos += 15;
-	ofDrawBitmapString("OCR Processing: " + string(processingFrame ? "YES" : "NO"), 10, yPos);
+	ofDrawBitmapString("FPS: " + ofToString(ofGetFrameRate(), 1) + "  OCR engines: " + ofToString(ocrPool.size()), 10, yPos);
 	yPos += 15;
-	ofDrawBitmapString("Video Loaded: " + string(videoLoaded ? "YES" : "NO"), 10, yPos);
+	ofDrawBitmapString("Video Loaded: " + string(videoLoaded ? "YES" : "NO") +
+					   " (" + ofToString(diasporaVideo.getNumPrimedFrames()) + " frames primed)  Last trigger to frame: " +
+					   ofToString(lastTriggerToFrameMs, 2) + " ms", 10, yPos);
 	yPos += 15;
 	
-	ofDrawBitmapString("Controls: 'h'=help, 'd'=debug, 't'=trigger, 'p'=processed image, 'q'=quit", 10, yPos);
-}
-
-//--------------------------------------------------------------
-void ofApp::detectTextRegions(ofImage& frame) {
-	// Convert to OpenCV format
-	cv::Mat mat = ofxCv::toCv(frame);
-	cv::Mat gray;
-	cv::cvtColor(mat, gray, cv::COLOR_RGB2GRAY);
-	
-	// Use MSER for text region detection
-	cv::Ptr<cv::MSER> mser = cv::MSER::create();
-	vector<vector<cv::Point>> regions;
-	vector<cv::Rect> bboxes;
-	
-	mser->detectRegions(gray, regions, bboxes);
-	
-	// Filter regions by size (likely to contain text)
-	textRegions.clear();
-	for (const auto& bbox : bboxes) {
-		if (bbox.width > 20 && bbox.width < 300 &&
-			bbox.height > 10 && bbox.height < 100) {
-			textRegions.push_back(bbox);
-		}
+	if (options.projectionOnly) {
+		const ClockOffset& clock = triggerReceiver.getClock();
+		ofDrawBitmapString("Remote: " + ofToString(triggerReceiver.getEventsReceived()) + " events  Clock offset " +
+						   (clock.isValid() ? ofToString(clock.getOffset() / 1000.0, 2) + " ms (round trip " +
+											  ofToString(clock.getRoundTrip() / 1000.0, 2) + " ms)" : string("unknown")) +
+						   "  Last capture to receipt: " + ofToString(triggerReceiver.getLastLatencyMs(), 1) + " ms", 10, yPos);
+		yPos += 15;
+		drawLatencyTable(remoteLatency, yPos);
+		ofDrawBitmapString("Controls: 'h'=help, 'd'=debug, 't'=trigger, 'q'=quit", 10, yPos);
+		return;
 	}
-}
-
-//--------------------------------------------------------------
-void ofApp::processFrameForOCR(ofImage& frame) {
-	// Convert to OpenCV format
-	cv::Mat mat = ofxCv::toCv(frame);
-	cv::cvtColor(mat, grayMat, cv::COLOR_RGB2GRAY);
-	
-	// Resize for better OCR
-	cv::resize(grayMat, processedMat, cv::Size(), scaleFactor, scaleFactor, cv::INTER_CUBIC);
-	
-	// Apply bilateral filter
-	cv::Mat filtered;
-	cv::bilateralFilter(processedMat, filtered, 9, 75, 75);
-	
-	// Apply CLAHE
-	cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE(claheClipLimit, cv::Size(8, 8));
-	cv::Mat enhanced;
-	clahe->apply(filtered, enhanced);
-	
-	// Apply adaptive thresholding
-	cv::adaptiveThreshold(enhanced, thresholdMat, 255,
-						 cv::ADAPTIVE_THRESH_GAUSSIAN_C, cv::THRESH_BINARY,
-						 adaptiveThreshBlockSize, adaptiveThreshC);
-	
-	// Morphological operations
-	cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(2, 2));
-	cv::morphologyEx(thresholdMat, thresholdMat, cv::MORPH_CLOSE, kernel);
-	cv::morphologyEx(thresholdMat, thresholdMat, cv::MORPH_OPEN, kernel);
-	
-	// Convert back to ofImage for display
-	processedFrame = matToOfImage(thresholdMat);
-}
-
-//--------------------------------------------------------------
-void ofApp::performOCR() {
-	if (processingFrame || !ocrEngine) return;
-	
-	processingFrame = true;
-	
-	// Process frame for OCR
-	processFrameForOCR(currentFrame);
-	
-	// Send frame to OCR thread
-	frameChannel.send(processedFrame);
+	if (stations.empty()) return;
+	const ReadingStation& selected = *stations[selectedStation];
 	
-	if (!ocrThreadRunning) {
-		startOCRThread();
+	// One line per station: what the shared scheduler is doing for each
+	ofDrawBitmapString("Station       page       queue p95  ocr p95  trigger p95  dropped  cache", 10, yPos);
+	yPos += 15;
+	for (const auto& station : stations) {
+		const LatencyStats& stats = station->getLatency();
+		string name = (station->getIndex() == selectedStation ? "> " : "  ") + station->getName();
+		name.resize(std::max<size_t>(name.size(), 14), ' ');
+		string page = PageStabilityGate::toString(station->getPageGate().getState());
+		page.resize(std::max<size_t>(page.size(), 9), ' ');
+		ofDrawBitmapString(name + page + (station->isProcessing() ? "*" : " ") +
+						   ofToString(stats.get(LatencyStats::STAGE_QUEUE).getPercentile(0.95), 1, 10, ' ') +
+						   ofToString(stats.get(LatencyStats::STAGE_OCR).getPercentile(0.95), 1, 9, ' ') +
+						   ofToString(stats.get(LatencyStats::STAGE_CAPTURE_TO_TRIGGER).getPercentile(0.95), 1, 13, ' ') +
+						   ofToString(station->getDroppedFrames(), 9, ' ') +
+						   ofToString(station->getPageCache().getHits(), 7, ' '), 10, yPos);
+		yPos += 15;
 	}
-}
-
-//--------------------------------------------------------------
-void ofApp::startOCRThread() {
-	ocrThreadRunning = true;
-	thread ocrThread(&ofApp::ocrThreadFunction, this);
-	ocrThread.detach();
-}
-
-//--------------------------------------------------------------
-void ofApp::ocrThreadFunction() {
-	ofImage frameToProcess;
 	
-	while (ocrThreadRunning && frameChannel.tryReceive(frameToProcess)) {
-		if (frameToProcess.getWidth() > 0) {
-			// Convert to OpenCV Mat
-			cv::Mat mat = ofxCv::toCv(frameToProcess);
-			
-			// Perform OCR
-			string result = ocrEngine->recognizeText(mat);
-			
-			// Send result back
-			resultChannel.send(result);
-		}
-		
-		ofSleepMillis(100); // Small delay
-	}
+	ofDrawBitmapString(selected.getName() + ": Text Regions: " + ofToString(selected.getNumTextRegions()) +
+					   " (" + ofToString(selected.getTextRegionsAge()) + " frames old)  Page motion " +
+					   ofToString(selected.getPageGate().getMotion(), 1) + "  Cache: " +
+					   ofToString(selected.getPageCache().getHits()) + " hits / " +
+					   ofToString(selected.getPageCache().getMisses()) + " misses", 10, yPos);
+	yPos += 15;
 	
-	ocrThreadRunning = false;
+	drawLatencyTable(selected.getLatency(), yPos);
+	
+	ofDrawBitmapString("Controls: 'h'=help, 'd'=debug, 't'=trigger, 'p'=processed image, '1'-'9'=station, 'q'=quit", 10, yPos);
 }
 
 //--------------------------------------------------------------
-bool ofApp::checkForKeywords(const string& text) {
-	string cleanText = preprocessText(text);
-	
-	for (const string& keyword : targetKeywords) {
-		if (cleanText.find(keyword) != string::npos) {
-			float currentTime = ofGetElapsedTimef();
-			if (currentTime - lastDetectionTime > detectionCooldown) {
-				lastDetectionTime = currentTime;
-				return true;
-			}
-		}
+void ofApp::drawLatencyTable(const LatencyStats& stats, int& yPos) {
+	ofDrawBitmapString("Latency (ms)            p50      p95      p99     n", 10, yPos);
+	yPos += 15;
+	for (int i = 0; i < LatencyStats::STAGE_COUNT; i++) {
+		LatencyStats::Stage stage = LatencyStats::Stage(i);
+		const LatencyHistogram& histogram = stats.get(stage);
+		string name = LatencyStats::toString(stage);
+		name.resize(std::max<size_t>(name.size(), 18), ' ');
+		ofDrawBitmapString(name +
+						   ofToString(histogram.getPercentile(0.50), 1, 9, ' ') +
+						   ofToString(histogram.getPercentile(0.95), 1, 9, ' ') +
+						   ofToString(histogram.getPercentile(0.99), 1, 9, ' ') +
+						   ofToString(histogram.getCount(), 6, ' '), 10, yPos);
+		yPos += 15;
 	}
-	
-	return false;
 }
 
 //--------------------------------------------------------------
-string ofApp::preprocessText(const string& text) {
-	string result = ofToLower(text);
-	
-	// Remove extra whitespace
-	result = ofStringReplace(result, "  ", " ");
-	result = ofStringReplace(result, "\n", " ");
-	result = ofStringReplace(result, "\t", " ");
-	
-	return result;
+void ofApp::startOCRThread() {
+	// One slot per station, all feeding the same engines
+	ocrWorker.setup(&ocrPool, stations.size());
 }
 
 //--------------------------------------------------------------
-void ofApp::triggerProjection() {
+void ofApp::triggerProjection(size_t station) {
 	if (!projectionActive) {
 		projectionActive = true;
+		triggerStation = station;
 		fallbackStartTime = ofGetElapsedTimef();
+		triggerMicros = ofGetElapsedTimeMicros();
+		awaitingFirstFrame = true;
 		
 		if (videoLoaded) {
-			diasporaVideo.setPosition(0);
+			// Primed: frame 0 is drawn this very tick
 			diasporaVideo.play();
+			triggerMicros = diasporaVideo.getTriggerMicros();
+			awaitingLiveVideo = true;
 			ofLogNotice() << "🎬 Playing video projection...";
 		} else {
 			ofLogNotice() << "🎭 Playing fallback animated content...";
@@ -446,6 +504,26 @@ void ofApp::triggerProjection() {
 	}
 }
 
+//--------------------------------------------------------------
+void ofApp::recordFirstProjectedFrame(uint64_t frameMicros) {
+	if (!awaitingFirstFrame || frameMicros == 0) {
+		return;
+	}
+	awaitingFirstFrame = false;
+	
+	uint64_t elapsed = frameMicros - triggerMicros;
+	getTriggerLatency().record(LatencyStats::STAGE_TRIGGER_TO_FRAME, elapsed);
+	lastTriggerToFrameMs = elapsed / 1000.0;
+	
+	// The budget is one display frame
+	float frameMs = 1000.0 / std::max(1.0f, ofGetTargetFrameRate());
+	ofLogNotice() << ofGetTimestampString("%H:%M:%S.%i") << " first projected frame "
+				  << ofToString(lastTriggerToFrameMs, 2) << " ms after trigger";
+	if (lastTriggerToFrameMs > frameMs) {
+		ofLogWarning() << "Trigger to first frame took longer than one display frame (" << ofToString(frameMs, 1) << " ms)";
+	}
+}
+
 //--------------------------------------------------------------
 void ofApp::keyPressed(int key) {
 	switch (key) {
@@ -456,6 +534,8 @@ void ofApp::keyPressed(int key) {
 			ofLogNotice() << "'t' - Manual trigger projection";
 			ofLogNotice() << "'p' - Toggle processed image view";
 			ofLogNotice() << "'s' - Save current frame";
+			ofLogNotice() << "'c' - Clear cached page results";
+			ofLogNotice() << "'1'-'9' - Select station for the debug overlay";
 			ofLogNotice() << "'q' - Quit application";
 			break;
 			
@@ -466,7 +546,7 @@ void ofApp::keyPressed(int key) {
 			
 		case 't':
 			ofLogNotice() << "Manual trigger activated";
-			triggerProjection();
+			triggerProjection(selectedStation);
 			break;
 			
 		case 'p':
@@ -475,118 +555,55 @@ void ofApp::keyPressed(int key) {
 			break;
 			
 		case 's':
-			{
+			if (selectedStation < stations.size()) {
 				string filename = "debug_frame_" + ofToString(ofGetUnixTime()) + ".png";
-				currentFrame.save(filename);
-				ofLogNotice() << "Saved frame: " << filename;
+				// Encoding a PNG takes long enough to drop frames, so it's saved in the background
+				ofSaveImageAsync(stations[selectedStation]->getPixels(), filename);
+				ofLogNotice() << "Saving frame: " << filename;
 			}
 			break;
 			
+		case 'c':
+			for (auto& station : stations) {
+				station->clearCache();
+			}
+			ofLogNotice() << "Page cache cleared";
+			break;
+			
 		case 'q':
 			ofExit();
 			break;
+			
+		default:
+			if (key >= '1' && key <= '9' && size_t(key - '1') < stations.size()) {
+				selectedStation = key - '1';
+				ofLogNotice() << "Selected " << stations[selectedStation]->getName();
+			}
+			break;
 	}
 }
 
 //--------------------------------------------------------------
 void ofApp::exit() {
 	stopOCRThread();
-	
-	if (ocrEngine) {
-		ocrEngine->cleanup();
-		delete ocrEngine;
+	for (size_t i = 0; i < stations.size(); i++) {
+		stations[i]->stop();
+		stations[i]->getLatency().dump(getLatencyPath(i));
+	}
+	if (options.projectionOnly) {
+		remoteLatency.dump(getLatencyPath(0));
 	}
 	
-	camera.close();
+	ocrPool.stop();
 	
 	ofLogNotice() << "Application shutdown complete";
 }
 
 //--------------------------------------------------------------
 void ofApp::stopOCRThread() {
-	ocrThreadRunning = false;
-}
-
-//--------------------------------------------------------------
-// Utility functions
-//--------------------------------------------------------------
-ofImage ofApp::matToOfImage(const cv::Mat& mat) {
-	ofImage img;
-	if (mat.channels() == 1) {
-		img.allocate(mat.cols, mat.rows, OF_IMAGE_GRAYSCALE);
-	} else {
-		img.allocate(mat.cols, mat.rows, OF_IMAGE_COLOR);
-	}
-	
-	img.setFromPixels(mat.data, mat.cols, mat.rows,
-					 mat.channels() == 1 ? OF_IMAGE_GRAYSCALE : OF_IMAGE_COLOR);
-	return img;
-}
-
-//--------------------------------------------------------------
-cv::Mat ofApp::ofImageToMat(const ofImage& img) {
-	return ofxCv::toCv(img);
-}
-
-//--------------------------------------------------------------
-// TesseractOCR Implementation
-//--------------------------------------------------------------
-TesseractOCR::TesseractOCR() : tesseractAPI(nullptr), initialized(false) {
-	configString = "-c tessedit_char_whitelist=ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz --psm 6";
-}
-
-//--------------------------------------------------------------
-TesseractOCR::~TesseractOCR() {
-	cleanup();
-}
-
-//--------------------------------------------------------------
-bool TesseractOCR::initialize() {
-	tesseract::TessBaseAPI* api = new tesseract::TessBaseAPI();
-	
-	if (api->Init(NULL, "eng", tesseract::OEM_LSTM_ONLY)) {
-		ofLogError() << "Could not initialize Tesseract";
-		delete api;
-		return false;
-	}
-	
-	api->SetPageSegMode(tesseract::PSM_AUTO);
-	tesseractAPI = static_cast<void*>(api);
-	initialized = true;
-	
-	return true;
-}
-
-//--------------------------------------------------------------
-string TesseractOCR::recognizeText(const cv::Mat& image) {
-	if (!initialized || !tesseractAPI) {
-		return "";
-	}
-	
-	tesseract::TessBaseAPI* api = static_cast<tesseract::TessBaseAPI*>(tesseractAPI);
-	
-	api->SetImage(image.data, image.cols, image.rows, image.channels(), image.step);
-	
-	char* result = api->GetUTF8Text();
-	string textResult = "";
-	
-	if (result) {
-		textResult = string(result);
-		delete[] result;
-	}
-	
-	return textResult;
-}
-
-//--------------------------------------------------------------
-void TesseractOCR::cleanup() {
-	if (tesseractAPI) {
-		tesseract::TessBaseAPI* api = static_cast<tesseract::TessBaseAPI*>(tesseractAPI);
-		api->End();
-		delete api;
-		tesseractAPI = nullptr;
-	}
-	initialized = false;
+	// Blocks until the worker has finished any in-flight recognition,
+	// so the engine can be safely deleted afterwards
+	ocrWorker.stop();
 }
 
 //--------------------------------------------------------------
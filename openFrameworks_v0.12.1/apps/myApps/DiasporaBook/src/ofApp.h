@@ -3,12 +3,31 @@
 #include "ofMain.h"
 #include "ofxCv.h"
 #include "ofxGui.h"
-
-// Forward declarations for OCR
-class TesseractOCR;
+#include "OCRWorker.h"
+#include "ReadingStation.h"
+#include "LatencyStats.h"
+#include "PrimedVideoPlayer.h"
+#include "RemoteTrigger.h"
 
 class ofApp : public ofBaseApp {
 public:
+	// Projection only: keyword events come over OSC from a recognition
+	// node (DiasporaBook --recognize) instead of local cameras.
+	// Run as: DiasporaBook --project [--listen port] [--recognizer host:port]
+	struct Options {
+		bool projectionOnly = false;
+		int listenPort = 9000;
+		string recognitionHost = "127.0.0.1";
+		int recognitionPort = 9001;
+	};
+	
+	// Returns false, after logging why, on an argument the interactive app
+	// or a projection node (--project) doesn't take, or that lacks its value
+	static bool parseArguments(int argc, char* argv[], Options& options);
+	
+	ofApp();
+	ofApp(const Options& options);
+	
 	void setup();
 	void update();
 	void draw();
@@ -24,52 +43,76 @@ public:
 	void dragEvent(ofDragInfo dragInfo);
 	void gotMessage(ofMessage msg);
 
+	// The keywords the installation reacts to, shared with the replay harness
+	static vector<string> getDefaultKeywords();
+
 private:
-	// Camera and video capture
-	ofVideoGrabber camera;
-	ofImage currentFrame;
-	ofImage processedFrame;
+	Options options;
+	
+	// Reading stations, one camera and book each, sharing the OCR pool
+	vector<std::unique_ptr<ReadingStation>> stations;
+	string stationsPath;
+	size_t selectedStation; // shown in detail in the debug overlay
+	size_t triggerStation; // projection latency is recorded against it
 	
 	// Video projection
-	ofVideoPlayer diasporaVideo;
+	PrimedVideoPlayer diasporaVideo; // paused on frame 0 between runs, opening frames on the GPU
 	bool projectionActive;
 	bool videoLoaded;
 	string videoPath;
 	
-	// OCR and text detection
-	TesseractOCR* ocrEngine;
-	bool processingFrame;
-	float lastDetectionTime;
-	float detectionCooldown;
+	// OCR, shared by every station
+	TesseractPool ocrPool; // one engine per core, shared by each page's regions
 	vector<string> targetKeywords;
 	
-	// Image processing
-	cv::Mat grayMat;
-	cv::Mat processedMat;
-	cv::Mat thresholdMat;
-	ofImage debugImage;
-	
-	// Text regions detection
-	vector<cv::Rect> textRegions;
-	
 	// Display settings
 	int cameraWidth, cameraHeight;
 	int projectionWidth, projectionHeight;
 	bool showDebugInfo;
 	bool showProcessedImage;
 	
-	// Threading for OCR
-	ofThreadChannel<ofImage> frameChannel;
-	ofThreadChannel<string> resultChannel;
-	bool ocrThreadRunning;
+	// Threading for OCR: one worker schedules all stations' pages
+	OCRWorker ocrWorker;
+	
+	// Per-stage latency is kept per station, shown in the debug overlay
+	// and dumped periodically
+	uint64_t triggerMicros;
+	bool awaitingFirstFrame; // projection triggered, nothing shown yet
+	bool awaitingLiveVideo; // nothing from the video pipeline itself yet
+	float lastTriggerToFrameMs;
+	float lastLatencyDump;
+	void recordFirstProjectedFrame(uint64_t frameMicros);
+	string getLatencyPath(size_t station) const;
+	LatencyStats& getTriggerLatency();
+	
+	// Projection only: events from the recognition node, and the latency
+	// of the projection recorded against them
+	TriggerReceiver triggerReceiver;
+	LatencyStats remoteLatency;
+	KeywordEvent lastRemoteEvent;
 	
 	// GUI
 	ofxPanel gui;
+	string ocrProfilePath;
 	ofxFloatSlider scaleFactor;
 	ofxIntSlider adaptiveThreshBlockSize;
 	ofxFloatSlider adaptiveThreshC;
 	ofxFloatSlider claheClipLimit;
+	ofxIntSlider bilateralDiameter;
+	ofxFloatSlider bilateralSigma;
+	ofxIntSlider pageSegMode; // TesseractOCR::SegmentationMode for whole-page OCR
+	ofxIntSlider tesseractEngine; // TesseractOCR::EngineMode
 	ofxToggle enableOCR;
+	ofxToggle roiOCR;
+	ofxToggle roiParagraphs;
+	ofxFloatSlider mserDownscale;
+	ofxIntSlider mserFrameStride;
+	ofxFloatSlider previewScale;
+	ofxToggle stabilityGate;
+	ofxFloatSlider motionThreshold;
+	ofxIntSlider settleFrames;
+	ofxToggle rectifyPage;
+	ofxFloatSlider minWordConfidence;
 	
 	// Fallback projection content
 	vector<string> fallbackTexts;
@@ -79,47 +122,21 @@ private:
 	ofTrueTypeFont projectionFont;
 	
 	// Methods
-	void setupCamera();
+	void setupStations();
 	void setupVideo();
 	void setupOCR();
 	void setupFallbackContent();
 	void setupGUI();
 	
-	void processFrameForOCR(ofImage& frame);
-	void detectTextRegions(ofImage& frame);
-	void performOCR();
-	bool checkForKeywords(const string& text);
-	void triggerProjection();
+	ReadingStation::Settings getStationSettings();
+	void triggerProjection(size_t station);
 	
 	void drawCameraFeed();
 	void drawProjection();
 	void drawFallbackProjection();
 	void drawDebugInfo();
-	void drawTextRegions();
+	void drawLatencyTable(const LatencyStats& stats, int& yPos);
 	
 	void startOCRThread();
 	void stopOCRThread();
-	void ocrThreadFunction();
-	
-	// Utility functions
-	string preprocessText(const string& text);
-	vector<string> tokenizeText(const string& text);
-	ofImage matToOfImage(const cv::Mat& mat);
-	cv::Mat ofImageToMat(const ofImage& img);
-};
-
-// Separate OCR class for better organization
-class TesseractOCR {
-public:
-	TesseractOCR();
-	~TesseractOCR();
-	
-	bool initialize();
-	string recognizeText(const cv::Mat& image);
-	void cleanup();
-	
-private:
-	void* tesseractAPI; // Will hold TessBaseAPI*
-	bool initialized;
-	string configString;
 };
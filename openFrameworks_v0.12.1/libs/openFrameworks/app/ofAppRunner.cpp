@@ -109,6 +109,10 @@ void ofInit(){
 	initialized() = true;
 	exiting() = false;
 
+	// create the logger channel before registering ofExitCallback, so it is
+	// destroyed after ofExitCallback has flushed it
+	ofGetLoggerChannel();
+
 #if defined(TARGET_ANDROID) || defined(TARGET_OF_IOS)
     // manage own exit
 #else
@@ -278,6 +282,9 @@ void ofExitCallback(){
 	// events
 	of::priv::endutils();
 
+	// write out whatever an asynchronous logger channel is still holding
+	ofLog::getChannel()->flush();
+
 	initialized() = false;
 	exiting() = true;
 }
@@ -151,9 +151,15 @@ namespace priv{
 	public:
 		BaseEvent(){}
 
+		~BaseEvent(){
+			std::unique_lock<Mutex> lck(self->mtx);
+			self->release(self);
+		}
+
 		BaseEvent(const BaseEvent & mom){
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
 			self->functions = mom.self->functions;
+			self->publish();
 		}
 
 		BaseEvent & operator=(const BaseEvent & mom){
@@ -164,6 +170,7 @@ namespace priv{
 			std::unique_lock<Mutex> lck2(self->mtx);
 			self->functions = mom.self->functions;
 			self->enabled = mom.self->enabled;
+			self->publish();
 			return *this;
 		}
 
@@ -171,6 +178,9 @@ namespace priv{
 			std::unique_lock<Mutex> lck(const_cast<BaseEvent&>(mom).self->mtx);
 			self->functions = std::move(mom.self->functions);
 			self->enabled = std::move(mom.self->enabled);
+			mom.self->functions.clear();
+			mom.self->publish();
+			self->publish();
 		}
 
 		BaseEvent & operator=(BaseEvent && mom){
@@ -181,6 +191,7 @@ namespace priv{
 			std::unique_lock<Mutex> lck2(self->mtx);
 			self->functions = mom.self->functions;
 			self->enabled = mom.self->enabled;
+			self->publish();
 			return *this;
 		}
 
@@ -202,11 +213,96 @@ namespace priv{
 
 	protected:
 
+		typedef std::vector<std::shared_ptr<Function>> Functions;
+
 		struct Data{
 			Mutex mtx;
-			std::vector<std::shared_ptr<Function>> functions;
+			// The listeners, only touched with mtx held
+			Functions functions;
 			std::atomic<bool> notified_ { false };
 			bool enabled = true;
+
+			// What notify iterates: an immutable copy of functions, replaced
+			// (never modified) whenever they change, so notifying only has to
+			// load a pointer. Replaced copies are retired and deleted once no
+			// notify is running.
+			std::atomic<const Functions*> snapshot { nullptr };
+			std::vector<const Functions*> retired;
+
+			// The number of notifies running, with the pending bit set while
+			// there is something to clean up once it drops to 0. Both live in
+			// the same atomic so the last notify out can't miss the bit.
+			static constexpr unsigned pending = 1u << 31;
+			std::atomic<unsigned> readers { 0 };
+			// Set when the event is destroyed by one of its listeners, so
+			// the notifies still running can finish
+			std::shared_ptr<Data> keepAlive;
+
+			~Data(){
+				delete snapshot.load();
+				for(auto functions: retired){
+					delete functions;
+				}
+			}
+
+			// Call with mtx held after every change to functions.
+			void publish(){
+				const Functions * next = functions.empty() ? nullptr : new Functions(functions);
+				const Functions * previous = snapshot.exchange(next, std::memory_order_acq_rel);
+				if(previous){
+					retired.push_back(previous);
+					// a notify that starts after this sees the new snapshot,
+					// one that started before keeps the bit for the last one
+					// out to clean up
+					if(readers.fetch_or(pending, std::memory_order_acq_rel) == 0){
+						std::shared_ptr<Data> last;
+						collect(last);
+					}
+				}
+			}
+
+			// Call with mtx held. Deletes the retired copies if no notify
+			// is running, and hands back keepAlive to be released once the
+			// mutex is unlocked.
+			void collect(std::shared_ptr<Data> & last){
+				unsigned expected = pending;
+				if(readers.compare_exchange_strong(expected, 0, std::memory_order_acq_rel)){
+					for(auto functions: retired){
+						delete functions;
+					}
+					retired.clear();
+					last = std::move(keepAlive);
+				}
+			}
+
+			void enter(){
+				readers.fetch_add(1, std::memory_order_acquire);
+			}
+
+			void leave(){
+				unsigned current = readers.load(std::memory_order_relaxed);
+				while(current != (pending | 1)){
+					if(readers.compare_exchange_weak(current, current - 1, std::memory_order_release, std::memory_order_relaxed)){
+						return;
+					}
+				}
+				// the last notify out with something to clean up. It's still
+				// counted, so this Data can't go away before the lock is held
+				std::shared_ptr<Data> last;
+				std::unique_lock<Mutex> lck(mtx);
+				readers.fetch_sub(1, std::memory_order_acq_rel);
+				collect(last);
+			}
+
+			// Call with mtx held from the event's destructor.
+			void release(const std::shared_ptr<Data> & self){
+				keepAlive = self;
+				if(readers.fetch_or(pending, std::memory_order_acq_rel) == 0){
+					std::shared_ptr<Data> last;
+					collect(last);
+					// the event still holds self, this doesn't delete anything
+				}
+			}
 			
 			bool didNotify() {
 				if (notified_.load(std::memory_order_relaxed)) {
@@ -228,6 +324,7 @@ namespace priv{
 					if(*f->id == id){
 						f->disable();
 						functions.erase(it);
+						publish();
 						break;
 					}
 				}
@@ -235,6 +332,34 @@ namespace priv{
 		};
 		std::shared_ptr<Data> self{new Data};
 
+		// Pins the current listeners for the length of a notify. Notifies
+		// with no listeners don't touch anything but the snapshot pointer.
+		class Snapshot{
+		public:
+			Snapshot(Data & data)
+			:data(data)
+			,functions(nullptr)
+			,entered(data.snapshot.load(std::memory_order_relaxed) != nullptr){
+				if(entered){
+					data.enter();
+					functions = data.snapshot.load(std::memory_order_acquire);
+				}
+			}
+
+			~Snapshot(){
+				if(entered){
+					data.leave();
+				}
+			}
+
+			Snapshot(const Snapshot &) = delete;
+			Snapshot & operator=(const Snapshot &) = delete;
+
+			Data & data;
+			const Functions * functions;
+			bool entered;
+		};
+
 		class EventToken: public AbstractEventToken{
 			public:
 				EventToken() {};
@@ -269,6 +394,7 @@ namespace priv{
 				if((*it)->priority>f->priority) break;
 			}
 			self->functions.emplace(it, f);
+			self->publish();
 		}
 
 		template<typename TFunction>
@@ -279,6 +405,7 @@ namespace priv{
 				if((*it)->priority>f->priority) break;
 			}
 			self->functions.emplace(it, f);
+			self->publish();
 			return make_token(*f);
 		}
 	};
@@ -585,11 +712,9 @@ public:
 	inline bool notify(const void* sender, T & param) {
 		if (ofEvent<T,Mutex>::self->enabled) {
 			ofEvent<T,Mutex>::self->setNotified(true);
-			if (!ofEvent<T,Mutex>::self->functions.empty()) {
-				std::unique_lock<Mutex> lck(ofEvent<T,Mutex>::self->mtx);
-				auto functions_copy = ofEvent<T,Mutex>::self->functions;
-				lck.unlock();
-				for (auto & f: functions_copy) {
+			typename ofEvent<T,Mutex>::Snapshot snapshot(*ofEvent<T,Mutex>::self);
+			if (snapshot.functions) {
+				for (auto & f: *snapshot.functions) {
 					if (f->notify(sender,param)) {
 						return true;
 					}
@@ -742,11 +867,9 @@ public:
 	bool notify(const void* sender){
 		if(ofEvent<void,Mutex>::self->enabled) {
 			ofEvent<void,Mutex>::self->setNotified(true);
-			if (!ofEvent<void,Mutex>::self->functions.empty()) {
-				std::unique_lock<Mutex> lck(ofEvent<void,Mutex>::self->mtx);
-				auto functions_copy = ofEvent<void,Mutex>::self->functions;
-				lck.unlock();
-				for (auto & f: functions_copy) {
+			typename ofEvent<void,Mutex>::Snapshot snapshot(*ofEvent<void,Mutex>::self);
+			if (snapshot.functions) {
+				for (auto & f: *snapshot.functions) {
 					if (f->notify(sender)) {
 						return true;
 					}
@@ -616,6 +616,51 @@ void ofTexture::loadData(const ofFloatPixels & pix){
 	}
 }
 
+//----------------------------------------------------------
+template<typename PixelType>
+static void loadDataFromView(ofTexture & texture, const ofPixelsView_<PixelType> & view){
+	if(!view.isValid()){
+		return;
+	}
+	// pixels wrapping the first row, only used to query formats or when the
+	// view is already packed
+	ofPixels_<PixelType> wrapped;
+	wrapped.setFromExternalPixels(const_cast<PixelType*>(view.getRow(0)), view.getWidth(), view.getHeight(), view.getPixelFormat());
+	if(view.isContiguous()){
+		texture.loadData(wrapped);
+		return;
+	}
+#ifdef GL_UNPACK_ROW_LENGTH
+	size_t stride = view.getStride();
+	size_t bytesPerPixel = view.getBytesPerPixel();
+	if(texture.isAllocated() && view.getNumPlanes() == 1 && stride % bytesPerPixel == 0){
+		ofSetPixelStoreiAlignment(GL_UNPACK_ALIGNMENT, stride);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / bytesPerPixel);
+		texture.loadData(view.getRow(0), view.getWidth(), view.getHeight(), ofGetGLFormat(wrapped), ofGetGLType(wrapped));
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		return;
+	}
+#endif
+	ofPixels_<PixelType> pixels;
+	pixels.setFromPixels(view);
+	texture.loadData(pixels);
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofPixelsView & view){
+	loadDataFromView(*this, view);
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofShortPixelsView & view){
+	loadDataFromView(*this, view);
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofFloatPixelsView & view){
+	loadDataFromView(*this, view);
+}
+
 //----------------------------------------------------------
 void ofTexture::loadData(const ofPixels & pix, int glFormat){
 	if(!isAllocated()){
@@ -21,6 +21,12 @@ typedef ofPixels_<unsigned char> ofPixels;
 typedef ofPixels_<unsigned short> ofShortPixels;
 typedef ofPixels_<float> ofFloatPixels;
 
+template<typename T>
+class ofPixelsView_;
+typedef ofPixelsView_<unsigned char> ofPixelsView;
+typedef ofPixelsView_<unsigned short> ofShortPixelsView;
+typedef ofPixelsView_<float> ofFloatPixelsView;
+
 class ofTexture;
 class ofBufferObject;
 
@@ -531,6 +537,28 @@ class ofTexture : public ofBaseDraws {
 	/// \param pix Reference to ofFloatPixels instance.
 	void loadData(const ofFloatPixels & pix);
 
+	/// \brief Load pixels from an ofPixelsView.
+	///
+	/// Rows are uploaded straight from the memory the view looks at, so a
+	/// crop of a larger frame or a padded buffer doesn't need to be copied
+	/// first, as long as OpenGL can describe its stride. Otherwise, and for
+	/// planar formats, the view is copied into an ofPixels.
+	///
+	/// \param view Reference to ofPixelsView instance.
+	void loadData(const ofPixelsView & view);
+
+	/// \brief Load pixels from an ofShortPixelsView.
+	///
+	/// \sa loadData(const ofPixelsView & view)
+	/// \param view Reference to ofShortPixelsView instance.
+	void loadData(const ofShortPixelsView & view);
+
+	/// \brief Load pixels from an ofFloatPixelsView.
+	///
+	/// \sa loadData(const ofPixelsView & view)
+	/// \param view Reference to ofFloatPixelsView instance.
+	void loadData(const ofFloatPixelsView & view);
+
 	/// \brief Load pixels from an ofPixels instance and specify the format.
 	///
 	/// glFormat can be different to the internal format of the texture on each
@@ -6,7 +6,10 @@
 #include <FreeImage.h>
 
 #include "ofURLFileLoader.h"
+#include "ofThreadChannel.h"
 #include <uriparser/Uri.h>
+#include <atomic>
+#include <thread>
 
 #if defined(TARGET_ANDROID)
 #include "ofxAndroidUtils.h"
@@ -30,15 +33,15 @@ void ofInitFreeImage(bool deinit=false){
 }
 
 template <typename T>
-FREE_IMAGE_TYPE getFreeImageType(const ofPixels_<T>& pix);
+FREE_IMAGE_TYPE getFreeImageType(const ofPixelsView_<T>& pix);
 
 template <>
-FREE_IMAGE_TYPE getFreeImageType(const ofPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofPixelsView& pix) {
 	return FIT_BITMAP;
 }
 
 template <>
-FREE_IMAGE_TYPE getFreeImageType(const ofShortPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofShortPixelsView& pix) {
 	switch(pix.getNumChannels()) {
 		case 1: return FIT_UINT16;
 		case 3: return FIT_RGB16;
@@ -49,7 +52,7 @@ FREE_IMAGE_TYPE getFreeImageType(const ofShortPixels& pix) {
 	}
 }
 template <>
-FREE_IMAGE_TYPE getFreeImageType(const ofFloatPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofFloatPixelsView& pix) {
 	switch(pix.getNumChannels()) {
 		case 1: return FIT_FLOAT;
 		case 3: return FIT_RGBF;
@@ -61,40 +64,63 @@ FREE_IMAGE_TYPE getFreeImageType(const ofFloatPixels& pix) {
 }
 
 //----------------------------------------------------
+/// internal
+/// copies count pixels, swapping red and blue, which turns RGB(A) into the
+/// BGR(A) FreeImage uses on little endian and back
+static void copySwappingRedBlue(const unsigned char * src, unsigned char * dst, size_t count, size_t channels){
+	if(channels == 4){
+		for(size_t i = 0; i < count; i++, src += 4, dst += 4){
+			unsigned char red = src[0];
+			dst[0] = src[2];
+			dst[1] = src[1];
+			dst[2] = red;
+			dst[3] = src[3];
+		}
+	}else{
+		for(size_t i = 0; i < count; i++, src += channels, dst += channels){
+			unsigned char red = src[0];
+			dst[0] = src[2];
+			dst[1] = src[1];
+			dst[2] = red;
+		}
+	}
+}
+
 template<typename PixelType>
-FIBITMAP* getBmpFromPixels(const ofPixels_<PixelType> &pix){
-	const PixelType* pixels = pix.getData();
+FIBITMAP* getBmpFromPixels(const ofPixelsView_<PixelType> &pix, bool swapRedBlue = false){
 	unsigned int width = pix.getWidth();
 	unsigned int height = pix.getHeight();
-    unsigned int bpp = pix.getBitsPerPixel();
+    unsigned int bpp = pix.getBytesPerPixel() * 8;
 
 	FREE_IMAGE_TYPE freeImageType = getFreeImageType(pix);
 	FIBITMAP* bmp = FreeImage_AllocateT(freeImageType, width, height, bpp);
 	unsigned char* bmpBits = FreeImage_GetBits(bmp);
 	if(bmpBits != nullptr) {
+		// ofPixels are top left, FIBITMAP is bottom left, so rows are
+		// copied in reverse order
 		int srcStride = width * pix.getBytesPerPixel();
 		int dstStride = FreeImage_GetPitch(bmp);
-		unsigned char* src = (unsigned char*) pixels;
-		unsigned char* dst = bmpBits;
-		if(srcStride != dstStride){
-			for(int i = 0; i < (int)height; i++) {
-				memcpy(dst, src, srcStride);
-				src += srcStride;
-				dst += dstStride;
+		swapRedBlue = swapRedBlue && sizeof(PixelType) == 1 && pix.getNumChannels() >= 3;
+		for(int i = 0; i < (int)height; i++) {
+			unsigned char * dst = bmpBits + (height - 1 - i) * dstStride;
+			if(swapRedBlue){
+				copySwappingRedBlue((const unsigned char*)pix.getRow(i), dst, width, pix.getNumChannels());
+			}else{
+				memcpy(dst, pix.getRow(i), srcStride);
 			}
-		}else{
-			memcpy(dst,src,dstStride*height);
 		}
 	} else {
 		ofLogError("ofImage") << "getBmpFromPixels(): unable to get FIBITMAP from ofPixels";
 	}
 
-	// ofPixels are top left, FIBITMAP is bottom left
-	FreeImage_FlipVertical(bmp);
-
 	return bmp;
 }
 
+template<typename PixelType>
+FIBITMAP* getBmpFromPixels(const ofPixels_<PixelType> &pix){
+	return getBmpFromPixels(ofPixelsView_<PixelType>(pix));
+}
+
 //----------------------------------------------------
 template<typename PixelType>
 void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType>& pix, bool swapOnLittleEndian = true, bool bUsePassedPixelFormat = false) {
@@ -167,12 +193,40 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType>& pix, bool swapOnLitt
         }
     }
     
-	// ofPixels are top left, FIBITMAP is bottom left
-	FreeImage_FlipVertical(bmp);
+	// 8 bit color is BGR(A) on little endian, when the channels match it's
+	// swapped while copying, so the pixels get the format swapRgb() would
+	// have left them with
+	ofPixelFormat swappedFormat = pixFormat;
+	switch(pixFormat){
+	case OF_PIXELS_RGB: swappedFormat = OF_PIXELS_BGR; break;
+	case OF_PIXELS_BGR: swappedFormat = OF_PIXELS_RGB; break;
+	case OF_PIXELS_RGBA: swappedFormat = OF_PIXELS_BGRA; break;
+	case OF_PIXELS_BGRA: swappedFormat = OF_PIXELS_RGBA; break;
+	default: break;
+	}
+	bool swapWhileCopying = swapRG && channels >= 3 && swappedFormat != pixFormat
+		&& ofPixels_<PixelType>::pixelBitsFromPixelFormat(pixFormat) == bpp;
+	if(swapWhileCopying) {
+		pixFormat = swappedFormat;
+	}
+
+	// allocate() keeps the current buffer when the size doesn't change, so
+	// loading frames of the same size over and over doesn't reallocate
+	pix.allocate(width, height, pixFormat);
 
+	// Flip while copying: ofPixels are top left, FIBITMAP is bottom left
 	unsigned char* bmpBits = FreeImage_GetBits(bmp);
-	if(bmpBits != nullptr) {
-		pix.setFromAlignedPixels((PixelType*) bmpBits, width, height, pixFormat, pitch);
+	if(bmpBits != nullptr && pix.isAllocated()) {
+		size_t rowSize = std::min<size_t>(pix.getBytesStride(), pitch);
+		unsigned char* dst = (unsigned char*) pix.getData();
+		for(unsigned int y = 0; y < height; y++, dst += pix.getBytesStride()) {
+			const unsigned char* src = bmpBits + size_t(height - 1 - y) * pitch;
+			if(swapWhileCopying) {
+				copySwappingRedBlue(src, dst, width, channels);
+			} else {
+				memcpy(dst, src, rowSize);
+			}
+		}
 	} else {
 		ofLogError("ofImage") << "putBmpIntoPixels(): unable to set ofPixels from FIBITMAP";
 	}
@@ -181,7 +235,7 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType>& pix, bool swapOnLitt
 		FreeImage_Unload(bmpConverted);
 	}
 
-    if(swapRG && channels >=3 ) {
+    if(swapRG && channels >=3 && !swapWhileCopying) {
 		pix.swapRgb();
     }
 }
@@ -193,6 +247,9 @@ static int getJpegOptionFromImageLoadSetting(const ofImageLoadSettings &settings
 	if(settings.exifRotate)   option |= JPEG_EXIFROTATE;
 	if(settings.grayscale)    option |= JPEG_GREYSCALE;
 	if(settings.separateCMYK) option |= JPEG_CMYK;
+	// the size hint in the upper 16 bits makes libjpeg decode at 1/2, 1/4
+	// or 1/8 scale
+	if(settings.thumbnailSize > 0) option |= std::min(settings.thumbnailSize, 0xFFFF) << 16;
 	return option;
 }
 
@@ -225,7 +282,7 @@ static bool loadImage(ofPixels_<PixelType> & pix, const of::filesystem::path & _
 	uriFreeUriMembersA(&uri);
 
 	if(scheme == "http" || scheme == "https"){
-		return ofLoadImage(pix, ofLoadURL(ofPathToString(_fileName)).data);
+		return ofLoadImage(pix, ofLoadURL(ofPathToString(_fileName)).data, settings);
 	}
 
 
@@ -438,10 +495,38 @@ bool ofLoadImage(ofTexture & tex, const ofBuffer & buffer, const ofImageLoadSett
 }
 
 //----------------------------------------------------------------
+/// internal
+/// JPEG only stores 8 bit RGB or gray
+static void getJpegPixels(const ofPixelsView & pix, ofPixels & rgb){
+	pix.convertTo(rgb, OF_PIXELS_RGB);
+}
+
 template<typename PixelType>
-static bool saveImage(const ofPixels_<PixelType> & _pix, const of::filesystem::path & _fileName, ofImageQualityType qualityLevel) {
+static void getJpegPixels(const ofPixelsView_<PixelType> & pix, ofPixels & rgb){
+	ofPixels_<PixelType> copy;
+	copy.setFromPixels(pix);
+	rgb = copy;
+	if( rgb.getPixelFormat() == OF_PIXELS_BGRA ){
+		rgb.swapRgb();
+	}
+	rgb.setNumChannels(3);
+}
+
+/// internal
+template<typename PixelType>
+static FIBITMAP * getBmpForSaving(const ofPixelsView_<PixelType> & pix){
+#ifdef TARGET_LITTLE_ENDIAN
+	bool swapRedBlue = sizeof(PixelType) == 1 && (pix.getPixelFormat()==OF_PIXELS_RGB || pix.getPixelFormat()==OF_PIXELS_RGBA);
+#else
+	bool swapRedBlue = false;
+#endif
+	return getBmpFromPixels(pix, swapRedBlue);
+}
+
+template<typename PixelType>
+static bool saveImage(const ofPixelsView_<PixelType> & _pix, const of::filesystem::path & _fileName, ofImageQualityType qualityLevel) {
 	ofInitFreeImage();
-	if (_pix.isAllocated() == false){
+	if (_pix.isValid() == false){
 		ofLogError("ofImage") << "saveImage(): couldn't save " << _fileName << ", pixels are not allocated";
 		return false;
 	}
@@ -462,30 +547,13 @@ static bool saveImage(const ofPixels_<PixelType> & _pix, const of::filesystem::p
 		fif = FreeImage_GetFIFFromFilename(_fileName.extension().c_str());
 #endif
 	}
-	if(fif==FIF_JPEG && (_pix.getNumChannels()==4 || _pix.getBitsPerChannel() > 8)){
-		ofPixels pix3 = _pix;
-        if( pix3.getPixelFormat() == OF_PIXELS_BGRA ){
-            pix3.swapRgb();
-        }
-		pix3.setNumChannels(3);
-		return saveImage(pix3, _fileName, qualityLevel);
+	if(fif==FIF_JPEG && (_pix.getNumChannels()==4 || sizeof(PixelType) > 1)){
+		ofPixels pix3;
+		getJpegPixels(_pix, pix3);
+		return saveImage(ofPixelsView(pix3), _fileName, qualityLevel);
 	}
 
-	FIBITMAP * bmp = nullptr;
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1 && (_pix.getPixelFormat()==OF_PIXELS_RGB || _pix.getPixelFormat()==OF_PIXELS_RGBA)) {	// Make a local copy.
-		ofPixels_<PixelType> pix = _pix;
-		pix.swapRgb();
-		bmp	= getBmpFromPixels(pix);
-	}else{
-	#endif
-
-		bmp	= getBmpFromPixels(_pix);
-
-
-	#ifdef TARGET_LITTLE_ENDIAN
-	}
-	#endif
+	FIBITMAP * bmp = getBmpForSaving(_pix);
 
 	bool retValue = false;
 	if((fif != FIF_UNKNOWN) && FreeImage_FIFSupportsReading(fif)) {
@@ -511,7 +579,7 @@ static bool saveImage(const ofPixels_<PixelType> & _pix, const of::filesystem::p
 
 			if (fif == FIF_GIF) {
 				FIBITMAP* convertedBmp;
-				if(_pix.getImageType() == OF_IMAGE_COLOR_ALPHA) {
+				if(_pix.getNumChannels() == 4) {
 					// this just converts the image to grayscale so it can save something
 					convertedBmp = FreeImage_ConvertTo8Bits(bmp);
 				} else {
@@ -545,56 +613,54 @@ static bool saveImage(const ofPixels_<PixelType> & _pix, const of::filesystem::p
 
 //----------------------------------------------------------------
 bool ofSaveImage(const ofPixels & pix, const of::filesystem::path& fileName, ofImageQualityType qualityLevel){
-	return saveImage(pix,fileName,qualityLevel);
+	return saveImage(ofPixelsView(pix),fileName,qualityLevel);
 }
 
 //----------------------------------------------------------------
 bool ofSaveImage(const ofFloatPixels & pix, const of::filesystem::path& fileName, ofImageQualityType qualityLevel) {
-	return saveImage(pix,fileName,qualityLevel);
+	return saveImage(ofFloatPixelsView(pix),fileName,qualityLevel);
 }
 
 //----------------------------------------------------------------
 bool ofSaveImage(const ofShortPixels & pix, const of::filesystem::path& fileName, ofImageQualityType qualityLevel) {
+	return saveImage(ofShortPixelsView(pix),fileName,qualityLevel);
+}
+
+//----------------------------------------------------------------
+bool ofSaveImage(const ofPixelsView & pix, const of::filesystem::path& fileName, ofImageQualityType qualityLevel){
+	return saveImage(pix,fileName,qualityLevel);
+}
+
+//----------------------------------------------------------------
+bool ofSaveImage(const ofFloatPixelsView & pix, const of::filesystem::path& fileName, ofImageQualityType qualityLevel) {
+	return saveImage(pix,fileName,qualityLevel);
+}
+
+//----------------------------------------------------------------
+bool ofSaveImage(const ofShortPixelsView & pix, const of::filesystem::path& fileName, ofImageQualityType qualityLevel) {
 	return saveImage(pix,fileName,qualityLevel);
 }
 
 //----------------------------------------------------------------
 template<typename PixelType>
-static bool saveImage(const ofPixels_<PixelType> & _pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+static bool saveImage(const ofPixelsView_<PixelType> & _pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
 	// thanks to alvaro casinelli for the implementation
 
 	ofInitFreeImage();
 
-	if (_pix.isAllocated() == false){
+	if (_pix.isValid() == false){
 		ofLogError("ofImage") << "saveImage(): couldn't save to ofBuffer, pixels are not allocated";
 		return false;
 	}
 
-	if(format==OF_IMAGE_FORMAT_JPEG && (_pix.getNumChannels()==4 || _pix.getBitsPerChannel() > 8)){
-		ofPixels pix3 = _pix;
-        if( pix3.getPixelFormat() == OF_PIXELS_BGRA ){
-            pix3.swapRgb();
-        }
-		pix3.setNumChannels(3);
-		return saveImage(pix3,buffer,format,qualityLevel);
+	if(format==OF_IMAGE_FORMAT_JPEG && (_pix.getNumChannels()==4 || sizeof(PixelType) > 1)){
+		ofPixels pix3;
+		getJpegPixels(_pix, pix3);
+		return saveImage(ofPixelsView(pix3),buffer,format,qualityLevel);
 	}
 
 
-	FIBITMAP * bmp = nullptr;
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1 && (_pix.getPixelFormat()==OF_PIXELS_RGB || _pix.getPixelFormat()==OF_PIXELS_RGBA)) {	// Make a local copy.
-		ofPixels_<PixelType> pix = _pix;
-		pix.swapRgb();
-		bmp	= getBmpFromPixels(pix);
-	}else{
-	#endif
-
-		bmp	= getBmpFromPixels(_pix);
-
-
-	#ifdef TARGET_LITTLE_ENDIAN
-	}
-	#endif
+	FIBITMAP * bmp = getBmpForSaving(_pix);
 
 	if (bmp)  // bitmap successfully created
 	{
@@ -660,21 +726,185 @@ static bool saveImage(const ofPixels_<PixelType> & _pix, ofBuffer & buffer, ofIm
 
 //----------------------------------------------------------------
 bool ofSaveImage(const ofPixels & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
-	return saveImage(pix,buffer,format,qualityLevel);
+	return saveImage(ofPixelsView(pix),buffer,format,qualityLevel);
 }
 
 bool ofSaveImage(const ofFloatPixels & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
-	return saveImage(pix,buffer,format,qualityLevel);
+	return saveImage(ofFloatPixelsView(pix),buffer,format,qualityLevel);
 }
 
 bool ofSaveImage(const ofShortPixels & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+	return saveImage(ofShortPixelsView(pix),buffer,format,qualityLevel);
+}
+
+bool ofSaveImage(const ofPixelsView & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
 	return saveImage(pix,buffer,format,qualityLevel);
 }
 
+bool ofSaveImage(const ofFloatPixelsView & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+	return saveImage(pix,buffer,format,qualityLevel);
+}
 
-//----------------------------------------------------
-// freeImage based stuff:
+bool ofSaveImage(const ofShortPixelsView & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+	return saveImage(pix,buffer,format,qualityLevel);
+}
+
+
+//----------------------------------------------------------------
+// Batches
+
+/// internal
+/// Runs function(i) for every index on up to numThreads threads, each
+/// taking the next index as soon as it is done with the last one, so a few
+/// big images don't hold up the rest.
+template<typename Function>
+static void forEachInParallel(size_t count, size_t numThreads, Function function){
+	if(numThreads == 0){
+		numThreads = std::thread::hardware_concurrency();
+	}
+	numThreads = std::max<size_t>(1, std::min(numThreads, count));
+	std::atomic<size_t> next(0);
+	auto work = [&]{
+		for(size_t i = next++; i < count; i = next++){
+			function(i);
+		}
+	};
+	std::vector<std::thread> threads;
+	for(size_t i = 1; i < numThreads; i++){
+		threads.emplace_back(work);
+	}
+	work();
+	for(auto & thread: threads){
+		thread.join();
+	}
+}
+
+template<typename PixelType>
+static std::vector<bool> loadImages(std::vector<ofPixels_<PixelType>> & pixels, const std::vector<of::filesystem::path> & paths, const ofImageLoadSettings & settings, size_t numThreads){
+	// FreeImage has to be initialised before any thread uses it
+	ofInitFreeImage();
+	pixels.resize(paths.size());
+	// not std::vector<bool>, its elements can't be written from different threads
+	std::vector<char> loaded(paths.size(), 0);
+	forEachInParallel(paths.size(), numThreads, [&](size_t i){
+		loaded[i] = loadImage(pixels[i], paths[i], settings);
+	});
+	return std::vector<bool>(loaded.begin(), loaded.end());
+}
+
+template<typename PixelType>
+static std::vector<bool> saveImages(const std::vector<ofPixels_<PixelType>> & pixels, const std::vector<of::filesystem::path> & paths, ofImageQualityType qualityLevel, size_t numThreads){
+	ofInitFreeImage();
+	size_t count = std::min(pixels.size(), paths.size());
+	if(pixels.size() != paths.size()){
+		ofLogWarning("ofImage") << "saveImages(): got " << pixels.size() << " images for " << paths.size() << " paths, saving " << count;
+	}
+	std::vector<char> saved(paths.size(), 0);
+	forEachInParallel(count, numThreads, [&](size_t i){
+		saved[i] = saveImage(ofPixelsView_<PixelType>(pixels[i]), paths[i], qualityLevel);
+	});
+	return std::vector<bool>(saved.begin(), saved.end());
+}
+
+//----------------------------------------------------------------
+std::vector<bool> ofLoadImages(std::vector<ofPixels> & pixels, const std::vector<of::filesystem::path> & paths, const ofImageLoadSettings & settings, size_t numThreads){
+	return loadImages(pixels, paths, settings, numThreads);
+}
+
+//----------------------------------------------------------------
+std::vector<bool> ofLoadImages(std::vector<ofShortPixels> & pixels, const std::vector<of::filesystem::path> & paths, const ofImageLoadSettings & settings, size_t numThreads){
+	return loadImages(pixels, paths, settings, numThreads);
+}
+
+//----------------------------------------------------------------
+std::vector<bool> ofLoadImages(std::vector<ofFloatPixels> & pixels, const std::vector<of::filesystem::path> & paths, const ofImageLoadSettings & settings, size_t numThreads){
+	return loadImages(pixels, paths, settings, numThreads);
+}
+
+//----------------------------------------------------------------
+std::vector<bool> ofSaveImages(const std::vector<ofPixels> & pixels, const std::vector<of::filesystem::path> & paths, ofImageQualityType qualityLevel, size_t numThreads){
+	return saveImages(pixels, paths, qualityLevel, numThreads);
+}
+
+//----------------------------------------------------------------
+std::vector<bool> ofSaveImages(const std::vector<ofShortPixels> & pixels, const std::vector<of::filesystem::path> & paths, ofImageQualityType qualityLevel, size_t numThreads){
+	return saveImages(pixels, paths, qualityLevel, numThreads);
+}
+
+//----------------------------------------------------------------
+std::vector<bool> ofSaveImages(const std::vector<ofFloatPixels> & pixels, const std::vector<of::filesystem::path> & paths, ofImageQualityType qualityLevel, size_t numThreads){
+	return saveImages(pixels, paths, qualityLevel, numThreads);
+}
+
+//----------------------------------------------------------------
+// Background saving
+
+namespace{
+struct SaveJob{
+	ofPixels pixels;
+	of::filesystem::path path;
+	ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST;
+	// empty for the job that stops the thread
+	std::shared_ptr<std::promise<bool>> saved;
+};
+
+/// One thread that saves images in the order they were queued. It is only
+/// started by the first ofSaveImageAsync call.
+class BackgroundSaver{
+public:
+	void send(SaveJob && job){
+		std::unique_lock<std::mutex> lock(mutex);
+		if(!thread.joinable()){
+			thread = std::thread([this]{
+				SaveJob job;
+				while(jobs.receive(job) && job.saved){
+					job.saved->set_value(ofSaveImage(job.pixels, job.path, job.qualityLevel));
+					job = SaveJob();
+				}
+			});
+		}
+		jobs.send(std::move(job));
+	}
+
+	/// Waits until everything queued so far is saved.
+	void finish(){
+		std::unique_lock<std::mutex> lock(mutex);
+		if(thread.joinable()){
+			jobs.send(SaveJob());
+			thread.join();
+		}
+	}
+
+private:
+	ofThreadChannel<SaveJob> jobs;
+	std::thread thread;
+	std::mutex mutex;
+};
+
+BackgroundSaver & getBackgroundSaver(){
+	// never deleted, like the FreeImage flag, so saving works until the end
+	static BackgroundSaver * saver = new BackgroundSaver;
+	return *saver;
+}
+}
+
+//----------------------------------------------------------------
+std::future<bool> ofSaveImageAsync(ofPixels pix, const of::filesystem::path & path, ofImageQualityType qualityLevel){
+	ofInitFreeImage();
+	SaveJob job;
+	job.pixels = std::move(pix);
+	job.path = path;
+	job.qualityLevel = qualityLevel;
+	job.saved = std::make_shared<std::promise<bool>>();
+	auto saved = job.saved->get_future();
+	getBackgroundSaver().send(std::move(job));
+	return saved;
+}
+
+//----------------------------------------------------------------
 void ofCloseFreeImage(){
+	// images still waiting to be saved need FreeImage
+	getBackgroundSaver().finish();
 	ofInitFreeImage(true);
 }
 
@@ -5,6 +5,7 @@
 #include "ofGraphicsConstants.h"
 #include "ofGLUtils.h"
 #include "ofPixels.h"
+#include <future>
 
 class ofFile;
 class ofBuffer;
@@ -124,6 +125,13 @@ struct ofImageLoadSettings {
 	bool exifRotate = false;
 	bool grayscale = false;
 	bool separateCMYK = false;
+	/// \brief Decode JPEGs at 1/2, 1/4 or 1/8 of their size, the smallest
+	/// that keeps the longer side at least this many pixels. 0 decodes at
+	/// full size.
+	///
+	/// The scaling happens inside the JPEG decoder, which makes it a lot
+	/// faster than decoding the full image and resizing it for thumbnails.
+	int thumbnailSize = 0;
     int freeImageFlags = 0;
 };
 
@@ -156,9 +164,54 @@ bool ofSaveImage(const ofFloatPixels & pix, ofBuffer & buffer, ofImageFormat for
 bool ofSaveImage(const ofShortPixels & pix, const of::filesystem::path& path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 bool ofSaveImage(const ofShortPixels & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 
+/// \brief Save the pixels a view looks at, e.g. a region of a frame,
+/// without copying them into an ofPixels first.
+bool ofSaveImage(const ofPixelsView & pix, const of::filesystem::path& path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+bool ofSaveImage(const ofPixelsView & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+bool ofSaveImage(const ofFloatPixelsView & pix, const of::filesystem::path& path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+bool ofSaveImage(const ofFloatPixelsView & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+bool ofSaveImage(const ofShortPixelsView & pix, const of::filesystem::path& path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+bool ofSaveImage(const ofShortPixelsView & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+
+/// \brief Load several images, decoding them on numThreads threads.
+///
+/// pixels is resized to paths.size(). Pixels already in it keep their
+/// memory when the new image has the same size, so loading a sequence of
+/// frames into the same vector again doesn't reallocate.
+///
+/// \param numThreads 0 uses one thread per core.
+/// \returns Whether each image loaded, in the order of paths.
+std::vector<bool> ofLoadImages(std::vector<ofPixels> & pixels, const std::vector<of::filesystem::path> & paths, const ofImageLoadSettings & settings = ofImageLoadSettings(), size_t numThreads = 0);
+std::vector<bool> ofLoadImages(std::vector<ofShortPixels> & pixels, const std::vector<of::filesystem::path> & paths, const ofImageLoadSettings & settings = ofImageLoadSettings(), size_t numThreads = 0);
+std::vector<bool> ofLoadImages(std::vector<ofFloatPixels> & pixels, const std::vector<of::filesystem::path> & paths, const ofImageLoadSettings & settings = ofImageLoadSettings(), size_t numThreads = 0);
+
+/// \brief Save several images, encoding them on numThreads threads.
+///
+/// \param numThreads 0 uses one thread per core.
+/// \returns Whether each image was saved, in the order of paths.
+std::vector<bool> ofSaveImages(const std::vector<ofPixels> & pixels, const std::vector<of::filesystem::path> & paths, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST, size_t numThreads = 0);
+std::vector<bool> ofSaveImages(const std::vector<ofShortPixels> & pixels, const std::vector<of::filesystem::path> & paths, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST, size_t numThreads = 0);
+std::vector<bool> ofSaveImages(const std::vector<ofFloatPixels> & pixels, const std::vector<of::filesystem::path> & paths, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST, size_t numThreads = 0);
+
+/// \brief Save an image on a background thread.
+///
+/// The pixels are moved or copied into the queue, so the caller can reuse
+/// its own right away. Images are saved one after another in the order
+/// they were queued, and everything queued is saved before the app exits.
+/// Unlike std::async, the returned future doesn't block when it is
+/// dropped.
+///
+/// ~~~~{.cpp}
+/// ofSaveImageAsync(camera.getPixels(), "frame.png");
+/// ~~~~
+///
+/// \returns A future that becomes true once the image is saved.
+std::future<bool> ofSaveImageAsync(ofPixels pix, const of::filesystem::path & path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+
 /// \brief Deallocates FreeImage resources.
 ///
-/// Used internally during shutdown.
+/// Used internally during shutdown. Waits for images queued with
+/// ofSaveImageAsync first.
 void ofCloseFreeImage();
 
 /// \brief A class representing an image using memory and gpu based pixels.
@@ -1,6 +1,15 @@
 #include "ofGraphicsConstants.h"
 #include "ofPixels.h"
 #include "ofColor.h"
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define OF_PIXELS_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#include <arm_neon.h>
+	#define OF_PIXELS_NEON
+#endif
 
 static ofImageType getImageTypeFromChannels(size_t channels){
 	switch(channels){
@@ -173,6 +182,72 @@ static size_t channelsFromPixelFormat(ofPixelFormat format){
 	}
 }
 
+static size_t numPlanesFromPixelFormat(ofPixelFormat format){
+	switch(format){
+	case OF_PIXELS_RGB:
+	case OF_PIXELS_BGR:
+	case OF_PIXELS_RGB565:
+	case OF_PIXELS_RGBA:
+	case OF_PIXELS_BGRA:
+	case OF_PIXELS_GRAY:
+	case OF_PIXELS_GRAY_ALPHA:
+	case OF_PIXELS_YUY2:
+	case OF_PIXELS_UYVY:
+	case OF_PIXELS_Y:
+	case OF_PIXELS_U:
+	case OF_PIXELS_V:
+	case OF_PIXELS_UV:
+	case OF_PIXELS_VU:
+		return 1;
+	case OF_PIXELS_NV12:
+	case OF_PIXELS_NV21:
+		return 2;
+	case OF_PIXELS_YV12:
+	case OF_PIXELS_I420:
+		return 3;
+	case OF_PIXELS_NUM_FORMATS:
+	case OF_PIXELS_NATIVE:
+	case OF_PIXELS_UNKNOWN:
+		return 0;
+	}
+	return 0;
+}
+
+/// \brief The format of one plane of a frame, and how many times smaller
+/// than the frame it is in each direction, as a shift.
+struct PlaneFormat{
+	ofPixelFormat format;
+	size_t shift;
+};
+
+static PlaneFormat planeFormatFromPixelFormat(ofPixelFormat format, size_t plane){
+	switch(format){
+	case OF_PIXELS_NV12:
+		return plane == 0 ? PlaneFormat{OF_PIXELS_Y, 0} : PlaneFormat{OF_PIXELS_UV, 1};
+	case OF_PIXELS_NV21:
+		return plane == 0 ? PlaneFormat{OF_PIXELS_Y, 0} : PlaneFormat{OF_PIXELS_VU, 1};
+	case OF_PIXELS_I420:
+		return plane == 0 ? PlaneFormat{OF_PIXELS_Y, 0} : PlaneFormat{plane == 1 ? OF_PIXELS_U : OF_PIXELS_V, 1};
+	case OF_PIXELS_YV12:
+		return plane == 0 ? PlaneFormat{OF_PIXELS_Y, 0} : PlaneFormat{plane == 1 ? OF_PIXELS_V : OF_PIXELS_U, 1};
+	default:
+		return PlaneFormat{format, 0};
+	}
+}
+
+static size_t pixelsSizeFromPixelFormat(size_t w, size_t h, ofPixelFormat format){
+	switch(format){
+	// a full resolution Y plane and two quarter resolution chroma planes
+	case OF_PIXELS_NV12:
+	case OF_PIXELS_NV21:
+	case OF_PIXELS_YV12:
+	case OF_PIXELS_I420:
+		return w * h + (w / 2) * (h / 2) * 2;
+	default:
+		return w * h * channelsFromPixelFormat(format);
+	}
+}
+
 static ofPixelFormat ofPixelFormatFromImageType(ofImageType type){
 	switch(type){
 	case OF_IMAGE_GRAYSCALE:
@@ -398,7 +473,7 @@ void ofPixels_<PixelType>::setFromExternalPixels(PixelType * newPixels, size_t w
 	width = w;
 	height = h;
 
-	pixelsSize = w * h * getNumChannels();
+	pixelsSize = pixelsSizeFromPixelFormat(w, h, pixelFormat);
 
 	pixels = newPixels;
 	pixelsOwner = false;
@@ -484,6 +559,33 @@ void ofPixels_<PixelType>::setFromAlignedPixels(const PixelType * newPixels, siz
 	return;
 }
 
+template<typename PixelType>
+void ofPixels_<PixelType>::setFromPixels(const ofPixelsView_<PixelType> & view){
+	if(!view.isValid()) return;
+
+	if(view.overlaps(*this)){
+		ofPixels_<PixelType> copy;
+		copy.setFromPixels(view);
+		swap(copy);
+		return;
+	}
+
+	if(view.isContiguous()){
+		setFromPixels(view.getRow(0), view.getWidth(), view.getHeight(), view.getPixelFormat());
+		return;
+	}
+
+	allocate(view.getWidth(), view.getHeight(), view.getPixelFormat());
+	ofPixelsView_<PixelType> packed(*this);
+	for(size_t plane = 0; plane < view.getNumPlanes(); plane++){
+		size_t rows = view.getHeight() >> planeFormatFromPixelFormat(pixelFormat, plane).shift;
+		size_t rowBytes = packed.getStride(plane);
+		for(size_t y = 0; y < rows; y++){
+			memcpy(const_cast<PixelType*>(packed.getRow(y, plane)), view.getRow(y, plane), rowBytes);
+		}
+	}
+}
+
 template<typename PixelType>
 PixelType * ofPixels_<PixelType>::getPixels(){
 	return pixels;
@@ -522,6 +624,7 @@ void ofPixels_<PixelType>::allocate(size_t w, size_t h, ofPixelFormat format){
 		pixelFormat = format;
 		width = w;
 		height = h;
+		pixelsSize = pixelsSizeFromPixelFormat(w, h, format);
 		return; //we don't need to allocate
 	}
 
@@ -532,7 +635,7 @@ void ofPixels_<PixelType>::allocate(size_t w, size_t h, ofPixelFormat format){
 	width 		= w;
 	height 		= h;
 
-	pixelsSize = w * h * getNumChannels();
+	pixelsSize = pixelsSizeFromPixelFormat(w, h, pixelFormat);
 
 	// we have some incongruence here, if we use PixelType
 	// we are not able to use RGB565 format
@@ -844,34 +947,7 @@ size_t ofPixels_<PixelType>::getTotalBytes() const{
 
 template<typename PixelType>
 size_t ofPixels_<PixelType>::getNumPlanes() const{
-	switch(pixelFormat){
-		case OF_PIXELS_RGB:
-		case OF_PIXELS_BGR:
-		case OF_PIXELS_RGB565:
-		case OF_PIXELS_RGBA:
-		case OF_PIXELS_BGRA:
-		case OF_PIXELS_GRAY:
-		case OF_PIXELS_GRAY_ALPHA:
-		case OF_PIXELS_YUY2:
-		case OF_PIXELS_UYVY:
-		case OF_PIXELS_Y:
-		case OF_PIXELS_U:
-		case OF_PIXELS_V:
-		case OF_PIXELS_UV:
-		case OF_PIXELS_VU:
-			return 1;
-		case OF_PIXELS_NV12:
-		case OF_PIXELS_NV21:
-			return 2;
-		case OF_PIXELS_YV12:
-		case OF_PIXELS_I420:
-			return 3;
-		case OF_PIXELS_NUM_FORMATS:
-		case OF_PIXELS_NATIVE:
-		case OF_PIXELS_UNKNOWN:
-			return 0;
-	}
-	return 0;
+	return numPlanesFromPixelFormat(pixelFormat);
 }
 
 template<typename PixelType>
@@ -957,30 +1033,7 @@ ofImageType ofPixels_<PixelType>::getImageType() const{
 template<typename PixelType>
 void ofPixels_<PixelType>::setImageType(ofImageType imageType){
 	if(!isAllocated() || imageType==getImageType()) return;
-	ofPixels_<PixelType> dst;
-	dst.allocate(width,height,imageType);
-	PixelType * dstPtr = &dst[0];
-	PixelType * srcPtr = &pixels[0];
-	size_t dstNumChannels = dst.getNumChannels();
-	size_t srcNumChannels = getNumChannels();
-	size_t diffNumChannels = 0;
-	if(dstNumChannels<srcNumChannels){
-		diffNumChannels = srcNumChannels-dstNumChannels;
-	}
-	for(size_t i=0;i<width*height;i++){
-		const PixelType & gray = *srcPtr;
-		for(size_t j=0;j<dstNumChannels;j++){
-			if(j<srcNumChannels){
-				*dstPtr++ =  *srcPtr++;
-			}else if(j<3){
-				*dstPtr++ = gray;
-			}else{
-				*dstPtr++ = ofColor_<PixelType>::limit();
-			}
-		}
-		srcPtr+=diffNumChannels;
-	}
-	swap(dst);
+	convertTo(*this, ofPixelFormatFromImageType(imageType));
 }
 
 template<typename PixelType>
@@ -1259,15 +1312,443 @@ void ofPixels_<PixelType>::mirrorTo(ofPixels_<PixelType> & dst, bool vertically,
 }
 
 //----------------------------------------------------------------------
+// Resampling
+//
+// Resizes are separable: every output pixel of a row is a weighted sum of
+// a few neighbouring source pixels, and every output row a weighted sum of
+// a few of those horizontally resampled rows. The taps and weights only
+// depend on the position, so they are worked out once per column and once
+// per row instead of once per pixel and channel.
+namespace{
+
+struct ResampleWeights{
+	std::vector<size_t> start;   // first source pixel for each output pixel
+	std::vector<float> weights;  // taps weights per output pixel, zero padded
+	size_t taps = 0;
+};
+
+float triangleFilter(float x){
+	x = std::abs(x);
+	return x < 1.f ? 1.f - x : 0.f;
+}
+
+// Keys' cubic convolution with a = -0.5 (Catmull-Rom)
+float cubicFilter(float x){
+	const float a = -0.5f;
+	x = std::abs(x);
+	if(x < 1.f){
+		return ((a + 2.f) * x - (a + 3.f)) * x * x + 1.f;
+	}else if(x < 2.f){
+		return ((a * x - 5.f * a) * x + 8.f * a) * x - 4.f * a;
+	}
+	return 0.f;
+}
+
+ResampleWeights computeWeights(size_t srcSize, size_t dstSize, ofInterpolationMethod method){
+	float scale = float(srcSize) / float(dstSize);
+	if(method == OF_INTERPOLATE_AREA && scale <= 1.f){
+		method = OF_INTERPOLATE_BILINEAR;
+	}
+
+	// Shrinking stretches the filter over every source pixel an output
+	// pixel covers
+	float filterScale = std::max(scale, 1.f);
+	float support;
+	switch(method){
+	case OF_INTERPOLATE_AREA:
+		support = 0.5f * scale;
+		break;
+	case OF_INTERPOLATE_BICUBIC:
+		support = 2.f * filterScale;
+		break;
+	default:
+		support = filterScale;
+		break;
+	}
+
+	// The normalized weights of each output pixel, without the zeros at
+	// either end
+	std::vector<size_t> firsts(dstSize);
+	std::vector<std::vector<float>> allWeights(dstSize);
+	size_t taps = 1;
+	for(size_t i = 0; i < dstSize; i++){
+		float center = (i + 0.5f) * scale;
+		long first = std::max(0L, long(std::floor(center - support)));
+		long last = std::min(long(srcSize), long(std::ceil(center + support)));
+
+		std::vector<float> & weights = allWeights[i];
+		float sum = 0;
+		for(long j = first; j < last; j++){
+			float weight;
+			switch(method){
+			case OF_INTERPOLATE_AREA:
+				// how much of the source pixel the output pixel covers
+				weight = std::max(0.f, std::min(j + 1.f, center + support) - std::max(float(j), center - support));
+				break;
+			case OF_INTERPOLATE_BICUBIC:
+				weight = cubicFilter((j + 0.5f - center) / filterScale);
+				break;
+			default:
+				weight = triangleFilter((j + 0.5f - center) / filterScale);
+				break;
+			}
+			if(weights.empty() && weight == 0.f){
+				first++;
+				continue;
+			}
+			weights.push_back(weight);
+			sum += weight;
+		}
+		while(!weights.empty() && weights.back() == 0.f){
+			weights.pop_back();
+		}
+		for(auto & weight: weights){
+			weight = sum != 0 ? weight / sum : 0.f;
+		}
+		if(weights.empty()){
+			first = std::min(long(srcSize) - 1, std::max(0L, long(center)));
+			weights.push_back(1.f);
+		}
+		firsts[i] = first;
+		taps = std::max(taps, weights.size());
+	}
+
+	ResampleWeights result;
+	result.taps = std::min(taps, srcSize);
+	result.start.resize(dstSize);
+	result.weights.assign(dstSize * result.taps, 0.f);
+	for(size_t i = 0; i < dstSize; i++){
+		// Keep all taps inside the image, so the inner loops never check
+		size_t start = std::min(firsts[i], srcSize - result.taps);
+		float * dst = &result.weights[i * result.taps + firsts[i] - start];
+		std::copy(allWeights[i].begin(), allWeights[i].end(), dst);
+		result.start[i] = start;
+	}
+	return result;
+}
+
+// Horizontal pass, one source row into dstWidth float pixels. The channel
+// count is a template parameter for the common formats so the inner loops
+// unroll.
+template<size_t Channels, typename PixelType>
+void resampleRow(const PixelType * src, float * dst, const ResampleWeights & columns, size_t dstWidth, size_t){
+	const size_t taps = columns.taps;
+	const float * weights = columns.weights.data();
+	for(size_t x = 0; x < dstWidth; x++, weights += taps, dst += Channels){
+		const PixelType * s = src + columns.start[x] * Channels;
+		float sum[Channels] = {};
+		for(size_t k = 0; k < taps; k++, s += Channels){
+			for(size_t c = 0; c < Channels; c++){
+				sum[c] += weights[k] * s[c];
+			}
+		}
+		for(size_t c = 0; c < Channels; c++){
+			dst[c] = sum[c];
+		}
+	}
+}
+
+#if defined(OF_PIXELS_SSE) || defined(OF_PIXELS_NEON)
+// Horizontal pass over float rows of 3 or 4 channels, one pixel per
+// vector. With 3 channels every load and store also touches the next
+// pixel's first channel, so both rows need one float of padding.
+template<size_t Channels>
+void resampleRowSimd(const float * src, float * dst, const ResampleWeights & columns, size_t dstWidth, size_t){
+	const size_t taps = columns.taps;
+	const float * weights = columns.weights.data();
+	for(size_t x = 0; x < dstWidth; x++, weights += taps, dst += Channels){
+		const float * s = src + columns.start[x] * Channels;
+#if defined(OF_PIXELS_SSE)
+		__m128 sum = _mm_setzero_ps();
+		for(size_t k = 0; k < taps; k++, s += Channels){
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(s)));
+		}
+		_mm_storeu_ps(dst, sum);
+#else
+		float32x4_t sum = vdupq_n_f32(0.f);
+		for(size_t k = 0; k < taps; k++, s += Channels){
+			sum = vmlaq_n_f32(sum, vld1q_f32(s), weights[k]);
+		}
+		vst1q_f32(dst, sum);
+#endif
+	}
+}
+#endif
+
 template<typename PixelType>
-bool ofPixels_<PixelType>::resize(size_t dstWidth, size_t dstHeight, ofInterpolationMethod interpMethod){
+void resampleRowAnyChannels(const PixelType * src, float * dst, const ResampleWeights & columns, size_t dstWidth, size_t channels){
+	const size_t taps = columns.taps;
+	const float * weights = columns.weights.data();
+	for(size_t x = 0; x < dstWidth; x++, weights += taps, dst += channels){
+		const PixelType * s = src + columns.start[x] * channels;
+		for(size_t c = 0; c < channels; c++){
+			float sum = 0;
+			for(size_t k = 0; k < taps; k++){
+				sum += weights[k] * s[k * channels + c];
+			}
+			dst[c] = sum;
+		}
+	}
+}
+
+// Four consecutive values as floats
+#if defined(OF_PIXELS_SSE)
+template<typename SrcType>
+inline __m128 load4(const SrcType * src){
+	return _mm_setr_ps(float(src[0]), float(src[1]), float(src[2]), float(src[3]));
+}
+
+inline __m128 load4(const float * src){
+	return _mm_loadu_ps(src);
+}
+
+inline __m128 load4(const unsigned char * src){
+	int32_t packed;
+	memcpy(&packed, src, 4);
+	__m128i bytes = _mm_cvtsi32_si128(packed);
+	__m128i zero = _mm_setzero_si128();
+	return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero));
+}
+
+inline __m128 load4(const unsigned short * src){
+	__m128i shorts = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+	return _mm_cvtepi32_ps(_mm_unpacklo_epi16(shorts, _mm_setzero_si128()));
+}
+#elif defined(OF_PIXELS_NEON)
+template<typename SrcType>
+inline float32x4_t load4(const SrcType * src){
+	float values[4] = {float(src[0]), float(src[1]), float(src[2]), float(src[3])};
+	return vld1q_f32(values);
+}
+
+inline float32x4_t load4(const float * src){
+	return vld1q_f32(src);
+}
+
+inline float32x4_t load4(const unsigned char * src){
+	uint8_t bytes[8] = {src[0], src[1], src[2], src[3]};
+	return vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(vld1_u8(bytes)))));
+}
+
+inline float32x4_t load4(const unsigned short * src){
+	return vcvtq_f32_u32(vmovl_u16(vld1_u16(src)));
+}
+#endif
+
+// Vertical pass: dst = sum of weights[k] * rows[k], over a whole row of
+// interleaved channels at once
+template<typename SrcType>
+void resampleColumns(const SrcType * const * rows, const float * weights, size_t taps, float * dst, size_t count){
+	size_t i = 0;
+#if defined(OF_PIXELS_SSE)
+	for(; i + 4 <= count; i += 4){
+		__m128 sum = _mm_setzero_ps();
+		for(size_t k = 0; k < taps; k++){
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), load4(rows[k] + i)));
+		}
+		_mm_storeu_ps(dst + i, sum);
+	}
+#elif defined(OF_PIXELS_NEON)
+	for(; i + 4 <= count; i += 4){
+		float32x4_t sum = vdupq_n_f32(0.f);
+		for(size_t k = 0; k < taps; k++){
+			sum = vmlaq_n_f32(sum, load4(rows[k] + i), weights[k]);
+		}
+		vst1q_f32(dst + i, sum);
+	}
+#endif
+	for(; i < count; i++){
+		float sum = 0;
+		for(size_t k = 0; k < taps; k++){
+			sum += weights[k] * rows[k][i];
+		}
+		dst[i] = sum;
+	}
+}
+
+#if defined(OF_PIXELS_SSE)
+// 8 bit rows are converted 16 values at a time, the most common case
+void resampleColumns(const unsigned char * const * rows, const float * weights, size_t taps, float * dst, size_t count){
+	size_t i = 0;
+	__m128i zero = _mm_setzero_si128();
+	for(; i + 16 <= count; i += 16){
+		__m128 sum0 = _mm_setzero_ps();
+		__m128 sum1 = _mm_setzero_ps();
+		__m128 sum2 = _mm_setzero_ps();
+		__m128 sum3 = _mm_setzero_ps();
+		for(size_t k = 0; k < taps; k++){
+			__m128 weight = _mm_set1_ps(weights[k]);
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k] + i));
+			__m128i low = _mm_unpacklo_epi8(bytes, zero);
+			__m128i high = _mm_unpackhi_epi8(bytes, zero);
+			sum0 = _mm_add_ps(sum0, _mm_mul_ps(weight, _mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero))));
+			sum1 = _mm_add_ps(sum1, _mm_mul_ps(weight, _mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero))));
+			sum2 = _mm_add_ps(sum2, _mm_mul_ps(weight, _mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero))));
+			sum3 = _mm_add_ps(sum3, _mm_mul_ps(weight, _mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero))));
+		}
+		_mm_storeu_ps(dst + i, sum0);
+		_mm_storeu_ps(dst + i + 4, sum1);
+		_mm_storeu_ps(dst + i + 8, sum2);
+		_mm_storeu_ps(dst + i + 12, sum3);
+	}
+	for(; i < count; i++){
+		float sum = 0;
+		for(size_t k = 0; k < taps; k++){
+			sum += weights[k] * rows[k][i];
+		}
+		dst[i] = sum;
+	}
+}
+#endif
+
+// Rounds and clamps integer types, cubic filters overshoot
+template<typename PixelType>
+void storeRow(const float * src, PixelType * dst, size_t count){
+	if(std::is_floating_point<PixelType>::value){
+		for(size_t i = 0; i < count; i++){
+			dst[i] = PixelType(src[i]);
+		}
+	}else if(std::is_unsigned<PixelType>::value && sizeof(PixelType) <= 2){
+		const float maxValue = float(std::numeric_limits<PixelType>::max());
+		for(size_t i = 0; i < count; i++){
+			dst[i] = PixelType(std::min(std::max(src[i] + 0.5f, 0.f), maxValue));
+		}
+	}else{
+		const double minValue = double(std::numeric_limits<PixelType>::lowest());
+		const double maxValue = double(std::numeric_limits<PixelType>::max());
+		for(size_t i = 0; i < count; i++){
+			dst[i] = PixelType(std::min(std::max(std::floor(src[i] + 0.5), minValue), maxValue));
+		}
+	}
+}
+
+#if defined(OF_PIXELS_SSE)
+template<>
+void storeRow<unsigned char>(const float * src, unsigned char * dst, size_t count){
+	size_t i = 0;
+	for(; i + 16 <= count; i += 16){
+		// round to nearest, then saturate down to 16 and 8 bits
+		__m128i a = _mm_cvtps_epi32(_mm_loadu_ps(src + i));
+		__m128i b = _mm_cvtps_epi32(_mm_loadu_ps(src + i + 4));
+		__m128i c = _mm_cvtps_epi32(_mm_loadu_ps(src + i + 8));
+		__m128i d = _mm_cvtps_epi32(_mm_loadu_ps(src + i + 12));
+		__m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), bytes);
+	}
+	for(; i < count; i++){
+		dst[i] = (unsigned char)(std::min(std::max(src[i] + 0.5f, 0.f), 255.f));
+	}
+}
+#endif
+
+template<typename Function>
+void parallelRows(size_t rows, size_t numThreads, Function function){
+	// Fewer than a few rows each isn't worth starting a thread for
+	numThreads = std::max<size_t>(1, std::min(numThreads, rows / 8));
+	if(numThreads == 1){
+		function(0, rows);
+		return;
+	}
+	std::vector<std::thread> threads;
+	size_t rowsPerThread = (rows + numThreads - 1) / numThreads;
+	for(size_t begin = rowsPerThread; begin < rows; begin += rowsPerThread){
+		threads.emplace_back(function, begin, std::min(rows, begin + rowsPerThread));
+	}
+	function(0, rowsPerThread);
+	for(auto & thread: threads){
+		thread.join();
+	}
+}
+
+template<typename PixelType>
+void resample(const ofPixelsView_<PixelType> & src, PixelType * dst, size_t dstWidth, size_t dstHeight, size_t channels, ofInterpolationMethod method, size_t numThreads){
+	size_t srcWidth = src.getWidth();
+	size_t srcHeight = src.getHeight();
+	ResampleWeights columns = computeWeights(srcWidth, dstWidth, method);
+	ResampleWeights rows = computeWeights(srcHeight, dstHeight, method);
+
+	// Only the source rows some output row reads from
+	size_t firstRow = rows.start.front();
+	size_t lastRow = rows.start.back() + rows.taps;
+
+	size_t srcRowSize = srcWidth * channels;
+	size_t dstRowSize = dstWidth * channels;
+
+	// Whichever order does less work: shrinking vertically first leaves
+	// fewer rows for the horizontal pass, which is the slower one
+	float horizontalFirst = float(srcHeight) * dstRowSize * columns.taps + float(dstHeight) * dstRowSize * rows.taps / 4;
+	float verticalFirst = float(dstHeight) * (srcRowSize * rows.taps / 4 + dstRowSize * columns.taps);
+
+	if(verticalFirst < horizontalFirst){
+		auto resampleRowFunction = resampleRowAnyChannels<float>;
+		switch(channels){
+		case 1: resampleRowFunction = resampleRow<1,float>; break;
+		case 2: resampleRowFunction = resampleRow<2,float>; break;
+#if defined(OF_PIXELS_SSE) || defined(OF_PIXELS_NEON)
+		case 3: resampleRowFunction = resampleRowSimd<3>; break;
+		case 4: resampleRowFunction = resampleRowSimd<4>; break;
+#else
+		case 3: resampleRowFunction = resampleRow<3,float>; break;
+		case 4: resampleRowFunction = resampleRow<4,float>; break;
+#endif
+		}
+
+		parallelRows(dstHeight, numThreads, [&](size_t begin, size_t end){
+			std::vector<const PixelType*> rowPointers(rows.taps);
+			std::vector<float> vertical(srcRowSize + 1);
+			std::vector<float> row(dstRowSize + 1);
+			for(size_t y = begin; y < end; y++){
+				for(size_t k = 0; k < rows.taps; k++){
+					rowPointers[k] = src.getRow(rows.start[y] + k);
+				}
+				resampleColumns(rowPointers.data(), &rows.weights[y * rows.taps], rows.taps, vertical.data(), srcRowSize);
+				resampleRowFunction(vertical.data(), row.data(), columns, dstWidth, channels);
+				storeRow(row.data(), dst + y * dstRowSize, dstRowSize);
+			}
+		});
+		return;
+	}
+
+	auto resampleRowFunction = resampleRowAnyChannels<PixelType>;
+	switch(channels){
+	case 1: resampleRowFunction = resampleRow<1,PixelType>; break;
+	case 2: resampleRowFunction = resampleRow<2,PixelType>; break;
+	case 3: resampleRowFunction = resampleRow<3,PixelType>; break;
+	case 4: resampleRowFunction = resampleRow<4,PixelType>; break;
+	}
+
+	std::vector<float> horizontal((lastRow - firstRow) * dstRowSize);
+	parallelRows(lastRow - firstRow, numThreads, [&](size_t begin, size_t end){
+		for(size_t y = begin; y < end; y++){
+			resampleRowFunction(src.getRow(firstRow + y), &horizontal[y * dstRowSize], columns, dstWidth, channels);
+		}
+	});
+
+	parallelRows(dstHeight, numThreads, [&](size_t begin, size_t end){
+		std::vector<const float*> rowPointers(rows.taps);
+		std::vector<float> row(dstRowSize);
+		for(size_t y = begin; y < end; y++){
+			for(size_t k = 0; k < rows.taps; k++){
+				rowPointers[k] = &horizontal[(rows.start[y] + k - firstRow) * dstRowSize];
+			}
+			resampleColumns(rowPointers.data(), &rows.weights[y * rows.taps], rows.taps, row.data(), dstRowSize);
+			storeRow(row.data(), dst + y * dstRowSize, dstRowSize);
+		}
+	});
+}
+
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixels_<PixelType>::resize(size_t dstWidth, size_t dstHeight, ofInterpolationMethod interpMethod, size_t numThreads){
 
 	if ((dstWidth == 0) || (dstHeight == 0) || !(isAllocated())) return false;
 
 	ofPixels_<PixelType> dstPixels;
 	dstPixels.allocate(dstWidth, dstHeight, getPixelFormat());
 
-	if(!resizeTo(dstPixels,interpMethod)) return false;
+	if(!resizeTo(dstPixels,interpMethod,numThreads)) return false;
 
 	delete [] pixels;
 	pixels = dstPixels.getData();
@@ -1280,75 +1761,37 @@ bool ofPixels_<PixelType>::resize(size_t dstWidth, size_t dstHeight, ofInterpola
 
 //----------------------------------------------------------------------
 template<typename PixelType>
-float ofPixels_<PixelType>::bicubicInterpolate (const float *patch, float x,float y, float x2,float y2, float x3,float y3) {
-	// adapted from http://www.paulinternet.nl/?page=bicubic
-	// Note that this code can produce values outside of 0...255, due to cubic overshoot.
-	// The ofClamp() prevents this from happening.
-
-	float p00 = patch[ 0];
-	float p10 = patch[ 4];
-	float p20 = patch[ 8];
-	float p30 = patch[12];
-
-	float p01 = patch[ 1];
-	float p11 = patch[ 5];
-	float p21 = patch[ 9];
-	float p31 = patch[13];
-
-	float p02 = patch[ 2];
-	float p12 = patch[ 6];
-	float p22 = patch[10];
-	float p32 = patch[14];
-
-	float p03 = patch[ 3];
-	float p13 = patch[ 7];
-	float p23 = patch[11];
-	float p33 = patch[15];
-
-	float a00 =    p11;
-	float a01 =   -p10 +   p12;
-	float a02 =  2.0f*p10 - 2.0f*p11 +   p12 -   p13;
-	float a03 =   -p10 +   p11 -   p12 +   p13;
-	float a10 =   -p01 +   p21;
-	float a11 =    p00 -   p02 -   p20 +   p22;
-	float a12 = -2.0f*p00 + 2.0f*p01 -   p02 +   p03 + 2.0f*p20 - 2.0f*p21 +   p22 -   p23;
-	float a13 =    p00 -   p01 +   p02 -   p03 -   p20 +   p21 -   p22 +   p23;
-	float a20 =  2.0f*p01 - 2.0f*p11 +   p21 -   p31;
-	float a21 = -2.0f*p00 + 2.0f*p02 + 2.0f*p10 - 2.0f*p12 -   p20 +   p22 +   p30 -   p32;
-	float a22 =  4*p00 - 4*p01 + 2.0f*p02 - 2.0f*p03 - 4*p10 + 4*p11 - 2.0f*p12 + 2.0f*p13 + 2.0f*p20 - 2.0f*p21 + p22 - p23 - 2.0f*p30 + 2.0f*p31 - p32 + p33;
-	float a23 = -2.0f*p00 + 2.0f*p01 - 2.0f*p02 + 2.0f*p03 + 2.0f*p10 - 2.0f*p11 + 2.0f*p12 - 2.0f*p13 -   p20 +   p21 - p22 + p23 +   p30 -   p31 + p32 - p33;
-	float a30 =   -p01 +   p11 -   p21 +   p31;
-	float a31 =    p00 -   p02 -   p10 +   p12 +   p20 -   p22 -   p30 +   p32;
-	float a32 = -2.0f*p00 + 2.0f*p01 -   p02 +   p03 + 2.0f*p10 - 2.0f*p11 +   p12 -   p13 - 2.0f*p20 + 2.0f*p21 - p22 + p23 + 2.0f*p30 - 2.0f*p31 + p32 - p33;
-	float a33 =    p00 -   p01 +   p02 -   p03 -   p10 +   p11 -   p12 +   p13 +   p20 -   p21 + p22 - p23 -   p30 +   p31 - p32 + p33;
-
-	float out =
-	a00      + a01 * y      + a02 * y2      + a03 * y3 +
-	a10 * x  + a11 * x  * y + a12 * x  * y2 + a13 * x  * y3 +
-	a20 * x2 + a21 * x2 * y + a22 * x2 * y2 + a23 * x2 * y3 +
-	a30 * x3 + a31 * x3 * y + a32 * x3 * y2 + a33 * x3 * y3;
-
-	if (std::is_floating_point<PixelType>::value) {
-		return std::min(1.0f, std::max(out, 0.0f));
-	}
-	return std::min(static_cast<size_t>(255), std::max(static_cast<size_t>(out), static_cast<size_t>(0)));
+bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMethod interpMethod, size_t numThreads) const{
+	if(&dst == this){
+		return true;
+	}
+	return ofPixelsView_<PixelType>(*this).resizeTo(dst, interpMethod, numThreads);
 }
 
 //----------------------------------------------------------------------
 template<typename PixelType>
-bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMethod interpMethod) const{
-	if(&dst == this){
-		return true;
+bool ofPixelsView_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMethod interpMethod, size_t numThreads) const{
+	if (!isValid() || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel()) return false;
+
+	if(numPlanes > 1){
+		ofLogError("ofPixels") << "resizeTo(): can't resize planar pixel formats, not resizing";
+		return false;
 	}
 
-	if (!(isAllocated()) || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel()) return false;
+	if(overlaps(dst)){
+		// Rows would be overwritten before they're read
+		ofPixels_<PixelType> resized;
+		resized.allocate(dst.getWidth(), dst.getHeight(), dst.getPixelFormat());
+		if(!resizeTo(resized, interpMethod, numThreads)) return false;
+		memcpy(dst.getData(), resized.getData(), dst.getTotalBytes());
+		return true;
+	}
 
 	size_t srcWidth      = getWidth();
 	size_t srcHeight     = getHeight();
 	size_t dstWidth	  = dst.getWidth();
 	size_t dstHeight	  = dst.getHeight();
-	size_t bytesPerPixel = getBytesPerPixel();
-
+	size_t channels      = getNumChannels();
 
 	PixelType * dstPixels = dst.getData();
 
@@ -1356,86 +1799,34 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 
 			//----------------------------------------
 		case OF_INTERPOLATE_NEAREST_NEIGHBOR:{
+			// The source pixel under each destination pixel's centre. Clamped,
+			// since starting at 0.5 walked off the edge when enlarging
 			size_t dstIndex = 0;
 			float srcxFactor = (float)srcWidth/dstWidth;
 			float srcyFactor = (float)srcHeight/dstHeight;
-			float srcy = 0.5;
+			std::vector<size_t> srcColumns(dstWidth);
+			for (size_t dstx=0; dstx<dstWidth; dstx++){
+				srcColumns[dstx] = std::min(static_cast<size_t>((dstx + 0.5f) * srcxFactor), srcWidth - 1) * channels;
+			}
 			for (size_t dsty=0; dsty<dstHeight; dsty++){
-				float srcx = 0.5;
-				size_t srcIndex = static_cast<size_t>(srcy) * srcWidth;
+				size_t srcy = std::min(static_cast<size_t>((dsty + 0.5f) * srcyFactor), srcHeight - 1);
+				const PixelType * srcRow = getRow(srcy);
 				for (size_t dstx=0; dstx<dstWidth; dstx++){
-					size_t pixelIndex = static_cast<size_t>(srcIndex + srcx) * channelsFromPixelFormat(pixelFormat);
-					for (size_t k=0; k< channelsFromPixelFormat(pixelFormat); k++){
-						dstPixels[dstIndex] = pixels[pixelIndex];
+					size_t pixelIndex = srcColumns[dstx];
+					for (size_t k=0; k<channels; k++){
+						dstPixels[dstIndex] = srcRow[pixelIndex];
 						dstIndex++;
 						pixelIndex++;
 					}
-					srcx+=srcxFactor;
 				}
-				srcy+=srcyFactor;
 			}
 		}break;
 
 			//----------------------------------------
 		case OF_INTERPOLATE_BILINEAR:
-			// not implemented yet
-			ofLogError("ofPixels") << "resizeTo(): bilinear resize not implemented, not resizing";
-			break;
-
-			//----------------------------------------
 		case OF_INTERPOLATE_BICUBIC:
-			float px1, py1;
-			float px2, py2;
-			float px3, py3;
-
-			float srcColor = 0;
-			float interpCol;
-			size_t patchRow;
-			size_t patchIndex;
-			float patch[16];
-
-			size_t srcRowBytes = srcWidth*channelsFromPixelFormat(pixelFormat);
-			size_t loIndex = (srcRowBytes)+1;
-			size_t hiIndex = (srcWidth*srcHeight*channelsFromPixelFormat(pixelFormat))-(srcRowBytes)-1;
-
-			for (size_t dsty=0; dsty<dstHeight; dsty++){
-				for (size_t dstx=0; dstx<dstWidth; dstx++){
-
-					size_t   dstIndex0 = (dsty*dstWidth + dstx) * channelsFromPixelFormat(pixelFormat);
-					float srcxf = srcWidth  * (float)dstx/(float)dstWidth;
-					float srcyf = srcHeight * (float)dsty/(float)dstHeight;
-					size_t   srcx = static_cast<size_t>(std::min(srcWidth-1, static_cast<size_t>(srcxf)));
-					size_t   srcy = static_cast<size_t>(std::min(srcHeight-1, static_cast<size_t>(srcyf)));
-					size_t   srcIndex0 = (srcy*srcWidth + srcx) * channelsFromPixelFormat(pixelFormat);
-
-					px1 = srcxf - srcx;
-					py1 = srcyf - srcy;
-					px2 = px1 * px1;
-					px3 = px2 * px1;
-					py2 = py1 * py1;
-					py3 = py2 * py1;
-
-					for (size_t k=0; k<channelsFromPixelFormat(pixelFormat); k++){
-						size_t   dstIndex = dstIndex0+k;
-						size_t   srcIndex = srcIndex0+k;
-
-						for (size_t dy=0; dy<4; dy++) {
-							patchRow = srcIndex + ((dy-1)*srcRowBytes);
-							for (size_t dx=0; dx<4; dx++) {
-								patchIndex = patchRow + (dx-1)*channelsFromPixelFormat(pixelFormat);
-								if ((patchIndex >= loIndex) && (patchIndex < hiIndex)) {
-									srcColor = pixels[patchIndex];
-								}
-								patch[dx*4 + dy] = srcColor;
-							}
-						}
-
-						interpCol = (PixelType)bicubicInterpolate(patch, px1,py1, px2,py2, px3,py3);
-						dstPixels[dstIndex] = interpCol;
-					}
-
-				}
-			}
+		case OF_INTERPOLATE_AREA:
+			resample(*this, dstPixels, dstWidth, dstHeight, channels, interpMethod, numThreads);
 			break;
 	}
 
@@ -1445,19 +1836,28 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 //----------------------------------------------------------------------
 template<typename PixelType>
 bool ofPixels_<PixelType>::pasteInto(ofPixels_<PixelType> &dst, size_t xTo, size_t yTo) const{
-	if (!(isAllocated()) || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel() || xTo + getWidth()>dst.getWidth() || yTo + getHeight()>dst.getHeight()) return false;
+	return ofPixelsView_<PixelType>(*this).pasteInto(dst, xTo, yTo);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::pasteInto(ofPixels_<PixelType> &dst, size_t xTo, size_t yTo) const{
+	if (!isValid() || numPlanes > 1 || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel() || xTo + getWidth()>dst.getWidth() || yTo + getHeight()>dst.getHeight()) return false;
+
+	if(overlaps(dst)){
+		// Rows could be overwritten before they're read
+		ofPixels_<PixelType> copy;
+		copy.setFromPixels(*this);
+		return ofPixelsView_<PixelType>(copy).pasteInto(dst, xTo, yTo);
+	}
 
-	size_t bytesToCopyPerRow = (xTo + getWidth()<=dst.getWidth() ? getWidth() : dst.getWidth()-xTo) * getBytesPerPixel();
-	size_t columnsToCopy = yTo + getHeight() <= dst.getHeight() ? getHeight() : dst.getHeight()-yTo;
-	PixelType * dstPix = dst.getData() + ((xTo + yTo*dst.getWidth())*dst.getBytesPerPixel());
-	const PixelType * srcPix = getData();
-	size_t srcStride = getWidth()*getBytesPerPixel();
-	size_t dstStride = dst.getWidth()*dst.getBytesPerPixel();
+	size_t bytesToCopyPerRow = getWidth() * getBytesPerPixel();
+	size_t dstStride = dst.getBytesStride();
+	unsigned char * dstPix = reinterpret_cast<unsigned char*>(dst.getData()) + yTo * dstStride + xTo * dst.getBytesPerPixel();
 
-	for(size_t y=0;y<columnsToCopy; y++){
-		memcpy(dstPix,srcPix,bytesToCopyPerRow);
+	for(size_t y=0;y<getHeight(); y++){
+		memmove(dstPix,getRow(y),bytesToCopyPerRow);
 		dstPix += dstStride;
-		srcPix += srcStride;
 	}
 
 	return true;
@@ -1473,30 +1873,43 @@ inline A clampedAdd(const A& a, const B& b) {
 //----------------------------------------------------------------------
 template<typename PixelType>
 bool ofPixels_<PixelType>::blendInto(ofPixels_<PixelType> &dst, size_t xTo, size_t yTo) const{
-	if (!(isAllocated()) || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel() || xTo + getWidth()>dst.getWidth() || yTo + getHeight()>dst.getHeight() || getNumChannels()==0) return false;
+	return ofPixelsView_<PixelType>(*this).blendInto(dst, xTo, yTo);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::blendInto(ofPixels_<PixelType> &dst, size_t xTo, size_t yTo) const{
+	if (!isValid() || numPlanes > 1 || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel() || xTo + getWidth()>dst.getWidth() || yTo + getHeight()>dst.getHeight() || getNumChannels()==0) return false;
 
-	std::function<void(const ConstPixel&,Pixel&)> blendFunc;
+	if(overlaps(dst)){
+		// Pixels could be blended over before they're read
+		ofPixels_<PixelType> copy;
+		copy.setFromPixels(*this);
+		return ofPixelsView_<PixelType>(copy).blendInto(dst, xTo, yTo);
+	}
+
+	std::function<void(const PixelType*,PixelType*)> blendFunc;
 	switch(getNumChannels()){
 	case 1:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
+		blendFunc = [](const PixelType*src, PixelType*dst){
 			dst[0] = clampedAdd(src[0], dst[0]);
 		};
 		break;
 	case 2:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
+		blendFunc = [](const PixelType*src, PixelType*dst){
 			dst[0] = clampedAdd(src[0], dst[0] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[1]));
 			dst[1] = clampedAdd(src[1], dst[1] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[1]));
 		};
 		break;
 	case 3:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
+		blendFunc = [](const PixelType*src, PixelType*dst){
 			dst[0] = clampedAdd(src[0], dst[0]);
 			dst[1] = clampedAdd(src[1], dst[1]);
 			dst[2] = clampedAdd(src[2], dst[2]);
 		};
 		break;
 	case 4:
-		blendFunc = [](const ConstPixel&src, Pixel&dst){
+		blendFunc = [](const PixelType*src, PixelType*dst){
 			dst[0] = clampedAdd(src[0], dst[0] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[3]));
 			dst[1] = clampedAdd(src[1], dst[1] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[3]));
 			dst[2] = clampedAdd(src[2], dst[2] / ofColor_<PixelType>::limit() * (ofColor_<PixelType>::limit() - src[3]));
@@ -1504,20 +1917,804 @@ bool ofPixels_<PixelType>::blendInto(ofPixels_<PixelType> &dst, size_t xTo, size
 		};
 		break;
 	}
-	auto dstLine = dst.getLine(yTo);
-	for(auto line: getConstLines()){
-		auto dstPixel = dstLine.getPixels().begin() + xTo;
-		for(auto p: line.getPixels()){
-			blendFunc(p,dstPixel);
-			dstPixel++;
+	size_t channels = getNumChannels();
+	for(size_t y = 0; y < getHeight(); y++){
+		const PixelType * srcPixel = getRow(y);
+		PixelType * dstPixel = dst.getData() + ((yTo + y) * dst.getWidth() + xTo) * channels;
+		for(size_t x = 0; x < getWidth(); x++){
+			blendFunc(srcPixel,dstPixel);
+			srcPixel += channels;
+			dstPixel += channels;
 		}
-		dstLine++;
 	}
 
 	return true;
 }
 
 
+//----------------------------------------------------------------------
+// Format conversion
+//
+// A conversion decodes the source two rows at a time into RGBA and encodes
+// those rows into the destination format; two, because 4:2:0 chroma is
+// shared by a pair of rows. The loops are plain fixed point so the compiler
+// can vectorize them. Where the source already holds the answer, like the Y
+// plane of a YUV frame for grayscale, it is read directly instead.
+namespace{
+
+bool isRgbFormat(ofPixelFormat format){
+	switch(format){
+	case OF_PIXELS_RGB:
+	case OF_PIXELS_BGR:
+	case OF_PIXELS_RGBA:
+	case OF_PIXELS_BGRA:
+	case OF_PIXELS_GRAY:
+	case OF_PIXELS_GRAY_ALPHA:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool isYuv420Format(ofPixelFormat format){
+	switch(format){
+	case OF_PIXELS_NV12:
+	case OF_PIXELS_NV21:
+	case OF_PIXELS_YV12:
+	case OF_PIXELS_I420:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool isYuvFormat(ofPixelFormat format){
+	return isYuv420Format(format) || format == OF_PIXELS_YUY2 || format == OF_PIXELS_UYVY;
+}
+
+bool isConvertible(ofPixelFormat format, bool bytes){
+	return isRgbFormat(format) || (bytes && (isYuvFormat(format) || format == OF_PIXELS_RGB565));
+}
+
+/// \brief Luma and video range YUV coefficients, as doubles and in 13 bit
+/// fixed point for 8 bit pixels.
+struct ColorMatrix{
+	static constexpr int bits = 13;
+	static constexpr int half = 1 << (bits - 1);
+
+	ColorMatrix(ofColorMatrix matrix){
+		kr = matrix == OF_COLOR_MATRIX_BT709 ? 0.2126 : 0.299;
+		kb = matrix == OF_COLOR_MATRIX_BT709 ? 0.0722 : 0.114;
+		kg = 1 - kr - kb;
+
+		// 13 bits keep every coefficient inside an int16 for the SIMD version.
+		// The rounded coefficients have to keep summing to what they did so
+		// white stays white and gray has no chroma
+		grayR = fixed(kr);
+		grayB = fixed(kb);
+		grayG = fixed(1) - grayR - grayB;
+
+		double lumaRange = 219. / 255.;
+		double chromaRange = 224. / 255.;
+		yr = fixed(kr * lumaRange);
+		yb = fixed(kb * lumaRange);
+		yg = fixed(lumaRange) - yr - yb;
+		ur = fixed(-kr / (2 * (1 - kb)) * chromaRange);
+		ub = fixed(0.5 * chromaRange);
+		ug = -ur - ub;
+		vb = fixed(-kb / (2 * (1 - kr)) * chromaRange);
+		vr = fixed(0.5 * chromaRange);
+		vg = -vr - vb;
+
+		yScale = fixed(1 / lumaRange);
+		rv = fixed(2 * (1 - kr) / chromaRange);
+		gu = fixed(-2 * (1 - kb) * kb / kg / chromaRange);
+		gv = fixed(-2 * (1 - kr) * kr / kg / chromaRange);
+		bu = fixed(2 * (1 - kb) / chromaRange);
+	}
+
+	static int fixed(double value){
+		return int(std::round(value * (1 << bits)));
+	}
+
+	double kr, kg, kb;
+	int grayR, grayG, grayB;
+	int yr, yg, yb, ur, ug, ub, vr, vg, vb;
+	int yScale, rv, gu, gv, bu;
+};
+
+inline unsigned char clampByte(int value){
+	return (unsigned char)std::min(std::max(value, 0), 255);
+}
+
+template<typename PixelType>
+inline PixelType luma(PixelType r, PixelType g, PixelType b, const ColorMatrix & m){
+	double value = m.kr * r + m.kg * g + m.kb * b;
+	return std::is_integral<PixelType>::value ? PixelType(std::round(value)) : PixelType(value);
+}
+
+inline unsigned char luma(unsigned char r, unsigned char g, unsigned char b, const ColorMatrix & m){
+	return (unsigned char)((m.grayR * r + m.grayG * g + m.grayB * b + ColorMatrix::half) >> ColorMatrix::bits);
+}
+
+inline unsigned char yFromRgb(int r, int g, int b, const ColorMatrix & m){
+	return (unsigned char)((m.yr * r + m.yg * g + m.yb * b + (16 << ColorMatrix::bits) + ColorMatrix::half) >> ColorMatrix::bits);
+}
+
+/// \brief U and V from the sum of 1 << shift RGB values, so chroma
+/// subsampling averages for free.
+inline void uvFromRgbSum(int r, int g, int b, int shift, const ColorMatrix & m, unsigned char & u, unsigned char & v){
+	int bits = ColorMatrix::bits + shift;
+	int offset = (128 << bits) + (1 << (bits - 1));
+	u = clampByte((m.ur * r + m.ug * g + m.ub * b + offset) >> bits);
+	v = clampByte((m.vr * r + m.vg * g + m.vb * b + offset) >> bits);
+}
+
+/// \brief The chroma part of a YUV to RGB conversion, shared by the pixels
+/// that have the same U and V.
+struct Chroma{
+	Chroma(int u, int v, const ColorMatrix & m){
+		u -= 128;
+		v -= 128;
+		r = m.rv * v + ColorMatrix::half;
+		g = m.gu * u + m.gv * v + ColorMatrix::half;
+		b = m.bu * u + ColorMatrix::half;
+	}
+	int r, g, b;
+};
+
+inline void rgbaFromYuv(int y, const Chroma & chroma, const ColorMatrix & m, unsigned char * rgba){
+	int luma = (y - 16) * m.yScale;
+	rgba[0] = clampByte((luma + chroma.r) >> ColorMatrix::bits);
+	rgba[1] = clampByte((luma + chroma.g) >> ColorMatrix::bits);
+	rgba[2] = clampByte((luma + chroma.b) >> ColorMatrix::bits);
+	rgba[3] = 255;
+}
+
+/// \brief Offsets of row y, and of the chroma it shares, in a 4:2:0 frame.
+struct Yuv420Planes{
+	Yuv420Planes(ofPixelFormat format, size_t width, size_t height, size_t y)
+	:y(y * width){
+		size_t lumaSize = width * height;
+		size_t chromaSize = (width / 2) * (height / 2);
+		switch(format){
+		case OF_PIXELS_NV12:
+			u = lumaSize + (y / 2) * width;
+			v = u + 1;
+			step = 2;
+			break;
+		case OF_PIXELS_NV21:
+			v = lumaSize + (y / 2) * width;
+			u = v + 1;
+			step = 2;
+			break;
+		case OF_PIXELS_I420:
+			u = lumaSize + (y / 2) * (width / 2);
+			v = u + chromaSize;
+			step = 1;
+			break;
+		default: // OF_PIXELS_YV12
+			v = lumaSize + (y / 2) * (width / 2);
+			u = v + chromaSize;
+			step = 1;
+			break;
+		}
+	}
+	size_t y, u, v, step;
+};
+
+#if defined(OF_PIXELS_SSE)
+/// \brief Two int16 coefficients repeated for _mm_madd_epi16.
+inline __m128i coefficientPair(int first, int second){
+	return _mm_set1_epi32(int((uint32_t(uint16_t(second)) << 16) | uint16_t(first)));
+}
+
+/// \brief Luma times its scale for 4 pixels, as int32.
+inline __m128i scaleLuma(__m128i luma16, __m128i scale){
+	return _mm_madd_epi16(luma16, scale);
+}
+
+/// \brief Pack 8 pixels worth of int32 R, G and B into RGBA.
+inline void storeRgba(__m128i r0, __m128i r1, __m128i g0, __m128i g1, __m128i b0, __m128i b1, unsigned char * rgba){
+	const int bits = ColorMatrix::bits;
+	__m128i r = _mm_packs_epi32(_mm_srai_epi32(r0, bits), _mm_srai_epi32(r1, bits));
+	__m128i g = _mm_packs_epi32(_mm_srai_epi32(g0, bits), _mm_srai_epi32(g1, bits));
+	__m128i b = _mm_packs_epi32(_mm_srai_epi32(b0, bits), _mm_srai_epi32(b1, bits));
+	__m128i rg = _mm_packus_epi16(r, g);
+	__m128i ba = _mm_packus_epi16(b, _mm_set1_epi16(255));
+	rg = _mm_unpacklo_epi8(rg, _mm_srli_si128(rg, 8));
+	ba = _mm_unpacklo_epi8(ba, _mm_srli_si128(ba, 8));
+	_mm_storeu_si128((__m128i*)rgba, _mm_unpacklo_epi16(rg, ba));
+	_mm_storeu_si128((__m128i*)(rgba + 16), _mm_unpackhi_epi16(rg, ba));
+}
+
+/// \brief Decode two rows of 4:2:0 YUV to RGBA, 8 pixels of each row at a
+/// time.
+/// \returns How many pixels of each row were decoded.
+size_t decodeYuv420Sse(const unsigned char * y0, const unsigned char * y1, const unsigned char * u, const unsigned char * v, size_t step, size_t width, const ColorMatrix & m, unsigned char * rgba0, unsigned char * rgba1){
+	// Chroma goes into the multiplies as (U, V) pairs, or (V, U) for NV21
+	bool vFirst = step == 2 && v < u;
+	auto pair = [vFirst](int uCoefficient, int vCoefficient){
+		return vFirst ? coefficientPair(vCoefficient, uCoefficient) : coefficientPair(uCoefficient, vCoefficient);
+	};
+	const __m128i rCoefficients = pair(0, m.rv);
+	const __m128i gCoefficients = pair(m.gu, m.gv);
+	const __m128i bCoefficients = pair(m.bu, 0);
+	const __m128i yScale = coefficientPair(m.yScale, 0);
+	const __m128i half = _mm_set1_epi32(ColorMatrix::half);
+	const __m128i lumaOffset = _mm_set1_epi16(16);
+	const __m128i chromaOffset = _mm_set1_epi16(128);
+	const __m128i zero = _mm_setzero_si128();
+	const unsigned char * interleaved = vFirst ? v : u;
+
+	size_t x = 0;
+	for(; x + 8 <= width; x += 8){
+		__m128i uv;
+		if(step == 2){
+			uv = _mm_loadl_epi64((const __m128i*)(interleaved + x));
+			uv = _mm_unpacklo_epi8(uv, zero);
+		}else{
+			int32_t u4, v4;
+			memcpy(&u4, u + x / 2, 4);
+			memcpy(&v4, v + x / 2, 4);
+			uv = _mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(u4), _mm_cvtsi32_si128(v4)), zero);
+		}
+		uv = _mm_sub_epi16(uv, chromaOffset);
+
+		// One term per chroma sample, then repeated for the two pixels that share it
+		__m128i r = _mm_add_epi32(_mm_madd_epi16(uv, rCoefficients), half);
+		__m128i g = _mm_add_epi32(_mm_madd_epi16(uv, gCoefficients), half);
+		__m128i b = _mm_add_epi32(_mm_madd_epi16(uv, bCoefficients), half);
+		__m128i r0 = _mm_unpacklo_epi32(r, r), r1 = _mm_unpackhi_epi32(r, r);
+		__m128i g0 = _mm_unpacklo_epi32(g, g), g1 = _mm_unpackhi_epi32(g, g);
+		__m128i b0 = _mm_unpacklo_epi32(b, b), b1 = _mm_unpackhi_epi32(b, b);
+
+		const unsigned char * rows[2] = { y0 + x, y1 + x };
+		unsigned char * outs[2] = { rgba0 + x * 4, rgba1 + x * 4 };
+		for(int i = 0; i < 2; i++){
+			__m128i luma = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)rows[i]), zero);
+			luma = _mm_sub_epi16(luma, lumaOffset);
+			__m128i l0 = scaleLuma(_mm_unpacklo_epi16(luma, zero), yScale);
+			__m128i l1 = scaleLuma(_mm_unpackhi_epi16(luma, zero), yScale);
+			storeRgba(_mm_add_epi32(l0, r0), _mm_add_epi32(l1, r1),
+					  _mm_add_epi32(l0, g0), _mm_add_epi32(l1, g1),
+					  _mm_add_epi32(l0, b0), _mm_add_epi32(l1, b1),
+					  outs[i]);
+		}
+	}
+	return x;
+}
+#endif
+
+template<typename PixelType>
+void decodeRgbRow(const PixelType * src, ofPixelFormat format, size_t width, PixelType * rgba){
+	PixelType opaque = ofColor_<PixelType>::limit();
+	switch(format){
+	case OF_PIXELS_RGB:
+		for(size_t x = 0; x < width; x++, src += 3, rgba += 4){
+			rgba[0] = src[0];
+			rgba[1] = src[1];
+			rgba[2] = src[2];
+			rgba[3] = opaque;
+		}
+		break;
+	case OF_PIXELS_BGR:
+		for(size_t x = 0; x < width; x++, src += 3, rgba += 4){
+			rgba[0] = src[2];
+			rgba[1] = src[1];
+			rgba[2] = src[0];
+			rgba[3] = opaque;
+		}
+		break;
+	case OF_PIXELS_RGBA:
+		memcpy(rgba, src, width * 4 * sizeof(PixelType));
+		break;
+	case OF_PIXELS_BGRA:
+		for(size_t x = 0; x < width; x++, src += 4, rgba += 4){
+			rgba[0] = src[2];
+			rgba[1] = src[1];
+			rgba[2] = src[0];
+			rgba[3] = src[3];
+		}
+		break;
+	case OF_PIXELS_GRAY:
+		for(size_t x = 0; x < width; x++, src += 1, rgba += 4){
+			rgba[0] = rgba[1] = rgba[2] = src[0];
+			rgba[3] = opaque;
+		}
+		break;
+	case OF_PIXELS_GRAY_ALPHA:
+		for(size_t x = 0; x < width; x++, src += 2, rgba += 4){
+			rgba[0] = rgba[1] = rgba[2] = src[0];
+			rgba[3] = src[1];
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+template<typename PixelType>
+void encodeRgbRow(const PixelType * rgba, ofPixelFormat format, size_t width, const ColorMatrix & m, PixelType * dst){
+	switch(format){
+	case OF_PIXELS_RGB:
+		for(size_t x = 0; x < width; x++, rgba += 4, dst += 3){
+			dst[0] = rgba[0];
+			dst[1] = rgba[1];
+			dst[2] = rgba[2];
+		}
+		break;
+	case OF_PIXELS_BGR:
+		for(size_t x = 0; x < width; x++, rgba += 4, dst += 3){
+			dst[0] = rgba[2];
+			dst[1] = rgba[1];
+			dst[2] = rgba[0];
+		}
+		break;
+	case OF_PIXELS_RGBA:
+		memcpy(dst, rgba, width * 4 * sizeof(PixelType));
+		break;
+	case OF_PIXELS_BGRA:
+		for(size_t x = 0; x < width; x++, rgba += 4, dst += 4){
+			dst[0] = rgba[2];
+			dst[1] = rgba[1];
+			dst[2] = rgba[0];
+			dst[3] = rgba[3];
+		}
+		break;
+	case OF_PIXELS_GRAY:
+		for(size_t x = 0; x < width; x++, rgba += 4, dst += 1){
+			dst[0] = luma(rgba[0], rgba[1], rgba[2], m);
+		}
+		break;
+	case OF_PIXELS_GRAY_ALPHA:
+		for(size_t x = 0; x < width; x++, rgba += 4, dst += 2){
+			dst[0] = luma(rgba[0], rgba[1], rgba[2], m);
+			dst[1] = rgba[3];
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+template<typename PixelType>
+void decodeRows(const ofPixelsView_<PixelType> & src, size_t y, size_t rows, const ColorMatrix &, PixelType * rgba[2]){
+	for(size_t i = 0; i < rows; i++){
+		decodeRgbRow(src.getRow(y + i), src.getPixelFormat(), src.getWidth(), rgba[i]);
+	}
+}
+
+template<typename PixelType>
+void encodeRows(PixelType * const rgba[2], size_t y, size_t rows, const ColorMatrix & m, ofPixels_<PixelType> & dst){
+	size_t stride = dst.getWidth() * dst.getNumChannels();
+	for(size_t i = 0; i < rows; i++){
+		encodeRgbRow(rgba[i], dst.getPixelFormat(), dst.getWidth(), m, dst.getData() + (y + i) * stride);
+	}
+}
+
+void decodeRows(const ofPixelsView & src, size_t y, size_t rows, const ColorMatrix & m, unsigned char * rgba[2]){
+	size_t width = src.getWidth();
+	ofPixelFormat format = src.getPixelFormat();
+
+	if(isYuv420Format(format)){
+		const unsigned char * y0 = src.getRow(y);
+		const unsigned char * y1 = src.getRow(y + 1);
+		const unsigned char * u;
+		const unsigned char * v;
+		size_t step = 1;
+		switch(format){
+		case OF_PIXELS_NV12:
+			u = src.getRow(y / 2, 1);
+			v = u + 1;
+			step = 2;
+			break;
+		case OF_PIXELS_NV21:
+			v = src.getRow(y / 2, 1);
+			u = v + 1;
+			step = 2;
+			break;
+		case OF_PIXELS_I420:
+			u = src.getRow(y / 2, 1);
+			v = src.getRow(y / 2, 2);
+			break;
+		default: // OF_PIXELS_YV12
+			v = src.getRow(y / 2, 1);
+			u = src.getRow(y / 2, 2);
+			break;
+		}
+		unsigned char * rgba0 = rgba[0];
+		unsigned char * rgba1 = rgba[1];
+		size_t x = 0;
+#if defined(OF_PIXELS_SSE)
+		x = decodeYuv420Sse(y0, y1, u, v, step, width, m, rgba0, rgba1);
+#endif
+		for(; x < width; x += 2){
+			size_t c = x / 2 * step;
+			Chroma chroma(u[c], v[c], m);
+			rgbaFromYuv(y0[x], chroma, m, rgba0 + x * 4);
+			rgbaFromYuv(y0[x + 1], chroma, m, rgba0 + x * 4 + 4);
+			rgbaFromYuv(y1[x], chroma, m, rgba1 + x * 4);
+			rgbaFromYuv(y1[x + 1], chroma, m, rgba1 + x * 4 + 4);
+		}
+		return;
+	}
+
+	for(size_t i = 0; i < rows; i++){
+		unsigned char * out = rgba[i];
+		switch(format){
+		case OF_PIXELS_YUY2:
+		case OF_PIXELS_UYVY:{
+			// YUY2 is Y0 U Y1 V, UYVY is U Y0 V Y1
+			const unsigned char * row = src.getRow(y + i);
+			size_t luma = format == OF_PIXELS_YUY2 ? 0 : 1;
+			size_t chroma = 1 - luma;
+			for(size_t x = 0; x < width; x += 2, row += 4, out += 8){
+				Chroma uv(row[chroma], row[chroma + 2], m);
+				rgbaFromYuv(row[luma], uv, m, out);
+				rgbaFromYuv(row[luma + 2], uv, m, out + 4);
+			}
+			break;
+		}
+		case OF_PIXELS_RGB565:{
+			const unsigned char * row = src.getRow(y + i);
+			for(size_t x = 0; x < width; x++, row += 2, out += 4){
+				uint16_t pixel;
+				memcpy(&pixel, row, 2);
+				int r = pixel >> 11;
+				int g = (pixel >> 5) & 63;
+				int b = pixel & 31;
+				out[0] = (unsigned char)((r << 3) | (r >> 2));
+				out[1] = (unsigned char)((g << 2) | (g >> 4));
+				out[2] = (unsigned char)((b << 3) | (b >> 2));
+				out[3] = 255;
+			}
+			break;
+		}
+		default:
+			decodeRgbRow(src.getRow(y + i), format, width, out);
+			break;
+		}
+	}
+}
+
+void encodeRows(unsigned char * const rgba[2], size_t y, size_t rows, const ColorMatrix & m, ofPixels_<unsigned char> & dst){
+	unsigned char * data = dst.getData();
+	size_t width = dst.getWidth();
+	ofPixelFormat format = dst.getPixelFormat();
+
+	if(isYuv420Format(format)){
+		Yuv420Planes planes(format, width, dst.getHeight(), y);
+		unsigned char * y0 = data + planes.y;
+		unsigned char * y1 = y0 + width;
+		unsigned char * u = data + planes.u;
+		unsigned char * v = data + planes.v;
+		const unsigned char * rgba0 = rgba[0];
+		const unsigned char * rgba1 = rgba[1];
+		for(size_t x = 0; x < width; x++){
+			y0[x] = yFromRgb(rgba0[x * 4], rgba0[x * 4 + 1], rgba0[x * 4 + 2], m);
+			y1[x] = yFromRgb(rgba1[x * 4], rgba1[x * 4 + 1], rgba1[x * 4 + 2], m);
+		}
+		for(size_t x = 0; x < width; x += 2, u += planes.step, v += planes.step){
+			const unsigned char * a = rgba0 + x * 4;
+			const unsigned char * b = rgba1 + x * 4;
+			uvFromRgbSum(a[0] + a[4] + b[0] + b[4], a[1] + a[5] + b[1] + b[5], a[2] + a[6] + b[2] + b[6], 2, m, *u, *v);
+		}
+		return;
+	}
+
+	for(size_t i = 0; i < rows; i++){
+		const unsigned char * in = rgba[i];
+		switch(format){
+		case OF_PIXELS_YUY2:
+		case OF_PIXELS_UYVY:{
+			unsigned char * row = data + (y + i) * width * 2;
+			size_t luma = format == OF_PIXELS_YUY2 ? 0 : 1;
+			size_t chroma = 1 - luma;
+			for(size_t x = 0; x < width; x += 2, row += 4, in += 8){
+				row[luma] = yFromRgb(in[0], in[1], in[2], m);
+				row[luma + 2] = yFromRgb(in[4], in[5], in[6], m);
+				uvFromRgbSum(in[0] + in[4], in[1] + in[5], in[2] + in[6], 1, m, row[chroma], row[chroma + 2]);
+			}
+			break;
+		}
+		case OF_PIXELS_RGB565:{
+			unsigned char * row = data + (y + i) * width * 2;
+			for(size_t x = 0; x < width; x++, row += 2, in += 4){
+				uint16_t pixel = uint16_t(((in[0] >> 3) << 11) | ((in[1] >> 2) << 5) | (in[2] >> 3));
+				memcpy(row, &pixel, 2);
+			}
+			break;
+		}
+		default:
+			encodeRgbRow(in, format, width, m, data + (y + i) * width * dst.getNumChannels());
+			break;
+		}
+	}
+}
+
+template<typename PixelType>
+void convertPixels(const ofPixelsView_<PixelType> & src, ofPixels_<PixelType> & dst, const ColorMatrix & m, size_t numThreads){
+	size_t width = src.getWidth();
+	size_t height = src.getHeight();
+	parallelRows((height + 1) / 2, numThreads, [&](size_t begin, size_t end){
+		std::vector<PixelType> buffer(width * 8);
+		PixelType * rgba[2] = { buffer.data(), buffer.data() + width * 4 };
+		for(size_t pair = begin; pair < end; pair++){
+			size_t y = pair * 2;
+			size_t rows = std::min<size_t>(2, height - y);
+			decodeRows(src, y, rows, m, rgba);
+			encodeRows(rgba, y, rows, m, dst);
+		}
+	});
+}
+
+/// \brief Conversions that only need luma skip the trip through RGBA: color
+/// to grayscale is a weighted sum, and YUV to and from grayscale only maps
+/// the Y values between video and full range.
+bool convertLuma(const ofPixelsView & src, ofPixels_<unsigned char> & dst, const ColorMatrix & m, size_t numThreads){
+	ofPixelFormat srcFormat = src.getPixelFormat();
+	ofPixelFormat dstFormat = dst.getPixelFormat();
+	size_t width = src.getWidth();
+
+	size_t channels = src.getNumChannels();
+	if(dstFormat == OF_PIXELS_GRAY && isRgbFormat(srcFormat) && channels >= 3){
+		bool bgr = srcFormat == OF_PIXELS_BGR || srcFormat == OF_PIXELS_BGRA;
+		ColorMatrix swapped = m;
+		if(bgr){
+			std::swap(swapped.grayR, swapped.grayB);
+		}
+		parallelRows(src.getHeight(), numThreads, [&](size_t begin, size_t end){
+			for(size_t y = begin; y < end; y++){
+				const unsigned char * in = src.getRow(y);
+				unsigned char * out = dst.getData() + y * width;
+				for(size_t x = 0; x < width; x++, in += channels){
+					out[x] = luma(in[0], in[1], in[2], swapped);
+				}
+			}
+		});
+		return true;
+	}
+
+	bool toGray = isYuvFormat(srcFormat) && dstFormat == OF_PIXELS_GRAY;
+	bool fromGray = srcFormat == OF_PIXELS_GRAY && isYuvFormat(dstFormat);
+	if(!toGray && !fromGray){
+		return false;
+	}
+
+	unsigned char lut[256];
+	for(int i = 0; i < 256; i++){
+		lut[i] = toGray ? clampByte(int(std::round((i - 16) * 255. / 219.))) : (unsigned char)(std::round(i * 219. / 255.) + 16);
+	}
+
+	// Packed formats interleave Y with chroma, planar ones start with all of it
+	ofPixelFormat yuv = toGray ? srcFormat : dstFormat;
+	size_t offset = yuv == OF_PIXELS_UYVY ? 1 : 0;
+	size_t step = (yuv == OF_PIXELS_YUY2 || yuv == OF_PIXELS_UYVY) ? 2 : 1;
+	unsigned char * dstData = dst.getData();
+	size_t srcStep = toGray ? step : 1;
+	size_t dstStep = toGray ? 1 : step;
+	size_t srcOffset = toGray ? offset : 0;
+	size_t dstOffset = toGray ? 0 : offset;
+
+	parallelRows(src.getHeight(), numThreads, [&](size_t begin, size_t end){
+		for(size_t y = begin; y < end; y++){
+			const unsigned char * in = src.getRow(y) + srcOffset;
+			unsigned char * out = dstData + y * width * dstStep + dstOffset;
+			for(size_t x = 0; x < width; x++){
+				out[x * dstStep] = lut[in[x * srcStep]];
+			}
+			if(fromGray && step == 2){
+				unsigned char * chroma = dstData + y * width * 2 + 1 - offset;
+				for(size_t x = 0; x < width; x++){
+					chroma[x * 2] = 128;
+				}
+			}
+		}
+	});
+	if(fromGray && step == 1){
+		size_t lumaSize = width * src.getHeight();
+		memset(dstData + lumaSize, 128, dst.size() - lumaSize);
+	}
+	return true;
+}
+
+template<typename PixelType>
+bool convertLuma(const ofPixelsView_<PixelType> &, ofPixels_<PixelType> &, const ColorMatrix &, size_t){
+	return false;
+}
+
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::convertTo(ofPixels_<PixelType> & dst, ofPixelFormat format, ofColorMatrix matrix, size_t numThreads) const{
+	if(!isValid()) return false;
+
+	bool bytes = std::is_same<PixelType, unsigned char>::value;
+	if(!isConvertible(pixelFormat, bytes) || !isConvertible(format, bytes)){
+		ofLogError("ofPixels") << "convertTo(): can't convert from " << ofToString(pixelFormat) << " to " << ofToString(format);
+		return false;
+	}
+	if((isYuvFormat(pixelFormat) || isYuvFormat(format)) && (width % 2 != 0 || height % 2 != 0)){
+		ofLogError("ofPixels") << "convertTo(): YUV formats need an even width and height, not " << width << "x" << height;
+		return false;
+	}
+
+	if(overlaps(dst)){
+		ofPixels_<PixelType> converted;
+		if(!convertTo(converted, format, matrix, numThreads)) return false;
+		dst.swap(converted);
+		return true;
+	}
+
+	if(format == pixelFormat){
+		dst.setFromPixels(*this);
+		return true;
+	}
+
+	dst.allocate(width, height, format);
+	ColorMatrix coefficients(matrix);
+	if(!convertLuma(*this, dst, coefficients, numThreads)){
+		convertPixels(*this, dst, coefficients, numThreads);
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixels_<PixelType>::convertTo(ofPixels_<PixelType> & dst, ofPixelFormat format, ofColorMatrix matrix, size_t numThreads) const{
+	return ofPixelsView_<PixelType>(*this).convertTo(dst, format, matrix, numThreads);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_(const ofPixels_<PixelType> & pixels){
+	if(pixels.isAllocated()){
+		*this = ofPixelsView_<PixelType>(pixels.getData(), pixels.getWidth(), pixels.getHeight(), pixels.getPixelFormat());
+	}
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_(const PixelType * data, size_t w, size_t h, ofPixelFormat format, size_t stride){
+	size_t planesInFormat = numPlanesFromPixelFormat(format);
+	if(data == nullptr || w == 0 || h == 0 || planesInFormat == 0){
+		return;
+	}
+
+	width = w;
+	height = h;
+	pixelFormat = format;
+	numPlanes = planesInFormat;
+
+	// Each plane follows the last; chroma planes keep the same proportion
+	// of padding as the Y plane
+	const unsigned char * plane = reinterpret_cast<const unsigned char*>(data);
+	size_t packedLuma = w * ofPixels_<PixelType>::pixelBitsFromPixelFormat(planeFormatFromPixelFormat(format, 0).format) / 8;
+	for(size_t i = 0; i < numPlanes; i++){
+		PlaneFormat planeFormat = planeFormatFromPixelFormat(format, i);
+		size_t packed = (w >> planeFormat.shift) * ofPixels_<PixelType>::pixelBitsFromPixelFormat(planeFormat.format) / 8;
+		planes[i].data = reinterpret_cast<const PixelType*>(plane);
+		planes[i].stride = stride == 0 ? packed : stride * packed / packedLuma;
+		plane += planes[i].stride * (h >> planeFormat.shift);
+	}
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_(size_t w, size_t h, ofPixelFormat format, const std::vector<Plane> & framePlanes){
+	size_t planesInFormat = numPlanesFromPixelFormat(format);
+	if(w == 0 || h == 0 || planesInFormat == 0){
+		return;
+	}
+	if(framePlanes.size() < planesInFormat){
+		ofLogError("ofPixelsView") << ofToString(format) << " needs " << planesInFormat << " planes, got " << framePlanes.size();
+		return;
+	}
+
+	width = w;
+	height = h;
+	pixelFormat = format;
+	numPlanes = planesInFormat;
+	for(size_t i = 0; i < numPlanes; i++){
+		PlaneFormat planeFormat = planeFormatFromPixelFormat(format, i);
+		planes[i] = framePlanes[i];
+		if(planes[i].stride == 0){
+			planes[i].stride = (w >> planeFormat.shift) * ofPixels_<PixelType>::pixelBitsFromPixelFormat(planeFormat.format) / 8;
+		}
+	}
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+size_t ofPixelsView_<PixelType>::getNumChannels() const{
+	return channelsFromPixelFormat(pixelFormat);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::isContiguous() const{
+	if(!isValid()) return false;
+	ofPixelsView_<PixelType> packed(planes[0].data, width, height, pixelFormat);
+	for(size_t i = 0; i < numPlanes; i++){
+		if(planes[i].data != packed.planes[i].data || planes[i].stride != packed.planes[i].stride){
+			return false;
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixelsView_<PixelType>::crop(size_t x, size_t y, size_t w, size_t h) const{
+	if(!isValid() || w == 0 || h == 0 || x + w > width || y + h > height){
+		ofLogError("ofPixelsView") << "crop(): " << w << "x" << h << " at " << x << "," << y << " isn't inside " << width << "x" << height;
+		return ofPixelsView_<PixelType>();
+	}
+
+	// Pixels that share chroma can't be split
+	bool evenColumns = numPlanes > 1 || pixelFormat == OF_PIXELS_YUY2 || pixelFormat == OF_PIXELS_UYVY;
+	bool evenRows = numPlanes > 1;
+	if((evenColumns && (x % 2 != 0 || w % 2 != 0)) || (evenRows && (y % 2 != 0 || h % 2 != 0))){
+		ofLogError("ofPixelsView") << "crop(): " << ofToString(pixelFormat) << " can only be cropped on even pixels";
+		return ofPixelsView_<PixelType>();
+	}
+
+	ofPixelsView_<PixelType> view = *this;
+	view.width = w;
+	view.height = h;
+	for(size_t i = 0; i < numPlanes; i++){
+		PlaneFormat planeFormat = planeFormatFromPixelFormat(pixelFormat, i);
+		size_t bytesPerPixel = ofPixels_<PixelType>::pixelBitsFromPixelFormat(planeFormat.format) / 8;
+		size_t offset = (y >> planeFormat.shift) * planes[i].stride + (x >> planeFormat.shift) * bytesPerPixel;
+		view.planes[i].data = reinterpret_cast<const PixelType*>(reinterpret_cast<const unsigned char*>(planes[i].data) + offset);
+	}
+	return view;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixelsView_<PixelType>::getPlane(size_t plane) const{
+	ofPixelsView_<PixelType> view;
+	if(plane >= numPlanes){
+		return view;
+	}
+	PlaneFormat planeFormat = planeFormatFromPixelFormat(pixelFormat, plane);
+	view.width = width >> planeFormat.shift;
+	view.height = height >> planeFormat.shift;
+	view.pixelFormat = planeFormat.format;
+	view.numPlanes = 1;
+	view.planes[0] = planes[plane];
+	return view;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::overlaps(const ofPixels_<PixelType> & pixels) const{
+	if(!isValid() || !pixels.isAllocated()){
+		return false;
+	}
+	std::less<const unsigned char*> before;
+	const unsigned char * begin = reinterpret_cast<const unsigned char*>(pixels.getData());
+	const unsigned char * end = begin + pixels.getTotalBytes();
+	for(size_t i = 0; i < numPlanes; i++){
+		PlaneFormat planeFormat = planeFormatFromPixelFormat(pixelFormat, i);
+		size_t rowBytes = (width >> planeFormat.shift) * ofPixels_<PixelType>::pixelBitsFromPixelFormat(planeFormat.format) / 8;
+		size_t rows = height >> planeFormat.shift;
+		if(rows == 0 || rowBytes == 0){
+			// the chroma of a 1 pixel high or wide frame, nothing to overlap
+			continue;
+		}
+		const unsigned char * plane = reinterpret_cast<const unsigned char*>(planes[i].data);
+		const unsigned char * planeEnd = plane + (rows - 1) * planes[i].stride + rowBytes;
+		if(before(plane, end) && before(begin, planeEnd)){
+			return true;
+		}
+	}
+	return false;
+}
+
 template class ofPixels_<char>;
 template class ofPixels_<unsigned char>;
 template class ofPixels_<short>;
@@ -1528,3 +2725,14 @@ template class ofPixels_<long>;
 template class ofPixels_<unsigned long>;
 template class ofPixels_<float>;
 template class ofPixels_<double>;
+
+template class ofPixelsView_<char>;
+template class ofPixelsView_<unsigned char>;
+template class ofPixelsView_<short>;
+template class ofPixelsView_<unsigned short>;
+template class ofPixelsView_<int>;
+template class ofPixelsView_<unsigned int>;
+template class ofPixelsView_<long>;
+template class ofPixelsView_<unsigned long>;
+template class ofPixelsView_<float>;
+template class ofPixelsView_<double>;
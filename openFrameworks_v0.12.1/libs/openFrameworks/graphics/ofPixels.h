@@ -56,7 +56,21 @@ typedef ofColor_<unsigned short> ofShortColor;
 enum ofInterpolationMethod {
 	OF_INTERPOLATE_NEAREST_NEIGHBOR =1,
 	OF_INTERPOLATE_BILINEAR			=2,
-	OF_INTERPOLATE_BICUBIC			=3
+	OF_INTERPOLATE_BICUBIC			=3,
+	/// \brief Average of the source pixels each output pixel covers.
+	///
+	/// The best choice for shrinking; enlarging falls back to bilinear.
+	OF_INTERPOLATE_AREA				=4
+};
+
+/// \brief The coefficients used to go between RGB and luma / YUV.
+///
+/// BT.601 is the standard for SD video and most webcams, BT.709 the one for
+/// HD video. YUV data is taken to be video range: Y from 16 to 235, U and V
+/// from 16 to 240.
+enum ofColorMatrix {
+	OF_COLOR_MATRIX_BT601			=1,
+	OF_COLOR_MATRIX_BT709			=2
 };
 
 
@@ -163,6 +177,9 @@ std::string ofToString(const ofPixelFormat & pixelType);
 
 enum ofImageType: short;
 
+template <typename PixelType>
+class ofPixelsView_;
+
 /// \brief A class representing a collection of pixels.
 template <typename PixelType>
 class ofPixels_ {
@@ -244,6 +261,8 @@ public:
 	void setFromAlignedPixels(const PixelType * newPixels, size_t width, size_t height, ofPixelFormat pixelFormat, size_t stride);
 	/// \brief used to copy i420 pixels from gstreamer when (width % 4) != 0
 	void setFromAlignedPixels(const PixelType * newPixels, size_t width, size_t height, ofPixelFormat pixelFormat, std::vector<size_t> strides);
+	/// \brief Copy the pixels an ofPixelsView_ looks at, packing its rows.
+	void setFromPixels(const ofPixelsView_<PixelType> & view);
 
 	void swap(ofPixels_<PixelType> & pix);
 
@@ -281,7 +300,14 @@ public:
 	///     OF_INTERPOLATE_NEAREST_NEIGHBOR
 	///     OF_INTERPOLATE_BILINEAR
 	///     OF_INTERPOLATE_BICUBIC
-	bool resize(size_t dstWidth, size_t dstHeight, ofInterpolationMethod interpMethod=OF_INTERPOLATE_NEAREST_NEIGHBOR);
+	///     OF_INTERPOLATE_AREA
+	///
+	/// Bilinear and bicubic widen their filter when shrinking, so every
+	/// source pixel contributes and the result doesn't alias.
+	///
+	/// \param numThreads Split the work across this many threads, worth it
+	/// for large images only.
+	bool resize(size_t dstWidth, size_t dstHeight, ofInterpolationMethod interpMethod=OF_INTERPOLATE_NEAREST_NEIGHBOR, size_t numThreads=1);
 
 	/// \brief Resize the ofPixels instance to the size of the ofPixels object passed in dst.
 	///
@@ -290,7 +316,13 @@ public:
 	///     OF_INTERPOLATE_NEAREST_NEIGHBOR
 	///     OF_INTERPOLATE_BILINEAR
 	///     OF_INTERPOLATE_BICUBIC
-	bool resizeTo(ofPixels_<PixelType> & dst, ofInterpolationMethod interpMethod=OF_INTERPOLATE_NEAREST_NEIGHBOR) const;
+	///     OF_INTERPOLATE_AREA
+	///
+	/// Planar YUV formats can't be resized.
+	///
+	/// \param numThreads Split the work across this many threads, worth it
+	/// for large images only.
+	bool resizeTo(ofPixels_<PixelType> & dst, ofInterpolationMethod interpMethod=OF_INTERPOLATE_NEAREST_NEIGHBOR, size_t numThreads=1) const;
 
 	/// \brief Paste the ofPixels object into another ofPixels object at the
 	/// specified index, copying data from the ofPixels that the method is
@@ -440,6 +472,26 @@ public:
 	/// \param imageType Can be one of the following: OF_IMAGE_GRAYSCALE, OF_IMAGE_COLOR, OF_IMAGE_COLOR_ALPHA
 	void setImageType(ofImageType imageType);
 
+	/// \brief Convert the pixels to another pixel format.
+	///
+	/// Grayscale is computed as the luma of the color matrix rather than by
+	/// taking one of the channels. Conversions from and to the YUV formats
+	/// (NV12, NV21, YV12, I420, YUY2, UYVY) and RGB565 are only available for
+	/// ofPixels, and YUV needs an even width and height.
+	///
+	/// ~~~~{.cpp}
+	/// ofPixels rgb;
+	/// cameraFrame.convertTo(rgb, OF_PIXELS_RGB, OF_COLOR_MATRIX_BT709);
+	/// ~~~~
+	///
+	/// \param dst The ofPixels to write to, it is allocated if needed and
+	/// can be this same object.
+	/// \param format The pixel format to convert to.
+	/// \param matrix The coefficients for YUV and luma.
+	/// \param numThreads Split the rows among this many threads.
+	/// \returns true if the conversion is supported and succeeded.
+	bool convertTo(ofPixels_<PixelType> & dst, ofPixelFormat format, ofColorMatrix matrix = OF_COLOR_MATRIX_BT601, size_t numThreads = 1) const;
+
 	void setNumChannels(size_t numChannels);
 
     static size_t pixelBitsFromPixelFormat(ofPixelFormat format);
@@ -671,8 +723,6 @@ public:
     /// \endcond
 
 private:
-	static float bicubicInterpolate(const float *patch, float x,float y, float x2,float y2, float x3,float y3);
-
 	void copyFrom( const ofPixels_<PixelType>& mom );
 
 	template<typename SrcType>
@@ -700,6 +750,120 @@ typedef ofPixels& ofPixelsRef;
 typedef ofFloatPixels& ofFloatPixelsRef;
 typedef ofShortPixels& ofShortPixelsRef;
 
+
+/// \brief A read-only window onto pixels that live somewhere else.
+///
+/// An ofPixelsView_ doesn't own or copy any data, it only describes where
+/// each row of each plane starts: a width, height and pixel format, and for
+/// every plane the data and its stride, the distance in bytes from one row to
+/// the next. That is enough to describe a region of an image, one plane of a
+/// YUV frame, or a buffer with padded rows like the ones GStreamer or OpenCV
+/// hand out.
+///
+/// ofPixels::resizeTo, pasteInto, blendInto and convertTo all have an
+/// ofPixelsView_ counterpart, so a region of interest can be processed
+/// without copying it out first:
+///
+/// ~~~~{.cpp}
+/// ofPixelsView roi = ofPixelsView(frame).crop(100, 50, 320, 240);
+/// roi.resizeTo(thumbnail, OF_INTERPOLATE_AREA);
+///
+/// // a cv::Mat, even a submatrix that isn't continuous
+/// ofPixelsView view(mat.data, mat.cols, mat.rows, OF_PIXELS_RGB, mat.step);
+/// ~~~~
+///
+/// A view is cheap to make and to copy. The pixels it looks at have to stay
+/// alive, and not move, for as long as it's used.
+template <typename PixelType>
+class ofPixelsView_ {
+public:
+	/// \brief Where one plane starts and the number of bytes from one of
+	/// its rows to the next.
+	struct Plane{
+		const PixelType * data = nullptr;
+		size_t stride = 0;
+	};
+
+	/// \brief An empty view.
+	ofPixelsView_(){}
+
+	/// \brief View all of an ofPixels.
+	ofPixelsView_(const ofPixels_<PixelType> & pixels);
+
+	/// \brief View pixels laid out like an ofPixels, but with rows that
+	/// are `stride` bytes apart.
+	///
+	/// For the planar YUV formats the chroma planes follow the Y plane, with
+	/// half its stride for YV12 and I420.
+	///
+	/// \param stride Bytes from one row to the next, 0 if rows are packed.
+	ofPixelsView_(const PixelType * data, size_t width, size_t height, ofPixelFormat pixelFormat, size_t stride = 0);
+
+	/// \brief View a frame whose planes each start somewhere else, like a
+	/// mapped GStreamer frame with its offsets and strides.
+	ofPixelsView_(size_t width, size_t height, ofPixelFormat pixelFormat, const std::vector<Plane> & planes);
+
+	/// \brief Whether the view looks at any pixels.
+	bool isValid() const;
+
+	size_t getWidth() const;
+	size_t getHeight() const;
+	ofPixelFormat getPixelFormat() const;
+	size_t getNumChannels() const;
+	size_t getBytesPerPixel() const;
+	size_t getNumPlanes() const;
+
+	/// \brief The bytes from one row of a plane to the next.
+	size_t getStride(size_t plane = 0) const;
+
+	/// \brief The first value of row `y` of a plane.
+	///
+	/// Chroma planes of 4:2:0 formats have half as many rows.
+	const PixelType * getRow(size_t y, size_t plane = 0) const;
+
+	/// \brief Whether rows and planes follow each other without gaps,
+	/// exactly like the data of an ofPixels of the same size and format.
+	bool isContiguous() const;
+
+	/// \brief A view of a region of this one.
+	///
+	/// The region has to be inside the view. For YUV formats it also has to
+	/// start and end on the pixels that share chroma, so on even columns
+	/// and, for 4:2:0, even rows. Otherwise an empty view is returned.
+	ofPixelsView_<PixelType> crop(size_t x, size_t y, size_t width, size_t height) const;
+
+	/// \brief A view of one plane, with the same formats ofPixels::getPlane
+	/// returns, like OF_PIXELS_Y and OF_PIXELS_UV for NV12.
+	ofPixelsView_<PixelType> getPlane(size_t plane) const;
+
+	/// \sa ofPixels_::resizeTo
+	bool resizeTo(ofPixels_<PixelType> & dst, ofInterpolationMethod interpMethod = OF_INTERPOLATE_NEAREST_NEIGHBOR, size_t numThreads = 1) const;
+
+	/// \sa ofPixels_::pasteInto
+	bool pasteInto(ofPixels_<PixelType> & dst, size_t x, size_t y) const;
+
+	/// \sa ofPixels_::blendInto
+	bool blendInto(ofPixels_<PixelType> & dst, size_t x, size_t y) const;
+
+	/// \sa ofPixels_::convertTo
+	bool convertTo(ofPixels_<PixelType> & dst, ofPixelFormat format, ofColorMatrix matrix = OF_COLOR_MATRIX_BT601, size_t numThreads = 1) const;
+
+	/// \brief Whether the view looks at any of the data of `pixels`, which
+	/// then can't be written to while the view is read.
+	bool overlaps(const ofPixels_<PixelType> & pixels) const;
+
+private:
+	size_t width = 0;
+	size_t height = 0;
+	ofPixelFormat pixelFormat = OF_PIXELS_UNKNOWN;
+	size_t numPlanes = 0;
+	Plane planes[3];
+};
+
+typedef ofPixelsView_<unsigned char> ofPixelsView;
+typedef ofPixelsView_<float> ofFloatPixelsView;
+typedef ofPixelsView_<unsigned short> ofShortPixelsView;
+
 // sorry for these ones, being templated functions inside a template i needed to do it in the .h
 // they allow to do things like:
 //
@@ -1521,6 +1685,54 @@ inline typename ofPixels_<PixelType>::ConstPixels ofPixels_<PixelType>::getConst
 	return ConstPixels(begin(),end(),getNumChannels(),pixelFormat);
 }
 
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline bool ofPixelsView_<PixelType>::isValid() const{
+	return numPlanes > 0;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline size_t ofPixelsView_<PixelType>::getWidth() const{
+	return width;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline size_t ofPixelsView_<PixelType>::getHeight() const{
+	return height;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline ofPixelFormat ofPixelsView_<PixelType>::getPixelFormat() const{
+	return pixelFormat;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline size_t ofPixelsView_<PixelType>::getBytesPerPixel() const{
+	return ofPixels_<PixelType>::pixelBitsFromPixelFormat(pixelFormat) / 8;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline size_t ofPixelsView_<PixelType>::getNumPlanes() const{
+	return numPlanes;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline size_t ofPixelsView_<PixelType>::getStride(size_t plane) const{
+	return planes[plane].stride;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+inline const PixelType * ofPixelsView_<PixelType>::getRow(size_t y, size_t plane) const{
+	return reinterpret_cast<const PixelType*>(reinterpret_cast<const unsigned char*>(planes[plane].data) + y * planes[plane].stride);
+}
+
 namespace std{
 template<typename PixelType>
 void swap(ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst){
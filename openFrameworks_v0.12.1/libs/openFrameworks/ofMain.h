@@ -13,6 +13,7 @@
 
 #include "ofThread.h"
 #include "ofThreadChannel.h"
+#include "ofSpscChannel.h"
 
 #include "ofFpsCounter.h"
 #include "ofJson.h"
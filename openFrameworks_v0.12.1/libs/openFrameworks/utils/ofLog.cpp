@@ -1,6 +1,10 @@
 #include "ofLog.h"
 #include <ofUtils.h>
 #include <map>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #ifdef TARGET_ANDROID
 	#include "ofxAndroidLogChannel.h"
 #endif
@@ -274,6 +278,7 @@ void ofFileLoggerChannel::close(){
 }
 
 void ofFileLoggerChannel::setFile(const of::filesystem::path & path, bool append) {
+	this->path = path;
 	file.open(path,append ? ofFile::Append:ofFile::WriteOnly);
 	file << std::endl;
 	file << std::endl;
@@ -286,5 +291,260 @@ void ofFileLoggerChannel::log(ofLogLevel level, const string & module, const str
 		file << module << ": ";
 	}
 	file << message << std::endl;
+	if(maxBytes > 0 && size_t(file.tellp()) >= maxBytes){
+		rotate();
+	}
+}
+
+void ofFileLoggerChannel::flush(){
+	file.flush();
+}
+
+void ofFileLoggerChannel::setRotation(size_t maxBytes, size_t maxFiles){
+	this->maxBytes = maxBytes;
+	this->maxFiles = maxFiles;
+}
+
+// The log was opened relative to the data folder, so its rotated copies are too
+of::filesystem::path ofFileLoggerChannel::getRotatedPath(size_t index) const{
+	auto rotated = ofToDataPathFS(path, true);
+	rotated.replace_extension(ofToString(index) + path.extension().string());
+	return rotated;
+}
+
+void ofFileLoggerChannel::rotate(){
+	// ofFile forgets its path once closed
+	auto current = ofToDataPathFS(path, true);
+	file.close();
+	std::error_code error;
+	if(maxFiles > 0){
+		of::filesystem::remove(getRotatedPath(maxFiles), error);
+		for(size_t i = maxFiles; i > 1; i--){
+			of::filesystem::rename(getRotatedPath(i - 1), getRotatedPath(i), error);
+		}
+		of::filesystem::rename(current, getRotatedPath(1), error);
+	}
+	file.open(path, ofFile::WriteOnly);
+}
+
+//--------------------------------------------------
+// A bounded multi-producer, single-consumer queue: every slot carries a
+// sequence number saying whether it is free to write for the current lap
+// or holds a message for the writer. Producers claim slots with one
+// compare and swap; the slot strings keep their capacity, so once they
+// have grown, queueing a message does not allocate.
+struct ofAsyncLoggerChannel::Queue{
+	struct Slot{
+		std::atomic<size_t> sequence;
+		ofLogLevel level;
+		string module;
+		string message;
+	};
+
+	std::vector<Slot> slots;
+	size_t mask;
+	ofLogOverflow overflow;
+	shared_ptr<ofBaseLoggerChannel> channel;
+
+	std::atomic<size_t> enqueuePos {0};
+	size_t dequeuePos = 0; // only touched by the writer
+	// flush() asks for everything queued before it to be flushed: the
+	// writer flushes the channel once it has written up to the highest
+	// position asked for, then records how far it flushed
+	std::atomic<size_t> flushRequested {0};
+	std::atomic<size_t> flushed {0};
+	std::atomic<uint64_t> dropped {0};
+	uint64_t droppedReported = 0;
+
+	// Only used to sleep and wake up
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable drained;
+	std::condition_variable room;
+	std::atomic<bool> writerSleeping {false};
+	std::atomic<int> blockedProducers {0};
+	std::atomic<bool> stopping {false};
+	std::thread writer;
+
+	Queue(shared_ptr<ofBaseLoggerChannel> channel, size_t capacity, ofLogOverflow overflow)
+	:slots(roundUpToPow2(capacity))
+	,mask(slots.size() - 1)
+	,overflow(overflow)
+	,channel(channel){
+		for(size_t i = 0; i < slots.size(); i++){
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		writer = std::thread(&Queue::run, this);
+	}
+
+	static size_t roundUpToPow2(size_t capacity){
+		size_t size = 2;
+		while(size < capacity){
+			size *= 2;
+		}
+		return size;
+	}
+
+	bool tryPush(ofLogLevel level, const string & module, const string & message){
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		while(true){
+			Slot & slot = slots[pos & mask];
+			size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+			if(diff == 0){
+				if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+					slot.level = level;
+					slot.module = module;
+					slot.message = message;
+					slot.sequence.store(pos + 1, std::memory_order_seq_cst);
+					if(writerSleeping.load(std::memory_order_seq_cst)){
+						std::unique_lock<std::mutex> lock(mutex);
+						wake.notify_one();
+					}
+					return true;
+				}
+			}else if(diff < 0){
+				return false;
+			}else{
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void push(ofLogLevel level, const string & module, const string & message){
+		while(!tryPush(level, module, message)){
+			if(overflow == OF_LOG_OVERFLOW_DROP || stopping.load(std::memory_order_seq_cst)){
+				dropped++;
+				return;
+			}
+			// OF_LOG_OVERFLOW_BLOCK: sleep until the writer frees a slot
+			std::unique_lock<std::mutex> lock(mutex);
+			blockedProducers++;
+			room.wait(lock, [this]{
+				return hasRoom() || stopping.load(std::memory_order_seq_cst);
+			});
+			blockedProducers--;
+		}
+	}
+
+	bool hasRoom(){
+		size_t pos = enqueuePos.load(std::memory_order_seq_cst);
+		size_t sequence = slots[pos & mask].sequence.load(std::memory_order_seq_cst);
+		return intptr_t(sequence) - intptr_t(pos) >= 0;
+	}
+
+	bool hasMessage(){
+		return slots[dequeuePos & mask].sequence.load(std::memory_order_seq_cst) == dequeuePos + 1;
+	}
+
+	void run(){
+		while(true){
+			while(hasMessage()){
+				Slot & slot = slots[dequeuePos & mask];
+				channel->log(slot.level, slot.module, slot.message);
+				slot.sequence.store(dequeuePos + mask + 1, std::memory_order_seq_cst);
+				dequeuePos++;
+				flushIfRequested();
+				if(blockedProducers.load(std::memory_order_seq_cst) > 0){
+					std::unique_lock<std::mutex> lock(mutex);
+					room.notify_all();
+				}
+			}
+
+			uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+			if(droppedNow != droppedReported){
+				channel->log(OF_LOG_WARNING, "ofAsyncLoggerChannel", ofToString(droppedNow - droppedReported) + " messages dropped, the log queue was full");
+				droppedReported = droppedNow;
+			}
+
+			flushIfRequested();
+
+			std::unique_lock<std::mutex> lock(mutex);
+			writerSleeping.store(true, std::memory_order_seq_cst);
+			wake.wait(lock, [this]{
+				return hasMessage() || stopping.load(std::memory_order_seq_cst) || flushPending();
+			});
+			writerSleeping.store(false, std::memory_order_relaxed);
+			if(stopping.load(std::memory_order_relaxed) && !hasMessage()){
+				break;
+			}
+		}
+		channel->flush();
+		std::unique_lock<std::mutex> lock(mutex);
+		flushed.store(dequeuePos, std::memory_order_seq_cst);
+		drained.notify_all();
+	}
+
+	// A flush was asked for and everything it waits for is written. Only
+	// called from the writer
+	bool flushPending(){
+		size_t requested = flushRequested.load(std::memory_order_seq_cst);
+		return requested > flushed.load(std::memory_order_relaxed) && dequeuePos >= requested;
+	}
+
+	// Called after every message, so a flush() returns as soon as its
+	// messages are out even if others keep logging
+	void flushIfRequested(){
+		if(flushPending()){
+			channel->flush();
+			std::unique_lock<std::mutex> lock(mutex);
+			flushed.store(dequeuePos, std::memory_order_seq_cst);
+			drained.notify_all();
+		}
+	}
+
+	void flush(){
+		if(std::this_thread::get_id() == writer.get_id()){
+			return;
+		}
+		size_t target = enqueuePos.load(std::memory_order_seq_cst);
+		std::unique_lock<std::mutex> lock(mutex);
+		if(flushed.load(std::memory_order_seq_cst) >= target){
+			return;
+		}
+		if(flushRequested.load(std::memory_order_relaxed) < target){
+			flushRequested.store(target, std::memory_order_seq_cst);
+		}
+		wake.notify_one();
+		drained.wait(lock, [&]{
+			return flushed.load(std::memory_order_seq_cst) >= target;
+		});
+	}
+
+	~Queue(){
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			stopping = true;
+			wake.notify_one();
+			room.notify_all();
+		}
+		writer.join();
+	}
+};
+
+ofAsyncLoggerChannel::ofAsyncLoggerChannel(shared_ptr<ofBaseLoggerChannel> channel, size_t capacity, ofLogOverflow overflow)
+:queue(std::make_unique<Queue>(channel, capacity, overflow)){
+}
+
+ofAsyncLoggerChannel::~ofAsyncLoggerChannel(){
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const string & message){
+	queue->push(level, module, message);
+	// The app may be about to go down, get it on disk first
+	if(level == OF_LOG_FATAL_ERROR){
+		queue->flush();
+	}
 }
 
+void ofAsyncLoggerChannel::flush(){
+	queue->flush();
+}
+
+shared_ptr<ofBaseLoggerChannel> ofAsyncLoggerChannel::getChannel() const{
+	return queue->channel;
+}
+
+uint64_t ofAsyncLoggerChannel::getDropped() const{
+	return queue->dropped.load(std::memory_order_relaxed);
+}
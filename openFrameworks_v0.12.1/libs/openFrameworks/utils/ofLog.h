@@ -693,6 +693,11 @@ public:
 	/// \param message The log message.
 	virtual void log(ofLogLevel level, const std::string & module, const std::string & message)=0;
 
+	/// \brief Write out anything the channel is still holding on to.
+	///
+	/// Called by openFrameworks when the app exits.
+	virtual void flush(){}
+
 
 	/// \brief Log a message.
 	/// \param level The log level.
@@ -743,11 +748,78 @@ public:
 
 	void log(ofLogLevel level, const std::string & module, const std::string & message);
 
+	void flush();
+
+	/// \brief Start a new log file once the current one grows past a size.
+	///
+	/// The full file is renamed to `name.1.ext`, pushing older ones up to
+	/// `name.maxFiles.ext`; anything older than that is deleted.
+	///
+	/// \param maxBytes The largest a log file may grow to, 0 to never rotate.
+	/// \param maxFiles The number of old log files to keep.
+	void setRotation(size_t maxBytes, size_t maxFiles = 5);
+
 	/// \brief CLose the log file.
 	void close();
 
 private:
+	void rotate();
+	of::filesystem::path getRotatedPath(size_t index) const;
+
 	ofFile file; ///< The location of the log file.
+	of::filesystem::path path; ///< The path the log file was opened with.
+	size_t maxBytes = 0; ///< The size at which the log file is rotated, 0 for never.
+	size_t maxFiles = 5; ///< The number of rotated log files to keep.
+};
+
+/// \brief What an ofAsyncLoggerChannel does with a message when its queue is full.
+enum ofLogOverflow{
+	/// \brief Throw the message away and count it. Logging never blocks.
+	OF_LOG_OVERFLOW_DROP,
+	/// \brief Wait until the writer thread makes room.
+	OF_LOG_OVERFLOW_BLOCK
+};
+
+/// \brief A logger channel that hands messages to a background thread, which
+/// passes them on to another channel.
+///
+/// Logging from a busy thread then only costs copying the message into a
+/// preallocated slot of a lock-free queue; a slow disk or terminal only ever
+/// stalls the writer thread. Messages from one thread keep their order.
+///
+/// ~~~~{.cpp}
+/// ofSetLoggerChannel(std::make_shared<ofAsyncLoggerChannel>(
+/// 	std::make_shared<ofFileLoggerChannel>("log.txt", true)));
+/// ~~~~
+///
+/// Fatal errors are written before ofLog returns. Everything else is written
+/// when the writer gets to it, at the latest on flush(), which openFrameworks
+/// calls on exit, or when the channel is destroyed.
+class ofAsyncLoggerChannel: public ofBaseLoggerChannel{
+public:
+	/// \brief Create an ofAsyncLoggerChannel.
+	/// \param channel The channel the writer thread logs to.
+	/// \param capacity The number of messages that can wait to be written.
+	/// \param overflow What to do with a message when that many are waiting.
+	ofAsyncLoggerChannel(std::shared_ptr<ofBaseLoggerChannel> channel, size_t capacity = 1024, ofLogOverflow overflow = OF_LOG_OVERFLOW_DROP);
+
+	/// \brief Write out every waiting message and stop the writer thread.
+	virtual ~ofAsyncLoggerChannel();
+
+	void log(ofLogLevel level, const std::string & module, const std::string & message);
+
+	/// \brief Block until every message logged before the call is written.
+	void flush();
+
+	/// \brief The channel the writer thread logs to.
+	std::shared_ptr<ofBaseLoggerChannel> getChannel() const;
+
+	/// \brief The number of messages thrown away because the queue was full.
+	uint64_t getDropped() const;
+
+private:
+	struct Queue;
+	std::unique_ptr<Queue> queue;
 };
 
 /// \endcond
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <condition_variable>
+
+/// \brief Send data from exactly one thread to exactly one other thread
+/// without taking a lock.
+///
+/// ofSpscChannel has the same send / receive / tryReceive / close interface as
+/// ofThreadChannel, but is backed by a fixed size ring buffer instead of a
+/// queue behind a mutex. While the channel is neither empty nor full, sending
+/// and receiving are wait-free: a few atomic loads and stores, no lock and no
+/// system call.
+///
+/// The price is that it is only safe with a single sending thread and a
+/// single receiving thread, e.g. a camera thread feeding an analysis thread,
+/// or a worker thread handing results back to the main thread. Use
+/// ofThreadChannel when several threads send or receive on the same channel.
+///
+/// Since the buffer is bounded, ofSpscChannel::send blocks while the channel
+/// is full; use ofSpscChannel::trySend to give up instead. Threads that have to
+/// wait spin for a short while before going to sleep, so a value that arrives
+/// soon is picked up without the cost of a wake up.
+///
+/// ~~~~{.cpp}
+/// ofSpscChannel<ofPixels> toAnalyze(4);
+/// ~~~~
+///
+/// \tparam T The data type sent by the ofSpscChannel.
+template<typename T>
+class ofSpscChannel{
+public:
+	/// \brief Create an ofSpscChannel that holds up to `capacity` values.
+	///
+	/// The capacity is rounded up to a power of two.
+	///
+	/// \param capacity The number of values that can be sent without being received.
+	explicit ofSpscChannel(size_t capacity = 64)
+	:closed(false)
+	,receiverWaiting(false)
+	,senderWaiting(false){
+		size_t size = 1;
+		while(size < capacity){
+			size *= 2;
+		}
+		slots.resize(size);
+		mask = size - 1;
+		head = 0;
+		tail = 0;
+		cachedHead = 0;
+		cachedTail = 0;
+	}
+
+	ofSpscChannel(const ofSpscChannel &) = delete;
+	ofSpscChannel & operator=(const ofSpscChannel &) = delete;
+
+	/// \brief Block the receiving thread until a new sent value is available.
+	///
+	/// Like ofThreadChannel::receive, the value is swapped out of the channel
+	/// rather than copied.
+	///
+	/// \param sentValue A reference to a sent value.
+	/// \returns True if a new value was received or false if the ofSpscChannel was closed.
+	bool receive(T & sentValue){
+		while(!tryReceive(sentValue)){
+			if(closed.load(std::memory_order_acquire)){
+				return false;
+			}
+			waitToReceive(nullptr);
+		}
+		return true;
+	}
+
+	/// \brief If available, receive a new sent value without blocking.
+	///
+	/// \param sentValue A reference to a sent value.
+	/// \returns True if a new value was received or false if there was none or the ofSpscChannel was closed.
+	bool tryReceive(T & sentValue){
+		if(closed.load(std::memory_order_acquire)){
+			return false;
+		}
+		size_t current = head.load(std::memory_order_relaxed);
+		if(current == cachedTail){
+			cachedTail = tail.load(std::memory_order_acquire);
+			if(current == cachedTail){
+				return false;
+			}
+		}
+		std::swap(sentValue, slots[current & mask]);
+		head.store(current + 1, std::memory_order_seq_cst);
+		if(senderWaiting.load(std::memory_order_seq_cst)){
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.notify_all();
+		}
+		return true;
+	}
+
+	/// \brief If available, receive a new sent value or wait for a user-specified duration.
+	///
+	/// \param sentValue A reference to a sent value.
+	/// \param timeoutMs The number of milliseconds to wait for new data before continuing.
+	/// \returns True if a new value was received or false if there was none or the ofSpscChannel was closed.
+	bool tryReceive(T & sentValue, int64_t timeoutMs){
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+		while(!tryReceive(sentValue)){
+			if(closed.load(std::memory_order_acquire) || !waitToReceive(&deadline)){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// \brief Send a value to the receiver by making a copy, waiting while the channel is full.
+	///
+	/// \returns true if the value was sent successfully or false if the channel was closed.
+	bool send(const T & value){
+		T copy(value);
+		return send(std::move(copy));
+	}
+
+	/// \brief Send a value to the receiver without making a copy, waiting while the channel is full.
+	///
+	/// As with ofThreadChannel, the original data is invalidated even if the
+	/// send fails because the channel is already closed.
+	///
+	/// \returns true if the value was sent successfully or false if the channel was closed.
+	bool send(T && value){
+		while(!trySend(std::move(value))){
+			if(closed.load(std::memory_order_acquire)){
+				return false;
+			}
+			waitToSend();
+		}
+		return true;
+	}
+
+	/// \brief Send a value to the receiver if there is room, without blocking.
+	///
+	/// `value` is only moved from if the send succeeds.
+	///
+	/// \returns true if the value was sent or false if the channel was full or closed.
+	bool trySend(T && value){
+		if(closed.load(std::memory_order_acquire)){
+			return false;
+		}
+		size_t current = tail.load(std::memory_order_relaxed);
+		if(current - cachedHead > mask){
+			cachedHead = head.load(std::memory_order_acquire);
+			if(current - cachedHead > mask){
+				return false;
+			}
+		}
+		slots[current & mask] = std::move(value);
+		tail.store(current + 1, std::memory_order_seq_cst);
+		if(receiverWaiting.load(std::memory_order_seq_cst)){
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.notify_all();
+		}
+		return true;
+	}
+
+	/// \brief Send a copy of a value to the receiver if there is room, without blocking.
+	///
+	/// \returns true if the value was sent or false if the channel was full or closed.
+	bool trySend(const T & value){
+		if(full()){
+			return false;
+		}
+		T copy(value);
+		return trySend(std::move(copy));
+	}
+
+	/// \brief Close the ofSpscChannel.
+	///
+	/// Closing the ofSpscChannel means that no new messages can be sent or
+	/// received. A thread waiting to send or receive is woken up and returns
+	/// false. This may be called from any thread.
+	void close(){
+		std::unique_lock<std::mutex> lock(mutex);
+		closed.store(true, std::memory_order_seq_cst);
+		condition.notify_all();
+	}
+
+	/// \brief Drop every value that has not been received yet.
+	///
+	/// Only the receiving thread may call this.
+	void clear(){
+		head.store(tail.load(std::memory_order_acquire), std::memory_order_seq_cst);
+		if(senderWaiting.load(std::memory_order_seq_cst)){
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.notify_all();
+		}
+	}
+
+	/// \brief Queries empty channel.
+	///
+	/// This call is only an approximation when called from a thread other than
+	/// the receiver.
+	bool empty() const{
+		return size() == 0;
+	}
+
+	/// \brief Queries if the channel is full.
+	///
+	/// This call is only an approximation when called from a thread other than
+	/// the sender.
+	bool full() const{
+		return size() > mask;
+	}
+
+	/// \brief Queries the number of values waiting to be received.
+	///
+	/// This call is only an approximation, since values are sent and received
+	/// from different threads.
+	size_t size() const{
+		size_t currentHead = head.load(std::memory_order_acquire);
+		size_t currentTail = tail.load(std::memory_order_acquire);
+		return currentTail - currentHead;
+	}
+
+	/// \brief The number of values the channel can hold.
+	size_t capacity() const{
+		return mask + 1;
+	}
+
+private:
+	/// \brief Spin for a moment, then sleep until a value is sent, the
+	/// channel is closed or the deadline passes.
+	/// \returns false if the deadline passed.
+	bool waitToReceive(const std::chrono::steady_clock::time_point * deadline){
+		auto ready = [this]{
+			return tail.load(std::memory_order_seq_cst) != head.load(std::memory_order_relaxed)
+				|| closed.load(std::memory_order_seq_cst);
+		};
+		if(spin(ready)){
+			return true;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+		receiverWaiting.store(true, std::memory_order_seq_cst);
+		bool woken = true;
+		if(deadline){
+			woken = condition.wait_until(lock, *deadline, ready);
+		}else{
+			condition.wait(lock, ready);
+		}
+		receiverWaiting.store(false, std::memory_order_relaxed);
+		return woken;
+	}
+
+	/// \brief Spin for a moment, then sleep until there is room or the
+	/// channel is closed.
+	void waitToSend(){
+		auto ready = [this]{
+			return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_seq_cst) <= mask
+				|| closed.load(std::memory_order_seq_cst);
+		};
+		if(spin(ready)){
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+		senderWaiting.store(true, std::memory_order_seq_cst);
+		condition.wait(lock, ready);
+		senderWaiting.store(false, std::memory_order_relaxed);
+	}
+
+	template<typename Ready>
+	static bool spin(Ready ready){
+		for(int i = 0; i < spinCount; i++){
+			if(ready()){
+				return true;
+			}
+			if(i >= spinCount / 2){
+				std::this_thread::yield();
+			}
+		}
+		return false;
+	}
+
+	static constexpr int spinCount = 64;
+	static constexpr size_t cacheLine = 64;
+
+	/// \brief The ring buffer, a power of two long.
+	std::vector<T> slots;
+	size_t mask;
+
+	/// \brief The next slot to receive from, written only by the receiver.
+	alignas(cacheLine) std::atomic<size_t> head;
+	/// \brief The receiver's last look at tail, so it only touches the
+	/// sender's cache line when it seems to have run out.
+	size_t cachedTail;
+
+	/// \brief The next slot to send to, written only by the sender.
+	alignas(cacheLine) std::atomic<size_t> tail;
+	/// \brief The sender's last look at head.
+	size_t cachedHead;
+
+	/// \brief Only used to sleep and wake up, never on the fast path.
+	alignas(cacheLine) std::mutex mutex;
+	std::condition_variable condition;
+	std::atomic<bool> closed;
+	std::atomic<bool> receiverWaiting;
+	std::atomic<bool> senderWaiting;
+};
@@ -1,9 +1,24 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <mutex>
 #include <queue>
 #include <condition_variable>
 
+/// \brief What ofThreadChannel::send does when a bounded channel is full.
+enum ofThreadChannelOverflow{
+	/// \brief Wait until the receiver makes room or the channel is closed.
+	OF_CHANNEL_OVERFLOW_BLOCK,
+	/// \brief Return false right away, leaving the queued values alone.
+	OF_CHANNEL_OVERFLOW_FAIL,
+	/// \brief Throw away the oldest queued value to make room.
+	OF_CHANNEL_OVERFLOW_DROP_OLDEST,
+	/// \brief Throw away everything queued, so only the newest value is
+	/// ever waiting. The capacity is ignored.
+	OF_CHANNEL_OVERFLOW_KEEP_LATEST
+};
+
 /// \brief Safely send data between threads without additional synchronization.
 ///
 /// ofThreadChannel makes it easy to safely and efficiently share data between
@@ -23,6 +38,15 @@
 /// If multiple threads attempt to send data using the same ofThreadChannel, the
 /// send method will block the calling thread until it is free.
 ///
+/// By default the channel is unbounded: if the receiver falls behind, values
+/// pile up. A channel created with a capacity instead keeps at most that many
+/// values and handles the overflow as its ofThreadChannelOverflow says, which
+/// bounds both the memory it uses and how stale the values it hands out are:
+/// ~~~~{.cpp}
+/// 	// A 30fps camera feeding slower analysis: only the newest frame waits
+/// 	ofThreadChannel<ofPixels> frames(1, OF_CHANNEL_OVERFLOW_KEEP_LATEST);
+/// ~~~~
+///
 /// \sa https://github.com/openframeworks/ofBook/blob/master/chapters/threads/chapter.md
 /// \tparam T The data type sent by the ofThreadChannel.
 template<typename T>
@@ -35,7 +59,22 @@ public:
 	/// 	ofThreadChannel<ofPixels> myThreadChannel;
 	/// ~~~~
 	ofThreadChannel()
-	:closed(false){}
+	:closed(false)
+	,capacity(0)
+	,overflow(OF_CHANNEL_OVERFLOW_BLOCK)
+	,dropped(0)
+	,highWaterMark(0){}
+
+	/// \brief Create a bounded ofThreadChannel.
+	///
+	/// \param capacity The most values that can wait to be received, 0 for no limit.
+	/// \param overflow What send does when the channel is full.
+	ofThreadChannel(size_t capacity, ofThreadChannelOverflow overflow = OF_CHANNEL_OVERFLOW_BLOCK)
+	:closed(false)
+	,capacity(capacity)
+	,overflow(overflow)
+	,dropped(0)
+	,highWaterMark(0){}
 
 	/// \brief Block the receiving thread until a new sent value is available.
 	///
@@ -72,8 +111,7 @@ public:
 			condition.wait(lock);
 		}
 		if(!closed){
-			std::swap(sentValue,queue.front());
-			queue.pop();
+			pop(sentValue);
 			return true;
 		}else{
 			return false;
@@ -116,8 +154,7 @@ public:
 			return false;
 		}
         if(!queue.empty()){
-			std::swap(sentValue,queue.front());
-			queue.pop();
+			pop(sentValue);
 			return true;
 		}else{
 			return false;
@@ -169,8 +206,7 @@ public:
 		}
 
 		if(!closed){
-			std::swap(sentValue,queue.front());
-			queue.pop();
+			pop(sentValue);
 			return true;
 		}else{
 			return false;
@@ -202,14 +238,15 @@ public:
 	/// }
 	/// ~~~~
 	///
-	/// \returns true if the value was sent successfully or false if the channel was closed.
+	/// \returns true if the value was sent successfully or false if the channel
+	/// was closed, or was full with OF_CHANNEL_OVERFLOW_FAIL.
 	bool send(const T & value){
 		std::unique_lock<std::mutex> lock(mutex);
-		if(closed){
+		if(!makeRoom(lock)){
 			return false;
 		}
 		queue.push(value);
-        condition.notify_one();
+		pushed();
 		return true;
 	}
 
@@ -243,14 +280,18 @@ public:
 	///
 	/// ~~~~
 	///
-	/// \returns true if the value was sent successfully or false if the channel was closed.
+	/// With OF_CHANNEL_OVERFLOW_FAIL the value is left untouched if the
+	/// channel is full.
+	///
+	/// \returns true if the value was sent successfully or false if the channel
+	/// was closed, or was full with OF_CHANNEL_OVERFLOW_FAIL.
 	bool send(T && value){
 		std::unique_lock<std::mutex> lock(mutex);
-		if(closed){
+		if(!makeRoom(lock)){
 			return false;
 		}
 		queue.push(std::move(value));
-        condition.notify_one();
+		pushed();
 		return true;
 	}
 
@@ -259,11 +300,13 @@ public:
 	/// Closing the ofThreadChannel means that no new messages can be sent or
 	/// received. All threads waiting to receive new values will be notified and
 	/// all ofThreadChannel::receive and ofThreadChannel::tryReceive methods
-	/// will return false.
+	/// will return false. Threads blocked sending to a full channel return
+	/// false as well.
 	void close(){
 		std::unique_lock<std::mutex> lock(mutex);
 		closed = true;
 		condition.notify_all();
+		spaceAvailable.notify_all();
 	}
 
 	/// \brief Clear  channel.
@@ -274,6 +317,7 @@ public:
 		if (!queue.empty()) {
 			std::unique_lock<std::mutex> lock(mutex);
 			queue = {};
+			spaceAvailable.notify_all();
 		}
 	}
 
@@ -295,17 +339,109 @@ public:
 		return queue.size();
 	}
 
+	/// \brief The most values that can wait to be received, 0 for no limit.
+	size_t getCapacity() const{
+		return capacity;
+	}
+
+	/// \brief What send does when the channel is full.
+	ofThreadChannelOverflow getOverflow() const{
+		return overflow;
+	}
+
+	/// \brief The number of values thrown away or refused because the channel
+	/// was full.
+	uint64_t getDropped() const{
+		std::unique_lock<std::mutex> lock(mutex);
+		return dropped;
+	}
+
+	/// \brief The most values that were ever waiting at once.
+	size_t getHighWaterMark() const{
+		std::unique_lock<std::mutex> lock(mutex);
+		return highWaterMark;
+	}
+
+	/// \brief Reset the dropped count and the high-water mark.
+	void resetStats(){
+		std::unique_lock<std::mutex> lock(mutex);
+		dropped = 0;
+		highWaterMark = queue.size();
+	}
+
 private:
+	/// \brief Take the front value, waking a sender waiting for room.
+	void pop(T & sentValue){
+		std::swap(sentValue,queue.front());
+		queue.pop();
+		if(capacity > 0 && overflow == OF_CHANNEL_OVERFLOW_BLOCK){
+			spaceAvailable.notify_one();
+		}
+	}
+
+	/// \brief Make room for one more value as the overflow policy says.
+	/// \returns false if the value should not be sent.
+	bool makeRoom(std::unique_lock<std::mutex> & lock){
+		if(closed){
+			return false;
+		}
+		if(overflow == OF_CHANNEL_OVERFLOW_KEEP_LATEST){
+			dropped += queue.size();
+			queue = {};
+			return true;
+		}
+		if(capacity == 0 || queue.size() < capacity){
+			return true;
+		}
+		switch(overflow){
+		case OF_CHANNEL_OVERFLOW_FAIL:
+			dropped++;
+			return false;
+		case OF_CHANNEL_OVERFLOW_DROP_OLDEST:
+			while(queue.size() >= capacity){
+				queue.pop();
+				dropped++;
+			}
+			return true;
+		default:
+			while(queue.size() >= capacity && !closed){
+				spaceAvailable.wait(lock);
+			}
+			return !closed;
+		}
+	}
+
+	/// \brief Wake the receiver and update the high-water mark.
+	void pushed(){
+		highWaterMark = std::max(highWaterMark, queue.size());
+		condition.notify_one();
+	}
+
 	/// \brief The FIFO data queue.
 	std::queue<T> queue;
 
 	/// \brief The mutext to protect the data.
-	std::mutex mutex;
+	mutable std::mutex mutex;
 
 	/// \brief The condition even to notify receivers.
 	std::condition_variable condition;
 
+	/// \brief The condition to notify senders blocked on a full channel.
+	std::condition_variable spaceAvailable;
+
 	/// \brief True if the channel is closed.
 	bool closed;
 
+	/// \brief The most values that can wait to be received, 0 for no limit.
+	size_t capacity;
+
+	/// \brief What send does when the channel is full.
+	ofThreadChannelOverflow overflow;
+
+	/// \brief Values thrown away or refused because the channel was full.
+	uint64_t dropped;
+
+	/// \brief The most values that were ever waiting at once.
+	size_t highWaterMark;
+
 };
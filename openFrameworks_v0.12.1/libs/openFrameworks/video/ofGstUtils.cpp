@@ -1383,9 +1383,15 @@ GstFlowReturn ofGstVideoUtils::process_sample(shared_ptr<GstSample> sample){
 	if(pixels.isAllocated()){
 		if(stride > 0) {
 			if(pixels.getPixelFormat() == OF_PIXELS_I420){
+				// planes can be padded independently, so use gstreamer's offsets
+				// instead of assuming they follow each other
 				GstVideoInfo v_info = getVideoInfo(sample.get());
-				std::vector<size_t> strides{size_t(v_info.stride[0]),size_t(v_info.stride[1]),size_t(v_info.stride[2])};
-				backPixels.setFromAlignedPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat(),strides);
+				std::vector<ofPixelsView::Plane> planes(3);
+				for(size_t i = 0; i < planes.size(); i++){
+					planes[i].data = mapinfo.data + v_info.offset[i];
+					planes[i].stride = v_info.stride[i];
+				}
+				backPixels.setFromPixels(ofPixelsView(pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat(),planes));
 			} else {
 				backPixels.setFromAlignedPixels(mapinfo.data,pixels.getWidth(),pixels.getHeight(),pixels.getPixelFormat(),stride);
 			}
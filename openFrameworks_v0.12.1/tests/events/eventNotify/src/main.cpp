@@ -0,0 +1,197 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+using namespace std::chrono;
+
+// exposes the replaced listener lists still waiting to be deleted
+class RetiringEvent: public ofEvent<int>{
+public:
+	size_t getNumRetired(){
+		std::unique_lock<std::recursive_mutex> lck(self->mtx);
+		return self->retired.size();
+	}
+};
+
+class ofApp: public ofxUnitTestsApp{
+	// average cost of one notify with the given number of listeners, in
+	// nanoseconds, while `threads` threads notify the same event at once
+	double notifyCost(size_t numListeners, size_t threads, int count){
+		ofEvent<int> event;
+		std::vector<ofEventListener> listeners(numListeners);
+		std::atomic<int> sum{0};
+		for(auto & listener: listeners){
+			listener = event.newListener([&sum](int & value){
+				sum.fetch_add(value, std::memory_order_relaxed);
+			});
+		}
+		auto start = steady_clock::now();
+		std::vector<std::thread> notifiers;
+		for(size_t t = 0; t < threads; t++){
+			notifiers.emplace_back([&]{
+				int one = 1;
+				for(int i = 0; i < count; i++){
+					event.notify(one);
+				}
+			});
+		}
+		for(auto & notifier: notifiers){
+			notifier.join();
+		}
+		return duration<double, std::nano>(steady_clock::now() - start).count() / (count * threads);
+	}
+
+	void run(){
+		ofLogNotice() << "testing notify order";
+		{
+			ofEvent<int> event;
+			std::vector<int> order;
+			auto late = event.newListener([&](int &){ order.push_back(3); }, OF_EVENT_ORDER_AFTER_APP);
+			auto early = event.newListener([&](int &){ order.push_back(1); }, OF_EVENT_ORDER_BEFORE_APP);
+			auto app = event.newListener([&](int &){ order.push_back(2); }, OF_EVENT_ORDER_APP);
+			int value = 0;
+			event.notify(value);
+			ofxTest(order == std::vector<int>({1, 2, 3}), "listeners are notified once each in priority order");
+		}
+
+		ofLogNotice() << "testing listeners changing during notify";
+		{
+			ofEvent<void> event;
+			int selfRemovingCalls = 0;
+			int otherCalls = 0;
+			int addedCalls = 0;
+			ofEventListener selfRemoving;
+			ofEventListener added;
+			selfRemoving = event.newListener([&]{
+				selfRemovingCalls++;
+				added = event.newListener([&]{ addedCalls++; });
+				selfRemoving.unsubscribe();
+			}, OF_EVENT_ORDER_BEFORE_APP);
+			auto other = event.newListener([&]{ otherCalls++; });
+			event.notify();
+			ofxTestEq(selfRemovingCalls, 1, "a listener removing itself finishes its call");
+			ofxTestEq(otherCalls, 1, "the other listeners still run in that notify");
+			ofxTestEq(addedCalls, 0, "a listener added during a notify waits for the next one");
+			event.notify();
+			ofxTestEq(selfRemovingCalls, 1, "a removed listener isn't called again");
+			ofxTestEq(otherCalls, 2, "the other listeners keep being called");
+			ofxTestEq(addedCalls, 1, "the added listener is called by the next notify");
+		}
+
+		ofLogNotice() << "testing a listener destroying the event";
+		{
+			auto event = std::make_unique<ofEvent<void>>();
+			int calls = 0;
+			// the listener owned by the destroyed event runs, and the
+			// following ones must still see valid listeners
+			ofEventListener destroying = event->newListener([&]{
+				calls++;
+				event.reset();
+			}, OF_EVENT_ORDER_BEFORE_APP);
+			ofEventListener after = event->newListener([&]{ calls++; });
+			event->notify();
+			ofxTest(!event, "the event was destroyed during its notify");
+			ofxTestEq(calls, 2, "notify finishes walking the listeners after its event is gone");
+			destroying.unsubscribe();
+			after.unsubscribe();
+		}
+
+		ofLogNotice() << "testing many listener changes";
+		{
+			ofEvent<int> event;
+			int sum = 0;
+			auto first = event.newListener([&](int & value){ sum += value; });
+			for(int i = 0; i < 1000; i++){
+				ofEventListener temporary = event.newListener([&](int & value){ sum += value * 1000; });
+			}
+			int one = 1;
+			event.notify(one);
+			ofxTestEq(sum, 1, "only the remaining listener is notified after adding and removing many");
+			ofxTestEq(event.size(), 1u, "the removed listeners are gone");
+		}
+
+		ofLogNotice() << "testing concurrent notify and removal";
+		{
+			ofEvent<int> event;
+			std::atomic<bool> done{false};
+			std::atomic<int> calls{0};
+			auto keep = event.newListener([&](int &){ calls++; });
+			std::thread notifier([&]{
+				int one = 1;
+				while(!done){
+					event.notify(one);
+				}
+			});
+			for(int i = 0; i < 10000; i++){
+				ofEventListener temporary = event.newListener([&](int &){ calls++; });
+			}
+			done = true;
+			notifier.join();
+			ofxTestGt(calls.load(), 0, "notify keeps working while listeners come and go on another thread");
+		}
+
+		ofLogNotice() << "testing replaced listener lists are deleted";
+		{
+			// outlives the event, so it's never removed while it's running
+			ofEventListener churn;
+			RetiringEvent event;
+			std::vector<ofEventListener> listeners(50);
+			int calls = 0;
+			for(auto & listener: listeners){
+				listener = event.newListener([&](int &){ calls++; });
+			}
+			// creates and destroys a listening object on every notify
+			churn = event.newListener([&](int &){
+				ofEventListener temporary = event.newListener([](int &){});
+			});
+			bool bounded = true;
+			int one = 1;
+			for(int i = 0; i < 20000; i++){
+				event.notify(one);
+				bounded &= event.getNumRetired() == 0;
+			}
+			ofxTest(bounded, "lists replaced during a notify are deleted when it ends");
+
+			{
+				ofEventListener temporary = event.newListener([](int &){});
+			}
+			ofxTestEq(event.getNumRetired(), 0u, "lists replaced outside a notify are deleted right away");
+		}
+		{
+			RetiringEvent event;
+			auto keep = event.newListener([](int &){});
+			std::atomic<bool> done{false};
+			std::thread notifier([&]{
+				int one = 1;
+				while(!done){
+					event.notify(one);
+				}
+			});
+			for(int i = 0; i < 2000; i++){
+				ofEventListener temporary = event.newListener([](int &){});
+			}
+			done = true;
+			notifier.join();
+			ofxTestEq(event.getNumRetired(), 0u, "lists replaced while another thread notifies are deleted once it stops");
+		}
+
+		ofLogNotice() << "benchmarking notify against the number of listeners";
+		{
+			const int count = 200000;
+			for(size_t listeners: {0, 1, 4, 16, 64}){
+				ofLogNotice() << listeners << " listeners: "
+					<< ofToString(notifyCost(listeners, 1, count), 1) << "ns per notify, "
+					<< ofToString(notifyCost(listeners, 4, count), 1) << "ns with 4 threads notifying";
+			}
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
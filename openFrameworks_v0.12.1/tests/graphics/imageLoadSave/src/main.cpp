@@ -0,0 +1,147 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	// a 2x2 24 bit BMP written by hand, red on top and blue at the bottom,
+	// so it doesn't depend on ofSaveImage getting the channel order right
+	static ofBuffer redOverBlueBmp(){
+		auto le16 = [](std::vector<char> & bytes, uint16_t v){
+			bytes.push_back(v & 0xFF);
+			bytes.push_back(v >> 8);
+		};
+		auto le32 = [&](std::vector<char> & bytes, uint32_t v){
+			le16(bytes, v & 0xFFFF);
+			le16(bytes, v >> 16);
+		};
+		std::vector<char> bytes = {'B', 'M'};
+		le32(bytes, 14 + 40 + 16);
+		le32(bytes, 0);
+		le32(bytes, 14 + 40);
+		le32(bytes, 40);
+		le32(bytes, 2);
+		le32(bytes, 2);
+		le16(bytes, 1);
+		le16(bytes, 24);
+		le32(bytes, 0);
+		le32(bytes, 16);
+		le32(bytes, 2835);
+		le32(bytes, 2835);
+		le32(bytes, 0);
+		le32(bytes, 0);
+		// rows are bottom up, BGR, padded to 4 bytes
+		const char blue[] = {char(255), 0, 0, char(255), 0, 0, 0, 0};
+		const char red[] = {0, 0, char(255), 0, 0, char(255), 0, 0};
+		bytes.insert(bytes.end(), std::begin(blue), std::end(blue));
+		bytes.insert(bytes.end(), std::begin(red), std::end(red));
+		return ofBuffer(bytes.data(), bytes.size());
+	}
+
+	static ofPixels solid(const ofColor & color, ofPixelFormat format){
+		ofPixels pixels;
+		pixels.allocate(8, 8, format);
+		pixels.setColor(color);
+		return pixels;
+	}
+
+	static bool isRed(const ofPixels & pixels){
+		auto color = pixels.getColor(0, 0);
+		return color.r > 240 && color.g < 16 && color.b < 16;
+	}
+
+	static bool isRgb(const ofPixels & pixels){
+		return pixels.getPixelFormat() == OF_PIXELS_RGB || pixels.getPixelFormat() == OF_PIXELS_RGBA;
+	}
+
+	void run(){
+		ofDirectory::createDirectory(ofToDataPath(""), false, true);
+
+		ofLogNotice() << "testing loading a known image";
+		{
+			ofPixels pixels;
+			ofxTest(ofLoadImage(pixels, redOverBlueBmp()), "a BMP loads from a buffer");
+			ofxTestEq(pixels.getPixelFormat(), OF_PIXELS_RGB, "a 24 bit image loads as RGB");
+			ofxTest(isRed(pixels), "the top row is red");
+			auto bottom = pixels.getColor(0, 1);
+			ofxTest(bottom.b > 240 && bottom.r < 16, "the bottom row is blue");
+
+			ofBufferToFile("red_over_blue.bmp", redOverBlueBmp(), true);
+			ofPixels fromFile;
+			ofxTest(ofLoadImage(fromFile, "red_over_blue.bmp"), "a BMP loads from a file");
+			ofxTest(isRed(fromFile) && fromFile.getPixelFormat() == OF_PIXELS_RGB, "a file loads the same as a buffer");
+
+			ofPixels reused = solid(ofColor::green, OF_PIXELS_RGB);
+			reused.resize(2, 2);
+			ofLoadImage(reused, redOverBlueBmp());
+			ofxTest(isRed(reused) && reused.getPixelFormat() == OF_PIXELS_RGB, "loading into pixels of the same size keeps the channel order");
+			ofFile::removeFile("red_over_blue.bmp");
+		}
+
+		ofLogNotice() << "testing save and load round trips";
+		{
+			for(auto format: {OF_PIXELS_RGB, OF_PIXELS_RGBA, OF_PIXELS_BGR}){
+				for(std::string extension: {"png", "bmp", "jpg", "tif"}){
+					if(extension == "jpg" && format != OF_PIXELS_RGB){
+						continue;
+					}
+					auto name = "red_" + ofToString(format) + "." + extension;
+					ofPixels loaded;
+					bool saved = ofSaveImage(solid(ofColor::red, format), name);
+					ofxTest(saved && ofLoadImage(loaded, name), name + " saves and loads");
+					ofxTest(isRed(loaded), name + " is still red");
+					ofxTest(isRgb(loaded), name + " loads as RGB");
+					ofFile::removeFile(name);
+				}
+			}
+
+			ofBuffer buffer;
+			ofPixels loaded;
+			ofxTest(ofSaveImage(solid(ofColor::red, OF_PIXELS_RGBA), buffer, OF_IMAGE_FORMAT_PNG) && ofLoadImage(loaded, buffer), "a PNG saves and loads through a buffer");
+			ofxTest(isRed(loaded) && loaded.getPixelFormat() == OF_PIXELS_RGBA, "a buffer round trip keeps the color and alpha");
+
+			ofShortPixels shorts;
+			shorts.allocate(8, 8, OF_PIXELS_RGB);
+			shorts.setColor(ofShortColor(65535, 0, 0));
+			ofShortPixels shortsLoaded;
+			ofxTest(ofSaveImage(shorts, "red_16.png") && ofLoadImage(shortsLoaded, "red_16.png"), "16 bit pixels save and load");
+			ofxTest(shortsLoaded.getColor(0, 0).r > 65000 && shortsLoaded.getColor(0, 0).b < 500, "16 bit pixels are still red");
+			ofFile::removeFile("red_16.png");
+		}
+
+		ofLogNotice() << "testing async and batch load and save";
+		{
+			auto saving = ofSaveImageAsync(solid(ofColor::red, OF_PIXELS_RGB), "red_async.png");
+			ofxTest(saving.get(), "an async save finishes");
+			ofPixels loaded;
+			ofxTest(ofLoadImage(loaded, "red_async.png") && isRed(loaded), "an async save is red");
+			ofFile::removeFile("red_async.png");
+
+			std::vector<ofPixels> images;
+			std::vector<of::filesystem::path> paths;
+			for(size_t i = 0; i < 8; i++){
+				images.push_back(solid(ofColor::red, i % 2 ? OF_PIXELS_RGBA : OF_PIXELS_RGB));
+				paths.push_back("red_batch_" + ofToString(i) + ".png");
+			}
+			auto saved = ofSaveImages(images, paths, OF_IMAGE_QUALITY_BEST, 4);
+			ofxTest(std::all_of(saved.begin(), saved.end(), [](bool ok){ return ok; }), "a batch of images saves");
+
+			std::vector<ofPixels> batch;
+			auto loadedBatch = ofLoadImages(batch, paths, ofImageLoadSettings(), 4);
+			ofxTest(std::all_of(loadedBatch.begin(), loadedBatch.end(), [](bool ok){ return ok; }), "a batch of images loads");
+			ofxTestEq(batch.size(), paths.size(), "a batch loads one image per path");
+			ofxTest(std::all_of(batch.begin(), batch.end(), [](const ofPixels & p){ return isRed(p) && isRgb(p); }), "a batch loads red RGB images");
+			for(auto & path: paths){
+				ofFile::removeFile(path);
+			}
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
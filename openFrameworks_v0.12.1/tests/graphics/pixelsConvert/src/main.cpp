@@ -0,0 +1,154 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	static bool equal(const ofPixels & a, const ofPixels & b){
+		return a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight()
+			&& a.getPixelFormat() == b.getPixelFormat()
+			&& std::equal(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+	static int maxDifference(const ofPixels & a, const ofPixels & b){
+		int difference = 0;
+		for(size_t i = 0; i < a.size() && i < b.size(); i++){
+			difference = std::max(difference, std::abs(int(a[i]) - int(b[i])));
+		}
+		return difference;
+	}
+
+	static ofPixels solid(const ofColor & color, ofPixelFormat format = OF_PIXELS_RGB){
+		ofPixels pixels;
+		pixels.allocate(4, 4, format);
+		pixels.setColor(color);
+		return pixels;
+	}
+
+	// the luma of a color, converted to gray with the given matrix
+	static int luma(const ofColor & color, ofColorMatrix matrix){
+		ofPixels gray;
+		solid(color).convertTo(gray, OF_PIXELS_GRAY, matrix);
+		return gray[0];
+	}
+
+	// the video range Y of a color, converted to NV12 with the given matrix
+	static int videoY(const ofColor & color, ofColorMatrix matrix){
+		ofPixels nv12;
+		solid(color).convertTo(nv12, OF_PIXELS_NV12, matrix);
+		return nv12[0];
+	}
+
+	void run(){
+		ofLogNotice() << "testing luma values";
+		{
+			// BT.601: 0.299 R + 0.587 G + 0.114 B
+			ofxTestLt(std::abs(luma(ofColor::red, OF_COLOR_MATRIX_BT601) - 76), 2, "BT.601 red luma");
+			ofxTestLt(std::abs(luma(ofColor::green, OF_COLOR_MATRIX_BT601) - 150), 2, "BT.601 green luma");
+			ofxTestLt(std::abs(luma(ofColor::blue, OF_COLOR_MATRIX_BT601) - 29), 2, "BT.601 blue luma");
+			// BT.709: 0.2126 R + 0.7152 G + 0.0722 B
+			ofxTestLt(std::abs(luma(ofColor::red, OF_COLOR_MATRIX_BT709) - 54), 2, "BT.709 red luma");
+			ofxTestLt(std::abs(luma(ofColor::green, OF_COLOR_MATRIX_BT709) - 182), 2, "BT.709 green luma");
+			ofxTestLt(std::abs(luma(ofColor::blue, OF_COLOR_MATRIX_BT709) - 18), 2, "BT.709 blue luma");
+			ofxTestEq(luma(ofColor::white, OF_COLOR_MATRIX_BT601), 255, "white luma is 255");
+			ofxTestEq(luma(ofColor::black, OF_COLOR_MATRIX_BT709), 0, "black luma is 0");
+
+			ofPixels bgr;
+			solid(ofColor::red).convertTo(bgr, OF_PIXELS_BGR);
+			ofPixels gray;
+			bgr.convertTo(gray, OF_PIXELS_GRAY);
+			ofxTestEq(int(gray[0]), luma(ofColor::red, OF_COLOR_MATRIX_BT601), "BGR luma reads the channels in BGR order");
+
+			ofPixels typed = solid(ofColor::red);
+			typed.setImageType(OF_IMAGE_GRAYSCALE);
+			ofxTestEq(int(typed[0]), luma(ofColor::red, OF_COLOR_MATRIX_BT601), "setImageType to grayscale uses the luma");
+
+			ofFloatPixels floats;
+			floats.allocate(2, 2, OF_PIXELS_RGBA);
+			floats.setColor(ofFloatColor(1, 0.5, 0.25, 1));
+			ofFloatPixels floatGray;
+			floats.convertTo(floatGray, OF_PIXELS_GRAY);
+			ofxTestLt(std::abs(floatGray[0] - (0.299f + 0.587f * 0.5f + 0.114f * 0.25f)), 0.001f, "float pixels use the same luma");
+		}
+
+		ofLogNotice() << "testing video range YUV values";
+		{
+			ofxTestEq(videoY(ofColor::white, OF_COLOR_MATRIX_BT601), 235, "white is Y 235");
+			ofxTestEq(videoY(ofColor::black, OF_COLOR_MATRIX_BT601), 16, "black is Y 16");
+			ofxTestLt(std::abs(videoY(ofColor::red, OF_COLOR_MATRIX_BT601) - 82), 2, "BT.601 red Y");
+			ofxTestLt(std::abs(videoY(ofColor::red, OF_COLOR_MATRIX_BT709) - 63), 2, "BT.709 red Y");
+
+			ofPixels nv12;
+			solid(ofColor(128)).convertTo(nv12, OF_PIXELS_NV12);
+			ofxTest(nv12[16] == 128 && nv12[17] == 128, "gray has neutral chroma");
+		}
+
+		ofLogNotice() << "testing YUV round trips";
+		{
+			// constant over 2x2 blocks, so 4:2:0 and 4:2:2 chroma lose nothing
+			ofPixels rgb;
+			rgb.allocate(64, 48, OF_PIXELS_RGB);
+			for(size_t y = 0; y < 48; y++){
+				for(size_t x = 0; x < 64; x++){
+					rgb.setColor(x, y, ofColor((x / 2) * 8, (y / 2) * 10, ((x / 2 + y / 2) * 37) % 256));
+				}
+			}
+			for(auto format: {OF_PIXELS_NV12, OF_PIXELS_NV21, OF_PIXELS_I420, OF_PIXELS_YV12, OF_PIXELS_YUY2, OF_PIXELS_UYVY}){
+				for(auto matrix: {OF_COLOR_MATRIX_BT601, OF_COLOR_MATRIX_BT709}){
+					ofPixels yuv, back;
+					bool converted = rgb.convertTo(yuv, format, matrix) && yuv.convertTo(back, OF_PIXELS_RGB, matrix);
+					auto name = ofToString(format) + " BT." + (matrix == OF_COLOR_MATRIX_BT601 ? "601" : "709");
+					ofxTest(converted, name + " converts");
+					ofxTestEq(yuv.getTotalBytes(), ofPixels::bytesFromPixelFormat(64, 48, format), name + " has the format's size");
+					ofxTestLt(maxDifference(rgb, back), 6, name + " round trips within the video range quantization");
+				}
+			}
+
+			ofPixels gray, nv12, grayBack;
+			rgb.convertTo(gray, OF_PIXELS_GRAY);
+			gray.convertTo(nv12, OF_PIXELS_NV12);
+			nv12.convertTo(grayBack, OF_PIXELS_GRAY);
+			ofxTestLt(maxDifference(gray, grayBack), 2, "gray round trips through NV12");
+
+			ofPixels rgb565, rgbBack;
+			rgb.convertTo(rgb565, OF_PIXELS_RGB565);
+			rgb565.convertTo(rgbBack, OF_PIXELS_RGB);
+			ofxTestLt(maxDifference(rgb, rgbBack), 8, "RGB565 round trips within its precision");
+
+			ofPixels bgra, rgbFromBgra;
+			rgb.convertTo(bgra, OF_PIXELS_BGRA);
+			bgra.convertTo(rgbFromBgra, OF_PIXELS_RGB);
+			ofxTest(equal(rgb, rgbFromBgra), "RGB round trips through BGRA exactly");
+			ofxTestEq(int(bgra.getColor(2, 2).a), 255, "an added alpha channel is opaque");
+
+			ofPixels single, threaded;
+			rgb.convertTo(single, OF_PIXELS_I420, OF_COLOR_MATRIX_BT709, 1);
+			rgb.convertTo(threaded, OF_PIXELS_I420, OF_COLOR_MATRIX_BT709, 4);
+			ofxTest(equal(single, threaded), "converting on 4 threads gives the same result");
+
+			ofPixels inPlace = rgb;
+			inPlace.convertTo(inPlace, OF_PIXELS_NV12);
+			ofxTestEq(inPlace.getPixelFormat(), OF_PIXELS_NV12, "converting into the same pixels works");
+		}
+
+		ofLogNotice() << "testing unsupported conversions";
+		{
+			ofPixels odd, yuv;
+			odd.allocate(3, 3, OF_PIXELS_RGB);
+			ofxTest(!odd.convertTo(yuv, OF_PIXELS_NV12), "YUV needs an even size");
+			ofxTest(odd.convertTo(yuv, OF_PIXELS_GRAY), "odd sizes still convert to gray");
+
+			ofFloatPixels floats, floatYuv;
+			floats.allocate(4, 4, OF_PIXELS_RGB);
+			ofxTest(!floats.convertTo(floatYuv, OF_PIXELS_NV12), "YUV is only available for 8 bit pixels");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
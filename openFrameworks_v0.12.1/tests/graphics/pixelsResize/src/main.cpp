@@ -0,0 +1,161 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	static bool equal(const ofPixels & a, const ofPixels & b){
+		return a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight()
+			&& std::equal(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+	template<typename PixelType>
+	static bool isConstant(const ofPixels_<PixelType> & pixels, float value, float tolerance){
+		for(auto & v: pixels){
+			if(std::abs(float(v) - value) > tolerance){
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// resizes a single color image with every method and size combination,
+	// the result has to keep its size and color
+	template<typename PixelType>
+	void testSizes(const std::string & type, PixelType value, float tolerance){
+		const std::vector<glm::ivec2> sizes = {{1,1}, {1,7}, {7,1}, {2,3}, {16,9}, {33,17}, {64,48}};
+		const std::vector<ofPixelFormat> formats = {OF_PIXELS_GRAY, OF_PIXELS_GRAY_ALPHA, OF_PIXELS_RGB, OF_PIXELS_RGBA};
+		const std::vector<ofInterpolationMethod> methods = {OF_INTERPOLATE_NEAREST_NEIGHBOR, OF_INTERPOLATE_BILINEAR, OF_INTERPOLATE_BICUBIC, OF_INTERPOLATE_AREA};
+		bool sizesOk = true;
+		bool colorOk = true;
+		for(auto format: formats){
+			for(auto method: methods){
+				for(auto src: sizes){
+					for(auto dst: sizes){
+						ofPixels_<PixelType> pixels;
+						pixels.allocate(src.x, src.y, format);
+						pixels.set(value);
+						if(!pixels.resize(dst.x, dst.y, method)
+						   || int(pixels.getWidth()) != dst.x || int(pixels.getHeight()) != dst.y
+						   || pixels.getPixelFormat() != format){
+							sizesOk = false;
+							ofLogError() << type << " " << src << " to " << dst << " with method " << method << " format " << format;
+						}else if(!isConstant(pixels, float(value), tolerance)){
+							colorOk = false;
+							ofLogError() << type << " " << src << " to " << dst << " with method " << method << " format " << format << " changed the color";
+						}
+					}
+				}
+			}
+		}
+		ofxTest(sizesOk, type + " resize gives the requested size for every method and channel count");
+		ofxTest(colorOk, type + " resize keeps a single color image that color");
+	}
+
+	void run(){
+		ofLogNotice() << "testing resize sizes";
+		testSizes<unsigned char>("ofPixels", 200, 1);
+		testSizes<unsigned short>("ofShortPixels", 50000, 1);
+		testSizes<float>("ofFloatPixels", 0.75f, 0.0001f);
+
+		ofLogNotice() << "testing degenerate inputs";
+		{
+			ofPixels pixels;
+			ofxTest(!pixels.resize(8, 8, OF_INTERPOLATE_BILINEAR), "resizing unallocated pixels fails");
+
+			pixels.allocate(16, 8, OF_PIXELS_RGB);
+			pixels.set(10);
+			ofxTest(!pixels.resize(0, 8, OF_INTERPOLATE_BILINEAR), "resizing to zero width fails");
+			ofxTest(!pixels.resize(8, 0, OF_INTERPOLATE_AREA), "resizing to zero height fails");
+			ofxTest(pixels.getWidth() == 16 && pixels.getHeight() == 8, "a failed resize leaves the pixels untouched");
+
+			ofPixels unallocated;
+			ofxTest(!pixels.resizeTo(unallocated, OF_INTERPOLATE_BICUBIC), "resizing into unallocated pixels fails");
+
+			ofPixels gray;
+			gray.allocate(4, 4, OF_PIXELS_GRAY);
+			ofxTest(!pixels.resizeTo(gray, OF_INTERPOLATE_BILINEAR), "resizing into a different number of channels fails");
+
+			ofPixels nv12;
+			nv12.allocate(16, 8, OF_PIXELS_NV12);
+			ofxTest(!nv12.resize(8, 4, OF_INTERPOLATE_BILINEAR), "planar formats can't be resized");
+			ofxTestEq(nv12.getWidth(), 16u, "a planar image keeps its size");
+
+			ofxTest(pixels.resizeTo(pixels, OF_INTERPOLATE_BILINEAR), "resizing into itself is a no op");
+		}
+
+		ofLogNotice() << "testing resize values";
+		{
+			ofPixels gradient;
+			gradient.allocate(64, 4, OF_PIXELS_GRAY);
+			for(size_t y = 0; y < 4; y++){
+				for(size_t x = 0; x < 64; x++){
+					gradient.setColor(x, y, ofColor(x * 4));
+				}
+			}
+
+			ofPixels same = gradient;
+			same.resize(64, 4, OF_INTERPOLATE_BILINEAR);
+			ofxTest(equal(same, gradient), "resizing to the same size with bilinear changes nothing");
+
+			for(auto method: {OF_INTERPOLATE_BILINEAR, OF_INTERPOLATE_BICUBIC, OF_INTERPOLATE_AREA}){
+				for(size_t width: {13, 32, 150}){
+					ofPixels resized = gradient;
+					resized.resize(width, 4, method);
+					bool monotonic = true;
+					for(size_t x = 1; x < width; x++){
+						monotonic &= resized.getColor(x, 2).r >= resized.getColor(x - 1, 2).r;
+					}
+					ofxTest(monotonic, "a gradient stays a gradient resized to " + ofToString(width) + " with method " + ofToString(method));
+				}
+			}
+
+			ofPixels halved = gradient;
+			halved.resize(32, 2, OF_INTERPOLATE_AREA);
+			bool average = true;
+			for(size_t x = 0; x < 32; x++){
+				// 2x2 blocks of x*8 and x*8+4
+				average &= std::abs(int(halved.getColor(x, 0).r) - int(x * 8 + 2)) <= 1;
+			}
+			ofxTest(average, "area halving averages 2x2 blocks");
+
+			ofPixels checker;
+			checker.allocate(64, 64, OF_PIXELS_GRAY);
+			for(size_t y = 0; y < 64; y++){
+				for(size_t x = 0; x < 64; x++){
+					checker.setColor(x, y, ofColor((x + y) % 2 ? 255 : 0));
+				}
+			}
+			for(auto method: {OF_INTERPOLATE_BILINEAR, OF_INTERPOLATE_BICUBIC, OF_INTERPOLATE_AREA}){
+				ofPixels shrunk = checker;
+				shrunk.resize(13, 13, method);
+				ofxTest(isConstant(shrunk, 127.5f, 12), "shrinking a checkerboard doesn't alias with method " + ofToString(method));
+			}
+		}
+
+		ofLogNotice() << "testing threaded resize";
+		{
+			ofPixels noise;
+			noise.allocate(320, 240, OF_PIXELS_RGBA);
+			for(size_t i = 0; i < noise.size(); i++){
+				noise[i] = (i * 2654435761u) >> 24;
+			}
+			for(auto method: {OF_INTERPOLATE_BILINEAR, OF_INTERPOLATE_BICUBIC, OF_INTERPOLATE_AREA}){
+				ofPixels single, threaded;
+				single.allocate(101, 77, OF_PIXELS_RGBA);
+				threaded.allocate(101, 77, OF_PIXELS_RGBA);
+				noise.resizeTo(single, method, 1);
+				noise.resizeTo(threaded, method, 4);
+				ofxTest(equal(single, threaded), "resizing on 4 threads gives the same result with method " + ofToString(method));
+			}
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
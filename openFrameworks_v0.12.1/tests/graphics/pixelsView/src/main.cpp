@@ -0,0 +1,216 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+class ofApp: public ofxUnitTestsApp{
+	static bool equal(const ofPixels & a, const ofPixels & b){
+		return a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight()
+			&& a.getPixelFormat() == b.getPixelFormat()
+			&& std::equal(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+	static ofPixels copy(const ofPixelsView & view){
+		ofPixels pixels;
+		pixels.setFromPixels(view);
+		return pixels;
+	}
+
+	void run(){
+		ofPixels rgb;
+		rgb.allocate(64, 48, OF_PIXELS_RGB);
+		for(size_t i = 0; i < rgb.size(); i++){
+			rgb[i] = (i * 13) % 251;
+		}
+
+		ofLogNotice() << "testing crop";
+		{
+			ofPixelsView view(rgb);
+			ofxTest(view.isValid() && view.isContiguous(), "a view of ofPixels is valid and contiguous");
+			ofxTest(!ofPixelsView().isValid(), "an empty view is invalid");
+
+			auto cropped = view.crop(10, 6, 20, 16);
+			ofxTestEq(cropped.getWidth(), 20u, "a crop has the requested width");
+			ofxTestEq(cropped.getHeight(), 16u, "a crop has the requested height");
+			ofxTest(cropped.getRow(0) == rgb.getData() + (6 * 64 + 10) * 3, "a crop starts at its corner of the original data");
+			ofxTestEq(cropped.getStride(), 64u * 3, "a crop keeps the stride of the original");
+			ofxTest(!cropped.isContiguous(), "a narrower crop isn't contiguous");
+			ofxTest(view.crop(0, 6, 64, 16).isContiguous(), "a full width crop is contiguous");
+
+			ofPixels cropTo;
+			rgb.cropTo(cropTo, 10, 6, 20, 16);
+			ofxTest(equal(copy(cropped), cropTo), "copying a crop gives the same as cropTo");
+
+			auto nested = view.crop(4, 2, 40, 30).crop(6, 4, 20, 16);
+			ofxTest(nested.getRow(0) == cropped.getRow(0) && nested.getRow(15) == cropped.getRow(15), "cropping a crop adds up the offsets");
+
+			ofxTest(!view.crop(50, 0, 20, 10).isValid(), "a crop past the right edge is invalid");
+			ofxTest(!view.crop(0, 40, 10, 10).isValid(), "a crop past the bottom is invalid");
+			ofxTest(!view.crop(0, 0, 0, 10).isValid(), "an empty crop is invalid");
+
+			ofPixels resizedCrop, resizedCopy;
+			resizedCrop.allocate(7, 5, OF_PIXELS_RGB);
+			resizedCopy.allocate(7, 5, OF_PIXELS_RGB);
+			cropped.resizeTo(resizedCrop, OF_INTERPOLATE_BILINEAR);
+			cropTo.resizeTo(resizedCopy, OF_INTERPOLATE_BILINEAR);
+			ofxTest(equal(resizedCrop, resizedCopy), "resizing a crop reads only the cropped pixels");
+
+			ofPixels pasted;
+			pasted.allocate(32, 32, OF_PIXELS_RGB);
+			pasted.set(0);
+			view.crop(0, 0, 10, 10).pasteInto(pasted, 5, 5);
+			ofxTest(pasted.getColor(5, 5) == rgb.getColor(0, 0) && pasted.getColor(14, 14) == rgb.getColor(9, 9), "pasting a crop copies the cropped pixels");
+		}
+
+		ofLogNotice() << "testing strided data";
+		{
+			// rows padded to 256 bytes, like a cv::Mat region or a video frame
+			std::vector<unsigned char> padded(256 * 48, 0xFF);
+			for(size_t y = 0; y < 48; y++){
+				memcpy(&padded[y * 256], rgb.getData() + y * 64 * 3, 64 * 3);
+			}
+			ofPixelsView view(padded.data(), 64, 48, OF_PIXELS_RGB, 256);
+			ofxTestEq(view.getStride(), 256u, "the stride is the one given");
+			ofxTest(!view.isContiguous(), "padded rows aren't contiguous");
+			ofxTest(equal(copy(view), rgb), "copying padded rows skips the padding");
+			ofxTest(!view.overlaps(rgb), "a view of other data doesn't overlap");
+			ofxTest(ofPixelsView(rgb).crop(0, 10, 64, 4).overlaps(rgb), "a view of the data overlaps it");
+
+			ofPixels inside;
+			inside.setFromExternalPixels(padded.data() + 256 * 8, 16, 4, OF_PIXELS_RGB);
+			ofxTest(view.overlaps(inside), "a view starting before some pixels and running into them overlaps them");
+		}
+
+		ofLogNotice() << "testing YUV planes";
+		{
+			for(auto format: {OF_PIXELS_NV12, OF_PIXELS_NV21, OF_PIXELS_I420, OF_PIXELS_YV12}){
+				ofPixels yuv;
+				rgb.convertTo(yuv, format);
+				ofPixelsView view(yuv);
+				auto name = ofToString(format);
+				bool semiPlanar = format == OF_PIXELS_NV12 || format == OF_PIXELS_NV21;
+				const unsigned char * data = yuv.getData();
+				size_t ySize = 64 * 48;
+				size_t chromaSize = 32 * 24;
+
+				ofxTestEq(view.getNumPlanes(), semiPlanar ? 2u : 3u, name + " has its planes");
+				ofxTest(view.getRow(0, 0) == data, name + " Y starts the data");
+				ofxTest(view.getRow(0, 1) == data + ySize, name + " second plane follows Y");
+				ofxTestEq(view.getStride(1), semiPlanar ? 64u : 32u, name + " second plane stride");
+				if(!semiPlanar){
+					ofxTest(view.getRow(0, 2) == data + ySize + chromaSize, name + " third plane follows the second");
+				}
+
+				auto y = view.getPlane(0);
+				auto chroma = view.getPlane(1);
+				ofxTest(y.getPixelFormat() == OF_PIXELS_Y && y.getWidth() == 64 && y.getHeight() == 48, name + " Y plane is full size");
+				ofxTest(chroma.getWidth() == 32 && chroma.getHeight() == 24, name + " chroma planes are quarter size");
+				ofxTest(equal(copy(y), yuv.getPlane(0)), name + " Y plane view matches ofPixels::getPlane");
+
+				auto cropped = view.crop(8, 4, 32, 20);
+				ofxTest(cropped.getRow(0, 0) == data + 4 * 64 + 8, name + " cropped Y offset");
+				ofxTest(cropped.getRow(0, 1) == data + ySize + 2 * view.getStride(1) + (semiPlanar ? 8 : 4), name + " cropped chroma offset");
+
+				ofPixels full, convertedCrop, expected;
+				yuv.convertTo(full, OF_PIXELS_RGB);
+				full.cropTo(expected, 8, 4, 32, 20);
+				cropped.convertTo(convertedCrop, OF_PIXELS_RGB);
+				ofxTest(equal(convertedCrop, expected), name + " converting a crop matches cropping the conversion");
+
+				ofPixels croppedCopy, convertedCopy;
+				croppedCopy.setFromPixels(cropped);
+				croppedCopy.convertTo(convertedCopy, OF_PIXELS_RGB);
+				ofxTest(equal(convertedCopy, expected), name + " copying a crop keeps every plane");
+
+				ofxTest(!view.crop(1, 4, 32, 20).isValid(), name + " can't be cropped on odd columns");
+				ofxTest(!view.crop(8, 3, 32, 20).isValid(), name + " can't be cropped on odd rows");
+			}
+
+			ofPixels yuy2;
+			rgb.convertTo(yuy2, OF_PIXELS_YUY2);
+			ofxTest(ofPixelsView(yuy2).crop(8, 3, 32, 21).isValid(), "4:2:2 can be cropped on odd rows");
+			ofxTest(!ofPixelsView(yuy2).crop(7, 3, 32, 21).isValid(), "4:2:2 can't be cropped on odd columns");
+		}
+
+		ofLogNotice() << "testing planes in separate buffers";
+		{
+			ofPixels i420;
+			rgb.convertTo(i420, OF_PIXELS_I420);
+			// each plane in its own buffer with its own padding, like a mapped video frame
+			std::vector<unsigned char> y(80 * 48), u(40 * 24), v(48 * 24);
+			for(size_t row = 0; row < 48; row++){
+				memcpy(&y[row * 80], i420.getData() + row * 64, 64);
+			}
+			for(size_t row = 0; row < 24; row++){
+				memcpy(&u[row * 40], i420.getData() + 64 * 48 + row * 32, 32);
+				memcpy(&v[row * 48], i420.getData() + 64 * 48 + 32 * 24 + row * 32, 32);
+			}
+			ofPixelsView view(64, 48, OF_PIXELS_I420, {{y.data(), 80}, {u.data(), 40}, {v.data(), 48}});
+			ofxTest(view.getRow(3, 2) == v.data() + 3 * 48, "each plane keeps its own start and stride");
+			ofxTest(equal(copy(view), i420), "copying separate planes gives packed ofPixels");
+
+			ofPixels fromPlanes, fromPacked;
+			view.convertTo(fromPlanes, OF_PIXELS_RGB);
+			i420.convertTo(fromPacked, OF_PIXELS_RGB);
+			ofxTest(equal(fromPlanes, fromPacked), "converting separate planes matches packed ones");
+		}
+
+		ofLogNotice() << "testing views into their own pixels";
+		{
+			ofPixels pixels = rgb;
+			pixels.setFromPixels(ofPixelsView(pixels).crop(4, 4, 8, 8));
+			ofxTest(pixels.getWidth() == 8 && pixels.getColor(0, 0) == rgb.getColor(4, 4), "setting pixels from a crop of themselves");
+
+			ofPixels resized = rgb;
+			ofPixelsView(resized).crop(0, 0, 32, 24).resizeTo(resized, OF_INTERPOLATE_BILINEAR);
+			ofPixels expected;
+			rgb.cropTo(expected, 0, 0, 32, 24);
+			expected.resize(64, 48, OF_INTERPOLATE_BILINEAR);
+			ofxTest(equal(resized, expected), "resizing a crop of the destination into it");
+
+			// row y holds y, pasting the top 4 rows 2 rows down has to read
+			// rows 2 and 3 before they're overwritten
+			ofPixels rows;
+			rows.allocate(4, 8, OF_PIXELS_GRAY);
+			for(size_t y = 0; y < 8; y++){
+				for(size_t x = 0; x < 4; x++){
+					rows.setColor(x, y, ofColor(y));
+				}
+			}
+			ofPixels pasted = rows;
+			ofPixelsView(pasted).crop(0, 0, 4, 4).pasteInto(pasted, 0, 2);
+			std::vector<int> column;
+			for(size_t y = 0; y < 8; y++){
+				column.push_back(pasted.getColor(3, y).r);
+			}
+			ofxTest(column == std::vector<int>({0, 1, 0, 1, 2, 3, 6, 7}), "pasting a crop of the destination into it");
+
+			ofPixels blended = rows;
+			ofPixelsView(blended).crop(0, 0, 4, 4).blendInto(blended, 0, 2);
+			ofPixels top, expectedBlend = rows;
+			rows.cropTo(top, 0, 0, 4, 4);
+			top.blendInto(expectedBlend, 0, 2);
+			ofxTest(equal(blended, expectedBlend), "blending a crop of the destination into it");
+		}
+
+		ofLogNotice() << "testing overlaps with empty planes";
+		{
+			// a 1 pixel high I420 frame has no chroma rows
+			std::vector<unsigned char> y(4), u(2), v(2);
+			ofPixelsView view(4, 1, OF_PIXELS_I420, {{y.data(), 4}, {u.data(), 2}, {v.data(), 2}});
+			ofPixels other, onY;
+			other.allocate(4, 4, OF_PIXELS_GRAY);
+			onY.setFromExternalPixels(y.data(), 4, 1, OF_PIXELS_GRAY);
+			ofxTest(!view.overlaps(other), "a frame without chroma rows doesn't overlap other pixels");
+			ofxTest(view.isValid() && view.overlaps(onY), "a frame without chroma rows still overlaps its Y plane");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,148 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+// counts the messages it gets, slowly enough for the queue to fill up
+class CountingChannel: public ofBaseLoggerChannel{
+public:
+	void log(ofLogLevel level, const std::string & module, const std::string & message){
+		if(count % 64 == 0){
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		}
+		count++;
+	}
+	std::atomic<size_t> count{0};
+};
+
+// remembers the last message it got and counts its flushes, slow enough
+// for the queue to never run empty while something logs
+class FlushCountingChannel: public ofBaseLoggerChannel{
+public:
+	void log(ofLogLevel level, const std::string & module, const std::string & message){
+		std::this_thread::sleep_for(std::chrono::microseconds(10));
+		std::unique_lock<std::mutex> lock(mutex);
+		last = message;
+	}
+	void flush(){
+		flushes++;
+	}
+	std::string getLast(){
+		std::unique_lock<std::mutex> lock(mutex);
+		return last;
+	}
+	std::mutex mutex;
+	std::string last;
+	std::atomic<size_t> flushes{0};
+};
+
+class ofApp: public ofxUnitTestsApp{
+	void run(){
+		ofLogNotice() << "testing ofAsyncLoggerChannel blocking on overflow";
+		{
+			auto counting = std::make_shared<CountingChannel>();
+			ofAsyncLoggerChannel async(counting, 4, OF_LOG_OVERFLOW_BLOCK);
+			const size_t threads = 4;
+			const size_t perThread = 2000;
+			std::vector<std::thread> loggers;
+			for(size_t t = 0; t < threads; t++){
+				loggers.emplace_back([&]{
+					for(size_t i = 0; i < perThread; i++){
+						async.log(OF_LOG_NOTICE, "test", "message");
+					}
+				});
+			}
+			for(auto & logger: loggers){
+				logger.join();
+			}
+			async.flush();
+			ofxTestEq(counting->count.load(), threads * perThread, "every message is written when logging blocks on a full queue");
+			ofxTestEq(async.getDropped(), 0u, "no message is dropped when logging blocks");
+		}
+
+		ofLogNotice() << "testing ofAsyncLoggerChannel flush under steady logging";
+		{
+			auto counting = std::make_shared<FlushCountingChannel>();
+			ofAsyncLoggerChannel async(counting, 64, OF_LOG_OVERFLOW_BLOCK);
+			std::atomic<bool> done{false};
+			std::vector<std::thread> loggers;
+			for(size_t t = 0; t < 2; t++){
+				loggers.emplace_back([&]{
+					while(!done){
+						async.log(OF_LOG_NOTICE, "test", "message");
+					}
+				});
+			}
+			bool returned = true;
+			size_t flushCalls = 0;
+			for(int i = 0; i < 20 && returned; i++){
+				auto marker = "marker " + ofToString(i);
+				auto flushing = std::async(std::launch::async, [&]{
+					// a thread of its own, so the marker is the last message it logs
+					async.log(OF_LOG_NOTICE, "test", marker);
+					async.flush();
+					return true;
+				});
+				returned = flushing.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+				if(!returned){
+					// let it finish
+					done = true;
+				}
+				flushCalls++;
+			}
+			ofxTest(returned, "flush returns while other threads keep logging");
+			ofxTestGt(counting->flushes.load(), 0u, "the channel is flushed");
+			ofxTest(counting->flushes <= flushCalls, "the channel is flushed at most once per flush");
+			done = true;
+			for(auto & logger: loggers){
+				logger.join();
+			}
+
+			async.log(OF_LOG_NOTICE, "test", "last");
+			async.flush();
+			ofxTestEq(counting->getLast(), std::string("last"), "flush waits for the messages logged before it");
+			size_t flushes = counting->flushes;
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			ofxTestEq(counting->flushes.load(), flushes, "the writer doesn't keep flushing once a flush is done");
+		}
+
+		ofLogNotice() << "testing ofFileLoggerChannel rotation";
+		{
+			ofDirectory::createDirectory(ofToDataPath(""), false, true);
+			of::filesystem::path name = "rotation_test.log";
+			auto rotated = [](size_t index){
+				return ofToDataPath("rotation_test." + ofToString(index) + ".log");
+			};
+			auto removeLogs = [&]{
+				for(size_t i = 0; i <= 3; i++){
+					auto path = i == 0 ? ofToDataPath(name) : rotated(i);
+					if(ofFile::doesFileExist(path, false)){
+						ofFile::removeFile(path, false);
+					}
+				}
+			};
+			removeLogs();
+			{
+				ofFileLoggerChannel file(name, false);
+				file.setRotation(256, 2);
+				for(int i = 0; i < 100; i++){
+					file.log(OF_LOG_NOTICE, "test", "line " + ofToString(i));
+				}
+			}
+			ofxTest(ofFile::doesFileExist(name), "the current log is in the data folder");
+			ofxTest(ofFile::doesFileExist(rotated(1), false), "the first rotated log is next to it");
+			ofxTest(ofFile::doesFileExist(rotated(2), false), "the second rotated log is next to it");
+			ofxTest(!ofFile::doesFileExist(rotated(3), false), "logs older than maxFiles are deleted");
+			ofxTestLt(ofFile(name).getSize(), 512u, "the current log was started again");
+			removeLogs();
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
@@ -0,0 +1,210 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+#include "ofSpscChannel.h"
+
+using namespace std::chrono;
+
+class ofApp: public ofxUnitTestsApp{
+	// sends 0..count-1 from another thread and receives them here
+	template<typename Channel>
+	double throughput(Channel & channel, int count){
+		auto start = steady_clock::now();
+		std::thread sender([&]{
+			for(int i = 0; i < count; i++){
+				channel.send(i);
+			}
+		});
+		int value = 0;
+		for(int i = 0; i < count; i++){
+			channel.receive(value);
+		}
+		auto elapsed = duration<double>(steady_clock::now() - start).count();
+		sender.join();
+		return count / elapsed;
+	}
+
+	// round trips of one value between two threads, in microseconds
+	template<typename Channel>
+	double latency(Channel & ping, Channel & pong, int count){
+		std::thread echo([&]{
+			int value = 0;
+			while(ping.receive(value)){
+				pong.send(value);
+			}
+		});
+		auto start = steady_clock::now();
+		int value = 0;
+		for(int i = 0; i < count; i++){
+			ping.send(i);
+			pong.receive(value);
+		}
+		auto elapsed = duration<double, std::micro>(steady_clock::now() - start).count();
+		ping.close();
+		echo.join();
+		return elapsed / count;
+	}
+
+	void run(){
+		ofLogNotice() << "testing capacity";
+		{
+			ofSpscChannel<int> channel(5);
+			ofxTestEq(channel.capacity(), 8u, "capacity is rounded up to a power of two");
+			ofxTest(channel.empty(), "a new channel is empty");
+		}
+
+		ofLogNotice() << "testing fifo order across two threads";
+		{
+			const int count = 100000;
+			ofSpscChannel<int> channel(16);
+			std::thread sender([&]{
+				for(int i = 0; i < count; i++){
+					channel.send(i);
+				}
+			});
+			bool inOrder = true;
+			int value = -1;
+			for(int i = 0; i < count; i++){
+				if(!channel.receive(value) || value != i){
+					inOrder = false;
+					break;
+				}
+			}
+			sender.join();
+			ofxTest(inOrder, "values arrive in the order they were sent");
+			ofxTest(channel.empty(), "every value was received");
+		}
+
+		ofLogNotice() << "testing full / empty wraparound";
+		{
+			ofSpscChannel<int> channel(4);
+			int next = 0;
+			int expected = 0;
+			bool ok = true;
+			// every cycle fills the buffer and drains half of it, so the
+			// indices go around the ring many times
+			for(int cycle = 0; cycle < 100 && ok; cycle++){
+				while(channel.trySend(next)){
+					next++;
+				}
+				ok &= channel.full() && channel.size() == 4;
+				int value = 0;
+				for(int i = 0; i < 2 && ok; i++){
+					ok &= channel.tryReceive(value) && value == expected++;
+				}
+			}
+			ofxTest(ok, "the channel fills to capacity and keeps the order while wrapping around");
+			int value = 0;
+			while(channel.tryReceive(value)){
+				ok &= value == expected++;
+			}
+			ofxTest(ok, "draining after wrapping around keeps the order");
+			ofxTestEq(expected, next, "every value sent was received");
+			ofxTest(channel.empty(), "the drained channel is empty");
+			ofxTest(!channel.tryReceive(value), "tryReceive on an empty channel fails");
+		}
+
+		ofLogNotice() << "testing trySend on a full channel";
+		{
+			ofSpscChannel<std::string> channel(2);
+			ofxTest(channel.trySend(std::string("a")), "trySend with room succeeds");
+			ofxTest(channel.trySend(std::string("b")), "trySend with room succeeds");
+			std::string value = "c";
+			ofxTest(!channel.trySend(std::move(value)), "trySend on a full channel fails");
+			ofxTestEq(value, "c", "a failed trySend doesn't move from the value");
+			ofxTestEq(channel.size(), 2u, "a failed trySend doesn't change the channel");
+			std::string received;
+			channel.tryReceive(received);
+			ofxTestEq(received, "a", "the first value is still first");
+			ofxTest(channel.trySend(std::move(value)), "trySend succeeds once there is room again");
+		}
+
+		ofLogNotice() << "testing close wakes up a blocked receive";
+		{
+			ofSpscChannel<int> channel(4);
+			std::atomic<bool> returned{false};
+			bool received = true;
+			std::thread receiver([&]{
+				int value = 0;
+				received = channel.receive(value);
+				returned = true;
+			});
+			std::this_thread::sleep_for(milliseconds(50));
+			ofxTest(!returned, "receive blocks on an empty channel");
+			channel.close();
+			receiver.join();
+			ofxTest(!received, "receive returns false once the channel is closed");
+		}
+
+		ofLogNotice() << "testing close wakes up a blocked send";
+		{
+			ofSpscChannel<int> channel(2);
+			channel.send(0);
+			channel.send(1);
+			std::atomic<bool> returned{false};
+			bool sent = true;
+			std::thread sender([&]{
+				sent = channel.send(2);
+				returned = true;
+			});
+			std::this_thread::sleep_for(milliseconds(50));
+			ofxTest(!returned, "send blocks on a full channel");
+			channel.close();
+			sender.join();
+			ofxTest(!sent, "send returns false once the channel is closed");
+			ofxTest(!channel.trySend(3), "trySend fails on a closed channel");
+		}
+
+		ofLogNotice() << "testing tryReceive with a timeout";
+		{
+			ofSpscChannel<int> channel(4);
+			int value = 0;
+			auto start = steady_clock::now();
+			bool received = channel.tryReceive(value, 50);
+			auto waited = duration_cast<milliseconds>(steady_clock::now() - start).count();
+			ofxTest(!received, "tryReceive times out on an empty channel");
+			ofxTestGt(waited, 40, "tryReceive waits for about the timeout");
+
+			std::thread sender([&]{
+				std::this_thread::sleep_for(milliseconds(20));
+				channel.send(42);
+			});
+			start = steady_clock::now();
+			received = channel.tryReceive(value, 5000);
+			waited = duration_cast<milliseconds>(steady_clock::now() - start).count();
+			sender.join();
+			ofxTest(received, "tryReceive gets a value sent while waiting");
+			ofxTestEq(value, 42, "tryReceive gets the value sent");
+			ofxTestLt(waited, 2500, "tryReceive returns as soon as a value arrives");
+		}
+
+		ofLogNotice() << "benchmarking against ofThreadChannel";
+		{
+			const int count = 1000000;
+			ofSpscChannel<int> spsc(1024);
+			ofThreadChannel<int> locked(1024);
+			auto spscRate = throughput(spsc, count);
+			auto lockedRate = throughput(locked, count);
+			ofLogNotice() << "throughput, values per second: ofSpscChannel " << size_t(spscRate)
+				<< ", ofThreadChannel " << size_t(lockedRate)
+				<< " (" << ofToString(spscRate / lockedRate, 1) << "x)";
+
+			const int roundTrips = 20000;
+			ofSpscChannel<int> spscPing(16), spscPong(16);
+			ofThreadChannel<int> lockedPing(16), lockedPong(16);
+			auto spscLatency = latency(spscPing, spscPong, roundTrips);
+			auto lockedLatency = latency(lockedPing, lockedPong, roundTrips);
+			ofLogNotice() << "round trip latency: ofSpscChannel " << ofToString(spscLatency, 2)
+				<< "us, ofThreadChannel " << ofToString(lockedLatency, 2) << "us";
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}
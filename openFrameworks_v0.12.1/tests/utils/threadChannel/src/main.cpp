@@ -0,0 +1,148 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofxUnitTests.h"
+
+using namespace std::chrono;
+
+class ofApp: public ofxUnitTestsApp{
+	// everything waiting in the channel, in the order it's received
+	static std::vector<int> receiveAll(ofThreadChannel<int> & channel){
+		std::vector<int> values;
+		int value = 0;
+		while(channel.tryReceive(value)){
+			values.push_back(value);
+		}
+		return values;
+	}
+
+	void run(){
+		ofLogNotice() << "testing an unbounded channel";
+		{
+			ofThreadChannel<int> channel;
+			for(int i = 0; i < 100; i++){
+				channel.send(i);
+			}
+			ofxTestEq(channel.getCapacity(), 0u, "a default channel has no capacity limit");
+			ofxTestEq(channel.size(), 100u, "an unbounded channel keeps every value");
+			ofxTestEq(channel.getHighWaterMark(), 100u, "the high-water mark is the most values waiting");
+			auto values = receiveAll(channel);
+			bool inOrder = values.size() == 100;
+			for(size_t i = 0; i < values.size(); i++){
+				inOrder &= values[i] == int(i);
+			}
+			ofxTest(inOrder, "values arrive in the order they were sent");
+			ofxTestEq(channel.getDropped(), 0u, "nothing is dropped");
+		}
+
+		ofLogNotice() << "testing OF_CHANNEL_OVERFLOW_BLOCK";
+		{
+			ofThreadChannel<int> channel(2, OF_CHANNEL_OVERFLOW_BLOCK);
+			channel.send(1);
+			channel.send(2);
+			std::atomic<bool> sent{false};
+			std::thread sender([&]{
+				channel.send(3);
+				sent = true;
+			});
+			std::this_thread::sleep_for(milliseconds(50));
+			ofxTest(!sent, "sending to a full channel blocks");
+			int value = 0;
+			channel.receive(value);
+			sender.join();
+			ofxTest(sent, "receiving makes room for the blocked sender");
+			ofxTest(value == 1 && receiveAll(channel) == std::vector<int>({2, 3}), "blocking keeps every value in order");
+			ofxTestEq(channel.getDropped(), 0u, "blocking drops nothing");
+			ofxTestEq(channel.getHighWaterMark(), 2u, "the channel never held more than its capacity");
+		}
+
+		ofLogNotice() << "testing close wakes a blocked sender";
+		{
+			ofThreadChannel<int> channel(1, OF_CHANNEL_OVERFLOW_BLOCK);
+			channel.send(1);
+			std::atomic<int> result{-1};
+			std::thread sender([&]{
+				result = channel.send(2) ? 1 : 0;
+			});
+			std::this_thread::sleep_for(milliseconds(50));
+			ofxTestEq(result.load(), -1, "the sender is blocked on the full channel");
+			channel.close();
+			sender.join();
+			ofxTestEq(result.load(), 0, "closing the channel makes the blocked send return false");
+			ofxTest(!channel.send(3), "sending to a closed channel fails");
+
+			ofThreadChannel<int> empty;
+			std::atomic<int> received{-1};
+			std::thread receiver([&]{
+				int value = 0;
+				received = empty.receive(value) ? 1 : 0;
+			});
+			std::this_thread::sleep_for(milliseconds(50));
+			empty.close();
+			receiver.join();
+			ofxTestEq(received.load(), 0, "closing the channel makes a blocked receive return false");
+		}
+
+		ofLogNotice() << "testing OF_CHANNEL_OVERFLOW_FAIL";
+		{
+			ofThreadChannel<int> channel(2, OF_CHANNEL_OVERFLOW_FAIL);
+			ofxTest(channel.send(1) && channel.send(2), "sending to a channel with room works");
+			ofxTest(!channel.send(3), "sending to a full channel fails");
+			ofxTestEq(channel.getDropped(), 1u, "the refused value is counted as dropped");
+			ofxTest(receiveAll(channel) == std::vector<int>({1, 2}), "the queued values are left alone");
+
+			ofThreadChannel<std::string> strings(1, OF_CHANNEL_OVERFLOW_FAIL);
+			strings.send("first");
+			std::string second = "second";
+			ofxTest(!strings.send(std::move(second)), "moving into a full channel fails");
+			ofxTestEq(second, std::string("second"), "a refused value isn't moved from");
+		}
+
+		ofLogNotice() << "testing OF_CHANNEL_OVERFLOW_DROP_OLDEST";
+		{
+			ofThreadChannel<int> channel(3, OF_CHANNEL_OVERFLOW_DROP_OLDEST);
+			bool sent = true;
+			for(int i = 1; i <= 5; i++){
+				sent &= channel.send(i);
+			}
+			ofxTest(sent, "sending never fails");
+			ofxTestEq(channel.getDropped(), 2u, "the oldest values are counted as dropped");
+			ofxTestEq(channel.getHighWaterMark(), 3u, "the channel never held more than its capacity");
+			ofxTest(receiveAll(channel) == std::vector<int>({3, 4, 5}), "the newest values are kept in order");
+		}
+
+		ofLogNotice() << "testing OF_CHANNEL_OVERFLOW_KEEP_LATEST";
+		{
+			ofThreadChannel<int> channel(4, OF_CHANNEL_OVERFLOW_KEEP_LATEST);
+			for(int i = 1; i <= 5; i++){
+				channel.send(i);
+			}
+			ofxTestEq(channel.getDropped(), 4u, "every replaced value is counted as dropped");
+			ofxTestEq(channel.getHighWaterMark(), 1u, "only one value ever waits");
+			ofxTest(receiveAll(channel) == std::vector<int>({5}), "only the newest value is received");
+		}
+
+		ofLogNotice() << "testing resetStats";
+		{
+			ofThreadChannel<int> channel(2, OF_CHANNEL_OVERFLOW_DROP_OLDEST);
+			for(int i = 0; i < 5; i++){
+				channel.send(i);
+			}
+			int value = 0;
+			channel.receive(value);
+			channel.resetStats();
+			ofxTestEq(channel.getDropped(), 0u, "resetStats clears the dropped count");
+			ofxTestEq(channel.getHighWaterMark(), 1u, "resetStats starts the high-water mark at the values waiting");
+			channel.send(5);
+			ofxTestEq(channel.getHighWaterMark(), 2u, "the high-water mark grows again after a reset");
+		}
+	}
+};
+
+//========================================================================
+int main( ){
+	ofInit();
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	ofRunApp(window, app);
+	return ofRunMainLoop();
+}